@@ -0,0 +1,47 @@
+/**
+ * \file            bench.h
+ * \brief           Benchmark helpers
+ */
+#ifndef BENCH_HDR_H
+#define BENCH_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * \brief           Get monotonic time in units of nanoseconds
+ * \return          Current time
+ */
+static inline uint64_t
+bench_time_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief           Prevent compiler from optimizing away benchmark results
+ * \param[in]       ptr: Pointer to the result
+ */
+static inline void
+bench_consume(const void* ptr) {
+    static volatile const void* sink;
+    sink = ptr;
+    (void)sink;
+}
+
+/* Minimum time each measurement shall run for */
+#define BENCH_MIN_TIME_NS 200000000ULL
+
+char* bench_load_json(const char* name, size_t* len);
+
+int bench_child_linking_run(void);
+int bench_count_tokens_run(void);
+int bench_find_run(void);
+int bench_numbers_run(void);
+int bench_parallel_run(void);
+int bench_pipeline_run(void);
+int bench_shaped_run(void);
+
+#endif /* BENCH_HDR_H */
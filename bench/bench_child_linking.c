@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/**
+ * \brief           Generate JSON with single array or object, with many primitive children
+ * \param[in]       count: Number of children
+ * \param[in]       is_object: Set to `1` to generate object with keys, `0` for array
+ * \param[out]      len: Length of generated string
+ * \return          Allocated string, `NULL` on failure
+ */
+static char*
+prv_generate(size_t count, uint8_t is_object, size_t* len) {
+    char *str, *p;
+
+    /* Worst case, every element is `"k1234567":1234567,` */
+    str = malloc(count * 24 + 16);
+    if (str == NULL) {
+        return NULL;
+    }
+    p = str;
+    *p++ = is_object ? '{' : '[';
+    for (size_t i = 0; i < count; ++i) {
+        if (is_object) {
+            p += sprintf(p, "\"k%u\":", (unsigned)i);
+        }
+        p += sprintf(p, "%u%s", (unsigned)i, i + 1 < count ? "," : "");
+    }
+    *p++ = is_object ? '}' : ']';
+    *p = '\0';
+    *len = (size_t)(p - str);
+    return str;
+}
+
+/**
+ * \brief           Measure parse time per child element for different number of children
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_child_linking_run(void) {
+    lwjson_t lwobj;
+
+    printf("%10s %10s %12s %16s\r\n", "type", "children", "iterations", "ns/child");
+    for (uint8_t is_object = 0; is_object < 2; ++is_object) {
+        for (size_t count = 10; count <= 1000000; count *= 10) {
+            lwjson_token_t* tokens;
+            uint64_t start, elapsed;
+            size_t len, iterations = 0;
+            char* json;
+
+            json = prv_generate(count, is_object, &len);
+            tokens = malloc(sizeof(*tokens) * count);
+            if (json == NULL || tokens == NULL) {
+                printf("Memory allocation failed\r\n");
+                free(json);
+                free(tokens);
+                return -1;
+            }
+            lwjson_init(&lwobj, tokens, count);
+
+            /* Repeat parsing until measurement is long enough */
+            start = bench_time_ns();
+            do {
+                if (lwjson_parse_ex(&lwobj, json, len) != lwjsonOK) {
+                    printf("Parse failed\r\n");
+                    free(json);
+                    free(tokens);
+                    return -1;
+                }
+                bench_consume(&lwobj);
+                ++iterations;
+                elapsed = bench_time_ns() - start;
+            } while (elapsed < BENCH_MIN_TIME_NS);
+
+            printf("%10s %10u %12u %16.2f\r\n", is_object ? "object" : "array", (unsigned)count, (unsigned)iterations,
+                   (double)elapsed / (double)iterations / (double)count);
+            lwjson_free(&lwobj);
+            free(json);
+            free(tokens);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/* JSON files used for the benchmark */
+static const char* files[] = {
+    "custom.json",
+    "weather_current.json",
+    "weather_onecall.json",
+};
+
+/**
+ * \brief           Compare throughput of token count scan with full parse
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_count_tokens_run(void) {
+    lwjson_t lwobj;
+
+    printf("%22s %8s %14s %14s\r\n", "file", "tokens", "count MB/s", "parse MB/s");
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        lwjson_token_t* tokens;
+        uint64_t start, elapsed_count, elapsed_parse;
+        size_t len, count, iterations_count = 0, iterations_parse = 0;
+        char* json;
+
+        json = bench_load_json(files[i], &len);
+        if (json == NULL || lwjson_count_tokens(json, len, &count, NULL) != lwjsonOK) {
+            printf("Cannot count tokens in %s\r\n", files[i]);
+            free(json);
+            return -1;
+        }
+
+        /* Allocate exact number of tokens, as returned by the pre-pass */
+        tokens = malloc(sizeof(*tokens) * (count > 0 ? count : 1));
+        if (tokens == NULL) {
+            free(json);
+            return -1;
+        }
+        lwjson_init(&lwobj, tokens, count);
+
+        start = bench_time_ns();
+        do {
+            lwjson_count_tokens(json, len, &count, NULL);
+            bench_consume(&count);
+            ++iterations_count;
+            elapsed_count = bench_time_ns() - start;
+        } while (elapsed_count < BENCH_MIN_TIME_NS);
+
+        start = bench_time_ns();
+        do {
+            if (lwjson_parse_ex(&lwobj, json, len) != lwjsonOK) {
+                printf("Parse failed for %s\r\n", files[i]);
+                free(json);
+                free(tokens);
+                return -1;
+            }
+            bench_consume(&lwobj);
+            ++iterations_parse;
+            elapsed_parse = bench_time_ns() - start;
+        } while (elapsed_parse < BENCH_MIN_TIME_NS);
+
+        printf("%22s %8u %14.1f %14.1f\r\n", files[i], (unsigned)count,
+               (double)len * (double)iterations_count * 1000.0 / (double)elapsed_count,
+               (double)len * (double)iterations_parse * 1000.0 / (double)elapsed_parse);
+        lwjson_free(&lwobj);
+        free(json);
+        free(tokens);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/* Paths, searched in every iteration */
+static const char* paths[] = {
+    "lat",
+    "timezone",
+    "timezone_offset",
+    "current.temp",
+    "current.weather.#0.main",
+    "current.wind_speed",
+    "minutely.#30.precipitation",
+    "hourly.#0.temp",
+    "hourly.#12.humidity",
+    "hourly.#47.weather.#0.description",
+    "daily.#0.temp.max",
+    "daily.#7.feels_like.night",
+    "daily.#3.weather.#0.icon",
+    "alerts.#1.event",
+    "alerts.#0.sender_name",
+    "hourly.#.pop",
+};
+
+/**
+ * \brief           Compare path text search with compiled path search and search of all paths at once
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_find_run(void) {
+    lwjson_path_t cpaths[sizeof(paths) / sizeof(paths[0])];
+    const lwjson_token_t* results[sizeof(paths) / sizeof(paths[0])];
+    uint64_t start, elapsed_text, elapsed_compiled, elapsed_many;
+    size_t len, count, iterations_text = 0, iterations_compiled = 0, iterations_many = 0;
+    lwjson_token_t* tokens;
+    lwjson_t lwobj;
+    char* json;
+    int ret = 0;
+
+    json = bench_load_json("weather_onecall.json", &len);
+    if (json == NULL || lwjson_count_tokens(json, len, &count, NULL) != lwjsonOK) {
+        free(json);
+        return -1;
+    }
+    tokens = malloc(sizeof(*tokens) * (count > 0 ? count : 1));
+    if (tokens == NULL) {
+        free(json);
+        return -1;
+    }
+    lwjson_init(&lwobj, tokens, count);
+    if (lwjson_parse_ex(&lwobj, json, len) != lwjsonOK) {
+        ret = -1;
+        goto out;
+    }
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+        if (lwjson_path_compile(&cpaths[i], paths[i]) != lwjsonOK
+            || lwjson_find(&lwobj, paths[i]) != lwjson_find_compiled(&lwobj, NULL, &cpaths[i])) {
+            printf("Path %s does not match\r\n", paths[i]);
+            ret = -1;
+            goto out;
+        }
+    }
+    lwjson_find_many(&lwobj, paths, sizeof(paths) / sizeof(paths[0]), results);
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+        if (results[i] != lwjson_find(&lwobj, paths[i])) {
+            printf("Path %s does not match in lwjson_find_many\r\n", paths[i]);
+            ret = -1;
+            goto out;
+        }
+    }
+
+    start = bench_time_ns();
+    do {
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+            bench_consume(lwjson_find(&lwobj, paths[i]));
+        }
+        ++iterations_text;
+        elapsed_text = bench_time_ns() - start;
+    } while (elapsed_text < BENCH_MIN_TIME_NS);
+
+    start = bench_time_ns();
+    do {
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+            bench_consume(lwjson_find_compiled(&lwobj, NULL, &cpaths[i]));
+        }
+        ++iterations_compiled;
+        elapsed_compiled = bench_time_ns() - start;
+    } while (elapsed_compiled < BENCH_MIN_TIME_NS);
+
+    start = bench_time_ns();
+    do {
+        lwjson_find_many(&lwobj, paths, sizeof(paths) / sizeof(paths[0]), results);
+        bench_consume(results[0]);
+        ++iterations_many;
+        elapsed_many = bench_time_ns() - start;
+    } while (elapsed_many < BENCH_MIN_TIME_NS);
+
+    printf("%22s %8s %14s\r\n", "api", "paths", "ns/path");
+    printf("%22s %8u %14.1f\r\n", "lwjson_find", (unsigned)(sizeof(paths) / sizeof(paths[0])),
+           (double)elapsed_text / (double)(iterations_text * (sizeof(paths) / sizeof(paths[0]))));
+    printf("%22s %8u %14.1f\r\n", "lwjson_find_compiled", (unsigned)(sizeof(paths) / sizeof(paths[0])),
+           (double)elapsed_compiled / (double)(iterations_compiled * (sizeof(paths) / sizeof(paths[0]))));
+    printf("%22s %8u %14.1f\r\n", "lwjson_find_many", (unsigned)(sizeof(paths) / sizeof(paths[0])),
+           (double)elapsed_many / (double)(iterations_many * (sizeof(paths) / sizeof(paths[0]))));
+out:
+    lwjson_free(&lwobj);
+    free(json);
+    free(tokens);
+    return ret;
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/**
+ * \brief           Benchmark descriptor
+ */
+typedef struct {
+    const char* name;    /*!< Benchmark name, used to select it on command line */
+    int (*run_fn)(void); /*!< Benchmark entry point */
+} bench_entry_t;
+
+/* List of all benchmarks */
+static const bench_entry_t benchmarks[] = {
+    {"child_linking", bench_child_linking_run},
+    {"count_tokens", bench_count_tokens_run},
+    {"find", bench_find_run},
+    {"numbers", bench_numbers_run},
+    {"parallel", bench_parallel_run},
+    {"pipeline", bench_pipeline_run},
+    {"shaped", bench_shaped_run},
+};
+
+/**
+ * \brief           Load JSON file from test data directory
+ * \param[in]       name: File name in `tests/json` directory
+ * \param[out]      len: Length of loaded data, excluding `NULL` termination
+ * \return          Allocated and `NULL` terminated file content, `NULL` on failure
+ */
+char*
+bench_load_json(const char* name, size_t* len) {
+    char path[512], *data = NULL;
+    FILE* f;
+    long size;
+
+    snprintf(path, sizeof(path), "%s%s", BENCH_JSON_DIR, name);
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("Cannot open %s\r\n", path);
+        return NULL;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0
+        && (data = malloc((size_t)size + 1)) != NULL) {
+        if (fread(data, 1, (size_t)size, f) == (size_t)size) {
+            data[size] = '\0';
+            *len = (size_t)size;
+        } else {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    return data;
+}
+
+int
+main(int argc, char** argv) {
+    int ret = 0;
+
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); ++i) {
+        /* Run only selected benchmark, or all when no name is given */
+        if (argc > 1 && strcmp(argv[1], benchmarks[i].name) != 0) {
+            continue;
+        }
+        printf("--- Benchmark: %s\r\n", benchmarks[i].name);
+        ret |= benchmarks[i].run_fn();
+    }
+    return ret;
+}
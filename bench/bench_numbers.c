@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/**
+ * \brief           Build JSON array with all numbers from JSON document
+ * \param[in]       json: JSON document
+ * \param[in]       len: Length of JSON document
+ * \param[out]      count: Number of numbers in the array
+ * \param[out]      out_len: Length of generated string
+ * \return          Allocated string, `NULL` on failure
+ */
+static char*
+prv_extract_numbers(const char* json, size_t len, size_t* count, size_t* out_len) {
+    char *str, *p;
+    uint8_t in_string = 0;
+
+    str = malloc(len + 3);
+    if (str == NULL) {
+        return NULL;
+    }
+    p = str;
+    *p++ = '[';
+    *count = 0;
+    for (size_t i = 0; i < len; ++i) {
+        if (in_string) {
+            if (json[i] == '\\') {
+                ++i;
+            } else if (json[i] == '"') {
+                in_string = 0;
+            }
+        } else if (json[i] == '"') {
+            in_string = 1;
+        } else if (json[i] == '-' || (json[i] >= '0' && json[i] <= '9')) {
+            if (*count > 0) {
+                *p++ = ',';
+            }
+            for (; i < len && strchr("0123456789+-.eE", json[i]) != NULL; ++i) {
+                *p++ = json[i];
+            }
+            --i;
+            ++*count;
+        }
+    }
+    *p++ = ']';
+    *p = '\0';
+    *out_len = (size_t)(p - str);
+    return str;
+}
+
+/**
+ * \brief           Measure parse time of JSON data
+ *
+ * Measurement is split to several rounds and the fastest one is used,
+ * to filter out noise of other processes in the system
+ *
+ * \param[in]       lwobj: LwJSON instance with enough tokens
+ * \param[in]       json: JSON data
+ * \param[in]       len: JSON data length
+ * \return          Time for single parse in nanoseconds, `0` on failure
+ */
+static double
+prv_measure(lwjson_t* lwobj, const char* json, size_t len) {
+    double best = 0;
+
+    for (size_t round = 0; round < 20; ++round) {
+        uint64_t start, elapsed;
+        size_t iterations = 0;
+
+        start = bench_time_ns();
+        do {
+            if (lwjson_parse_ex(lwobj, json, len) != lwjsonOK) {
+                return 0;
+            }
+            bench_consume(lwobj);
+            ++iterations;
+            elapsed = bench_time_ns() - start;
+        } while (elapsed < BENCH_MIN_TIME_NS / 20);
+        if (round == 0 || (double)elapsed / (double)iterations < best) {
+            best = (double)elapsed / (double)iterations;
+        }
+    }
+    return best;
+}
+
+/**
+ * \brief           Measure number parsing speed on numeric heavy JSON document
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_numbers_run(void) {
+    static lwjson_token_t tokens[8192];
+    lwjson_t lwobj;
+    size_t len, nums_len, count;
+    char *json, *nums;
+    double time_ns;
+    int ret = 0;
+
+    json = bench_load_json("weather_onecall.json", &len);
+    nums = json != NULL ? prv_extract_numbers(json, len, &count, &nums_len) : NULL;
+    if (json == NULL || nums == NULL) {
+        free(json);
+        return -1;
+    }
+    lwjson_init(&lwobj, tokens, LWJSON_ARRAYSIZE(tokens));
+
+    printf("%22s %10s %12s %12s\r\n", "input", "numbers", "MB/s", "ns/number");
+    if ((time_ns = prv_measure(&lwobj, json, len)) > 0) {
+        printf("%22s %10s %12.1f %12s\r\n", "weather_onecall.json", "-", (double)len * 1000.0 / time_ns, "-");
+    } else {
+        ret = -1;
+    }
+    if ((time_ns = prv_measure(&lwobj, nums, nums_len)) > 0) {
+        printf("%22s %10u %12.1f %12.2f\r\n", "numbers only", (unsigned)count, (double)nums_len * 1000.0 / time_ns,
+               time_ns / (double)count);
+    } else {
+        ret = -1;
+    }
+    lwjson_free(&lwobj);
+    free(nums);
+    free(json);
+    return ret;
+}
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/* Size of generated root array */
+#define BENCH_PARALLEL_DATA_LEN (64UL * 1024UL * 1024UL)
+
+/* Number of worker threads to measure, `1` is single-threaded parse */
+static const size_t workers[] = {1, 2, 4, 8};
+
+/**
+ * \brief           Generate large root array of objects
+ * \param[out]      len: Length of generated data
+ * \return          Allocated data, `NULL` on failure
+ */
+static char*
+prv_generate(size_t* len) {
+    char* data = malloc(BENCH_PARALLEL_DATA_LEN + 4096);
+    size_t size = 0;
+
+    if (data == NULL) {
+        return NULL;
+    }
+    data[size++] = '[';
+    for (unsigned i = 0; size < BENCH_PARALLEL_DATA_LEN; ++i) {
+        size += (size_t)sprintf(&data[size], "%s{\"id\":%u,\"name\":\"user \\\"%u\\\" [x]\",\"score\":%u.%02u,\"tags\":[",
+                                i > 0 ? ",\n" : "", i, i * 7, i % 1000, i % 100);
+        for (unsigned k = 0; k < i % 7; ++k) {
+            size += (size_t)sprintf(&data[size], "%s{\"k\":%u,\"on\":%s}", k > 0 ? "," : "", k, k & 1 ? "true" : "false");
+        }
+        size += (size_t)sprintf(&data[size], "]}");
+    }
+    data[size++] = ']';
+    data[size] = '\0';
+    *len = size;
+    return data;
+}
+
+/**
+ * \brief           Compare single-threaded parse of large root array with parallel parse
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_parallel_run(void) {
+    lwjson_token_t* tokens;
+    lwjson_t lwobj;
+    double base = 0;
+    size_t len, count;
+    char* data;
+
+    data = prv_generate(&len);
+    if (data == NULL || lwjson_count_tokens(data, len, &count, NULL) != lwjsonOK) {
+        printf("Cannot generate data\r\n");
+        free(data);
+        return -1;
+    }
+
+    /* Parts get tokens proportionally to their length, some headroom avoids parsing them again */
+    count += count / 8;
+    tokens = malloc(sizeof(*tokens) * count);
+    if (tokens == NULL) {
+        free(data);
+        return -1;
+    }
+    lwjson_init(&lwobj, tokens, count);
+
+    printf("%8s %8s %14s %10s\r\n", "MB", "workers", "parse MB/s", "speedup");
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); ++i) {
+        uint64_t start, elapsed;
+        size_t iterations = 0;
+        double mbs;
+
+        start = bench_time_ns();
+        do {
+            if (lwjson_parse_parallel(&lwobj, data, len, workers[i]) != lwjsonOK) {
+                printf("Parse failed with %u workers\r\n", (unsigned)workers[i]);
+                free(data);
+                free(tokens);
+                return -1;
+            }
+            bench_consume(&lwobj);
+            ++iterations;
+            elapsed = bench_time_ns() - start;
+        } while (elapsed < BENCH_MIN_TIME_NS);
+        mbs = (double)len * (double)iterations * 1000.0 / (double)elapsed;
+        if (i == 0) {
+            base = mbs;
+        }
+        printf("%8u %8u %14.1f %9.2fx\r\n", (unsigned)(len >> 20), (unsigned)workers[i], mbs, mbs / base);
+    }
+    free(data);
+    free(tokens);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/* Size of generated newline delimited JSON data */
+#define BENCH_PIPELINE_DATA_LEN (32UL * 1024UL * 1024UL)
+
+/* Number of worker threads to measure */
+static const size_t workers[] = {1, 2, 4, 8};
+
+/**
+ * \brief           Record callback, that only checks parse result
+ */
+static void
+prv_record_fn(void* user_data, const lwjson_t* lwobj, const char* record, size_t len, lwjsonr_t res) {
+    (void)lwobj;
+    (void)record;
+    (void)len;
+    if (res != lwjsonOK) {
+        *(volatile int*)user_data = 1;
+    }
+}
+
+/**
+ * \brief           Generate newline delimited JSON data with records of very different sizes
+ * \param[out]      len: Length of generated data
+ * \return          Allocated data, `NULL` on failure
+ */
+static char*
+prv_generate(size_t* len) {
+    char* data = malloc(BENCH_PIPELINE_DATA_LEN + 4096);
+    size_t size = 0;
+
+    if (data == NULL) {
+        return NULL;
+    }
+    for (unsigned i = 0; size < BENCH_PIPELINE_DATA_LEN; ++i) {
+        size += (size_t)sprintf(&data[size], "{\"id\":%u,\"name\":\"user %u\",\"score\":%u.%02u,\"tags\":[", i, i * 7,
+                                i % 1000, i % 100);
+        for (unsigned k = 0; k < (i % 97 == 0 ? 60 : i % 7); ++k) {
+            size += (size_t)sprintf(&data[size], "%s{\"k\":%u,\"on\":%s}", k > 0 ? "," : "", k, k & 1 ? "true" : "false");
+        }
+        size += (size_t)sprintf(&data[size], "]}\n");
+    }
+    *len = size;
+    return data;
+}
+
+/**
+ * \brief           Measure pipeline throughput
+ * \param[in]       cfg: Pipeline configuration
+ * \param[in]       data: Newline delimited JSON data
+ * \param[in]       len: Data length
+ * \return          Throughput in MB/s, negative on failure
+ */
+static double
+prv_measure(const lwjson_pipeline_cfg_t* cfg, const char* data, size_t len) {
+    uint64_t start, elapsed;
+    size_t iterations = 0;
+
+    start = bench_time_ns();
+    do {
+        if (lwjson_pipeline_run(cfg, data, len) != lwjsonOK || *(volatile int*)cfg->user_data) {
+            return -1;
+        }
+        ++iterations;
+        elapsed = bench_time_ns() - start;
+    } while (elapsed < BENCH_MIN_TIME_NS);
+    return (double)len * (double)iterations * 1000.0 / (double)elapsed;
+}
+
+/**
+ * \brief           Measure pipeline throughput with different number of workers, in both delivery modes
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_pipeline_run(void) {
+    lwjson_pipeline_cfg_t cfg = {0};
+    double unordered, ordered, base = 0;
+    int error = 0;
+    size_t len;
+    char* data;
+
+    data = prv_generate(&len);
+    if (data == NULL) {
+        return -1;
+    }
+    cfg.tokens_len = 256;
+    cfg.record_fn = prv_record_fn;
+    cfg.user_data = &error;
+    printf("%8s %16s %14s %10s\r\n", "workers", "unordered MB/s", "ordered MB/s", "speedup");
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); ++i) {
+        cfg.workers = workers[i];
+        cfg.ordered = 0;
+        unordered = prv_measure(&cfg, data, len);
+        cfg.ordered = 1;
+        ordered = prv_measure(&cfg, data, len);
+        if (unordered < 0 || ordered < 0) {
+            printf("Pipeline failed with %u workers\r\n", (unsigned)workers[i]);
+            free(data);
+            return -1;
+        }
+        if (i == 0) {
+            base = unordered;
+        }
+        printf("%8u %16.1f %14.1f %9.2fx\r\n", (unsigned)workers[i], unordered, ordered, unordered / base);
+    }
+    free(data);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "lwjson/lwjson.h"
+
+/* JSON files used for the benchmark */
+static const char* files[] = {
+    "custom.json",
+    "weather_current.json",
+    "weather_onecall.json",
+};
+
+/**
+ * \brief           Measure parse throughput with given parse function
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       parse_fn: Parse function
+ * \param[in]       json: Two buffers with the same JSON data, used in turns as previous and new document
+ * \param[in]       len: JSON data length
+ * \return          Throughput in MB/s, negative on failure
+ */
+static double
+prv_measure(lwjson_t* lwobj, lwjsonr_t (*parse_fn)(lwjson_t*, const void*, size_t), char* const* json, size_t len) {
+    uint64_t start, elapsed;
+    size_t iterations = 0;
+
+    start = bench_time_ns();
+    do {
+        if (parse_fn(lwobj, json[iterations & 0x01], len) != lwjsonOK) {
+            return -1;
+        }
+        bench_consume(lwobj);
+        ++iterations;
+        elapsed = bench_time_ns() - start;
+    } while (elapsed < BENCH_MIN_TIME_NS);
+    return (double)len * (double)iterations * 1000.0 / (double)elapsed;
+}
+
+/**
+ * \brief           Compare full parse with shaped parse of documents with the same structure
+ * \return          `0` on success, `-1` otherwise
+ */
+int
+bench_shaped_run(void) {
+    lwjson_t lwobj;
+
+    printf("%22s %8s %14s %14s\r\n", "file", "tokens", "parse MB/s", "shaped MB/s");
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        lwjson_token_t* tokens;
+        double parse, shaped;
+        size_t len, count;
+        char* json[2];
+
+        json[0] = bench_load_json(files[i], &len);
+        json[1] = bench_load_json(files[i], &len);
+        if (json[0] == NULL || json[1] == NULL || lwjson_count_tokens(json[0], len, &count, NULL) != lwjsonOK) {
+            printf("Cannot count tokens in %s\r\n", files[i]);
+            free(json[0]);
+            free(json[1]);
+            return -1;
+        }
+        tokens = malloc(sizeof(*tokens) * (count > 0 ? count : 1));
+        if (tokens == NULL) {
+            free(json[0]);
+            free(json[1]);
+            return -1;
+        }
+        lwjson_init(&lwobj, tokens, count);
+
+        /* Shaped parse reuses tokens and compares keys of the previous document, received to the other buffer */
+        parse = prv_measure(&lwobj, lwjson_parse_ex, json, len);
+        shaped = prv_measure(&lwobj, lwjson_parse_shaped, json, len);
+        lwjson_free(&lwobj);
+        free(json[0]);
+        free(json[1]);
+        free(tokens);
+        if (parse < 0 || shaped < 0) {
+            printf("Parse failed for %s\r\n", files[i]);
+            return -1;
+        }
+        printf("%22s %8u %14.1f %14.1f\r\n", files[i], (unsigned)count, parse, shaped);
+    }
+    return 0;
+}
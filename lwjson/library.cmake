@@ -25,6 +25,11 @@ set(lwjson_debug_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwjson/lwjson_debug.c
 )
 
+# Pipeline sources
+set(lwjson_pipeline_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwjson/lwjson_pipeline.c
+)
+
 # Setup include directories
 set(lwjson_include_DIRS
     ${CMAKE_CURRENT_LIST_DIR}/src/include
@@ -46,6 +51,17 @@ target_compile_options(lwjson_debug PRIVATE ${LWJSON_COMPILE_OPTIONS})
 target_compile_definitions(lwjson_debug PRIVATE ${LWJSON_COMPILE_DEFINITIONS})
 target_link_libraries(lwjson_debug PUBLIC lwjson)
 
+# Register lwjson pipeline module
+find_package(Threads)
+if(Threads_FOUND)
+    add_library(lwjson_pipeline)
+    target_sources(lwjson_pipeline PRIVATE ${lwjson_pipeline_SRCS})
+    target_include_directories(lwjson_pipeline PUBLIC ${lwjson_include_DIRS})
+    target_compile_options(lwjson_pipeline PRIVATE ${LWJSON_COMPILE_OPTIONS})
+    target_compile_definitions(lwjson_pipeline PRIVATE ${LWJSON_COMPILE_DEFINITIONS})
+    target_link_libraries(lwjson_pipeline PUBLIC lwjson Threads::Threads)
+endif()
+
 # Create config file if user didn't provide one info himself
 if(NOT LWJSON_OPTS_FILE)
     message(STATUS "Using default lwjson_opts.h file")
@@ -83,6 +83,45 @@ typedef LWJSON_CFG_REAL_TYPE lwjson_real_t;
  */
 typedef LWJSON_CFG_INT_TYPE lwjson_int_t;
 
+#if LWJSON_CFG_COMPACT_TOKENS || __DOXYGEN__
+
+/**
+ * \brief           Compact JSON token, used when \ref LWJSON_CFG_COMPACT_TOKENS is enabled
+ *
+ * Tokens are stored in document order in the token array, with root token at index `0`.
+ * First child of object or array is the next token in the array,
+ * and next sibling follows after all the tokens of the subtree.
+ *
+ * Strings and names are stored as offsets from the beginning of parsed JSON data.
+ * Use \ref lwjson_get_token_name and \ref lwjson_get_val_string_ex functions to access them.
+ */
+typedef struct lwjson_token {
+    uint32_t token_name;            /*!< Offset of token name in JSON data (if exists) */
+    uint32_t type           : 4;    /*!< Token type, member of \ref lwjson_type_t */
+    uint32_t has_name       : 1;    /*!< Set to `1` when token has a name */
+    uint32_t has_next       : 1;    /*!< Set to `1` when token has next sibling */
+    uint32_t packed         : 1;    /*!< Set to `1` for array, packed with \ref LWJSON_CFG_PACKED_ARRAYS */
+    uint32_t reserved       : 1;    /*!< Reserved for future use */
+    uint32_t token_name_len : 24;   /*!< Length of token name */
+
+    union {
+        struct {
+            uint32_t token_value;     /*!< Offset of the beginning of the string in JSON data */
+            uint32_t token_value_len; /*!< Length of token value */
+        } str;                        /*!< String data */
+
+        lwjson_real_t num_real; /*!< Real number format */
+        lwjson_int_t num_int;   /*!< Int number format */
+
+        struct {
+            uint32_t child_tokens; /*!< Number of all tokens in the subtree, excluding this one */
+            uint32_t parent;       /*!< Index of parent token plus one, used during parsing only */
+        } cont;                    /*!< Object or array data */
+    } u;                           /*!< Union with different data types */
+} lwjson_token_t;
+
+#else
+
 /**
  * \brief           JSON token
  */
@@ -99,12 +138,18 @@ typedef struct lwjson_token {
                 token_value_len; /*!< Length of token value (this is needed to support const input strings to parse) */
         } str;                   /*!< String data */
 
-        lwjson_real_t num_real;           /*!< Real number format */
-        lwjson_int_t num_int;             /*!< Int number format */
-        struct lwjson_token* first_child; /*!< First children object for object or array type */
-    } u;                                  /*!< Union with different data types */
+        lwjson_real_t num_real; /*!< Real number format */
+        lwjson_int_t num_int;   /*!< Int number format */
+
+        struct {
+            struct lwjson_token* first_child; /*!< First children object for object or array type */
+            size_t child_tokens;              /*!< Number of all tokens in the subtree, excluding this one */
+        } cont;                               /*!< Object or array data */
+    } u;                                      /*!< Union with different data types */
 } lwjson_token_t;
 
+#endif /* LWJSON_CFG_COMPACT_TOKENS || __DOXYGEN__ */
+
 /**
  * \brief           JSON result enumeration
  */
@@ -120,8 +165,27 @@ typedef enum {
     lwjsonSTREAMDONE,          /*!< Streaming parser is done,
                                     closing character matched the stream opening one */
     lwjsonSTREAMINPROG,        /*!< Stream parsing is still in progress */
+
+    lwjsonERRRANGE,    /*!< Integer number does not fit into \ref lwjson_int_t type */
+    lwjsonERRUTF8,     /*!< String contains invalid UTF-8 sequence */
+    lwjsonPARSEINPROG, /*!< Resumable parsing is still in progress, more data or calls are needed */
+    lwjsonPARSEEND,    /*!< There are no more documents to parse in the data */
+    lwjsonPARSEPARTIAL, /*!< Parsing stopped before the end of data, as all requested paths are found */
 } lwjsonr_t;
 
+#if LWJSON_CFG_ALLOC || __DOXYGEN__
+
+/**
+ * \brief           Dynamically allocated block of tokens
+ */
+typedef struct lwjson_token_block {
+    struct lwjson_token_block* next; /*!< Next block in a list */
+    size_t tokens_len;               /*!< Number of tokens in this block */
+    lwjson_token_t tokens[];         /*!< Tokens in the block */
+} lwjson_token_block_t;
+
+#endif /* LWJSON_CFG_ALLOC || __DOXYGEN__ */
+
 /**
  * \brief           LwJSON instance
  */
@@ -129,23 +193,198 @@ typedef struct {
     lwjson_token_t* tokens;     /*!< Pointer to array of tokens */
     size_t tokens_len;          /*!< Size of all tokens */
     size_t next_free_token_pos; /*!< Position of next free token instance */
+#if LWJSON_CFG_ALLOC || __DOXYGEN__
+    lwjson_token_block_t* blocks; /*!< List of dynamically allocated token blocks */
+    lwjson_token_block_t* block;  /*!< Block currently used for token allocation.
+                                       Set to `NULL` when tokens are allocated from static array */
+    size_t block_pos;             /*!< Position of next free token in current block */
+#endif                            /* LWJSON_CFG_ALLOC || __DOXYGEN__ */
+#if LWJSON_CFG_COMPACT_TOKENS
+    const char* json_data; /*!< Parsed JSON data, base for token string offsets.
+                                First token is the first entry in tokens array */
+#else
     lwjson_token_t first_token; /*!< First token on a list */
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX || __DOXYGEN__
+    struct {
+        uint8_t* arena;    /*!< Memory for index tables, set with \ref lwjson_set_index_arena */
+        size_t arena_len;  /*!< Length of arena in units of bytes */
+        size_t arena_used; /*!< Number of used bytes in arena */
+        void** dir;        /*!< Open-addressing table of built index tables, keyed by token address */
+        size_t dir_size;   /*!< Number of entries in the table of index tables, power of two */
+        size_t count;      /*!< Number of built index tables */
+        uint8_t full;      /*!< Set to `1` when there was no memory for the last table */
+    } index;               /*!< Key hash index of large objects and element index of large arrays */
+#endif                     /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX || __DOXYGEN__ */
+#if LWJSON_CFG_PARSE_RESUME || __DOXYGEN__
+    struct {
+        const void* json_data; /*!< JSON data being parsed */
+        size_t pos;            /*!< Position of next character to parse */
+        size_t scan_pos;       /*!< Position of next character to scan for the end of complete value */
+        size_t safe_len;       /*!< Length of data, that ends with `,`, `]` or `}` after complete value */
+        lwjson_token_t* to;    /*!< Currently open object or array token */
+        lwjson_token_t* tail;  /*!< Last child of currently open object or array */
+        uint8_t scan_state;    /*!< Scanner state, outside or inside of string or comment */
+        uint8_t started;       /*!< Set to `1` once root object or array is open */
+    } resume;                  /*!< State of resumable parsing */
+#endif                         /* LWJSON_CFG_PARSE_RESUME || __DOXYGEN__ */
 
     struct {
         uint8_t parsed : 1; /*!< Flag indicating JSON parsing has finished successfully */
+        uint8_t insitu : 1; /*!< Flag indicating strings and names were decoded in place */
+        uint8_t packed : 1; /*!< Flag indicating arrays were packed with \ref lwjson_parse_packed */
     } flags;                /*!< List of flags */
 } lwjson_t;
 
+/* Index of compiled path segment, that matches any element of array */
+#define LWJSON_PATH_INDEX_ANY ((size_t)-1)
+
+/* Maximal number of paths, passed to lwjson_parse_projected and lwjson_parse_until_found functions */
+#define LWJSON_PROJ_MAX_PATHS 32
+
+/**
+ * \brief           Segment of compiled path
+ */
+typedef struct {
+    const char* key; /*!< Key of object member in path string, not `NULL` terminated.
+                          Set to `NULL` for array element */
+    size_t key_len;  /*!< Length of key in units of bytes */
+    size_t index;    /*!< Index of array element or \ref LWJSON_PATH_INDEX_ANY for any element */
+#if LWJSON_CFG_KEY_INDEX || __DOXYGEN__
+    uint32_t hash; /*!< Hash of the key, used with key hash index */
+#endif             /* LWJSON_CFG_KEY_INDEX || __DOXYGEN__ */
+} lwjson_path_segment_t;
+
+/**
+ * \brief           Path, compiled with \ref lwjson_path_compile function
+ */
+typedef struct {
+    lwjson_path_segment_t segments[LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Path segments */
+    size_t segments_cnt;                                           /*!< Number of used segments */
+} lwjson_path_t;
+
+/**
+ * \brief           Segment of query, parsed by \ref lwjson_query_begin function
+ */
+typedef struct {
+    const char* key;        /*!< Key of object member in query string, not `NULL` terminated.
+                                 Set to `NULL` for any member `*` or for array elements */
+    size_t key_len;         /*!< Length of key in units of bytes */
+    size_t start;           /*!< Index of first array element in the slice */
+    size_t end;             /*!< Index after last array element in the slice */
+    uint8_t is_array;       /*!< Set to `1` when segment selects array elements */
+    uint8_t op;             /*!< Comparison operator of predicate, `0` when segment has no predicate */
+    lwjson_type_t type;     /*!< Type of predicate value */
+    const char* pred_key;   /*!< Key of compared child member, not `NULL` terminated */
+    size_t pred_key_len;    /*!< Length of compared key in units of bytes */
+    const char* str;        /*!< Predicate value for \ref LWJSON_TYPE_STRING type, without quotes */
+    size_t str_len;         /*!< Length of string value in units of bytes */
+    lwjson_int_t num_int;   /*!< Predicate value for \ref LWJSON_TYPE_NUM_INT type */
+    lwjson_real_t num_real; /*!< Predicate value for \ref LWJSON_TYPE_NUM_REAL type */
+} lwjson_query_segment_t;
+
+/**
+ * \brief           Query iterator, that returns all tokens matching the query
+ */
+typedef struct {
+    lwjson_t* lwobj;                                               /*!< LwJSON instance */
+    lwjson_query_segment_t segments[LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Query segments */
+    size_t segments_cnt;                                           /*!< Number of used segments */
+    size_t depth;                                                  /*!< Number of levels with search in progress */
+    lwjson_token_t elem;                                           /*!< Element value of packed array */
+    struct {
+        const lwjson_token_t* parent;  /*!< Object or array, which children are checked */
+        const lwjson_token_t* next;    /*!< Next child to check */
+        size_t index;                  /*!< Index of next child */
+    } level[LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Search state of every segment */
+} lwjson_query_t;
+
+/**
+ * \brief           Iterator over elements of array, that hides representation of packed arrays
+ */
+typedef struct {
+    const lwjson_token_t* array; /*!< Array token */
+    const lwjson_token_t* next;  /*!< Next element token of not packed array */
+    size_t index;                /*!< Index of next element */
+    lwjson_token_t elem;         /*!< Token with element value of packed array */
+} lwjson_array_iter_t;
+
 lwjsonr_t lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len);
 lwjsonr_t lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t len);
+lwjsonr_t lwjson_parse_padded(lwjson_t* lwobj, const void* json_data, size_t len);
+lwjsonr_t lwjson_parse_insitu(lwjson_t* lwobj, void* json_data, size_t len);
+lwjsonr_t lwjson_parse_packed(lwjson_t* lwobj, const void* json_data, size_t len);
+lwjsonr_t lwjson_parse_shaped(lwjson_t* lwobj, const void* json_data, size_t len);
 lwjsonr_t lwjson_parse(lwjson_t* lwobj, const char* json_str);
+lwjsonr_t lwjson_parse_many(lwjson_t* lwobj, const void* json_data, size_t len, size_t* pos, size_t* doc_len);
+lwjsonr_t lwjson_parse_fragment(lwjson_t* lwobj, const void* json_data, size_t begin, size_t end, lwjson_type_t type);
+lwjsonr_t lwjson_parse_projected(lwjson_t* lwobj, const void* json_data, size_t len, const char* const* paths,
+                                 size_t paths_cnt);
+lwjsonr_t lwjson_parse_until_found(lwjson_t* lwobj, const void* json_data, size_t len, const char* const* paths,
+                                   size_t paths_cnt, const lwjson_token_t** found);
+lwjsonr_t lwjson_parse_begin(lwjson_t* lwobj);
+lwjsonr_t lwjson_parse_resume(lwjson_t* lwobj, const void* json_data, size_t len, size_t max_tokens);
+lwjsonr_t lwjson_count_tokens(const void* json_data, size_t json_len, size_t* count, size_t* max_depth);
+lwjsonr_t lwjson_validate(const void* json_data, size_t json_len);
 const lwjson_token_t* lwjson_find(lwjson_t* lwobj, const char* path);
 const lwjson_token_t* lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path);
+lwjsonr_t lwjson_path_compile(lwjson_path_t* cpath, const char* path);
+lwjsonr_t lwjson_set_index_arena(lwjson_t* lwobj, void* arena, size_t arena_len);
+const lwjson_token_t* lwjson_find_compiled(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_path_t* cpath);
+lwjsonr_t lwjson_find_many(lwjson_t* lwobj, const char* const* paths, size_t paths_cnt, const lwjson_token_t** results);
+const lwjson_token_t* lwjson_skip_subtree(const lwjson_t* lwobj, const lwjson_token_t* token);
+const void* lwjson_get_packed(const lwjson_token_t* token, lwjson_type_t* type, size_t* len);
+void lwjson_array_iter_init(lwjson_array_iter_t* iter, const lwjson_token_t* array);
+const lwjson_token_t* lwjson_array_iter_next(lwjson_array_iter_t* iter);
+const lwjson_token_t* lwjson_array_get(lwjson_t* lwobj, const lwjson_token_t* token, size_t index);
+const lwjson_token_t* lwjson_array_get_ex(lwjson_t* lwobj, const lwjson_token_t* token, size_t index,
+                                          lwjson_token_t* elem);
+size_t lwjson_array_size(lwjson_t* lwobj, const lwjson_token_t* token);
+lwjsonr_t lwjson_query_begin(lwjson_query_t* query, lwjson_t* lwobj, const lwjson_token_t* token, const char* str);
+const lwjson_token_t* lwjson_query_next(lwjson_query_t* query);
 lwjsonr_t lwjson_free(lwjson_t* lwobj);
 
+#if LWJSON_CFG_LAZY_NUMBERS
+lwjson_int_t lwjson_get_val_int(const lwjson_token_t* token);
+lwjson_real_t lwjson_get_val_real(const lwjson_token_t* token);
+#endif /* LWJSON_CFG_LAZY_NUMBERS */
+#if LWJSON_CFG_LAZY_NUMBERS || __DOXYGEN__
+const char* lwjson_get_val_number_raw(const lwjson_token_t* token, size_t* len);
+#endif /* LWJSON_CFG_LAZY_NUMBERS || __DOXYGEN__ */
+
 void lwjson_print_token(const lwjson_token_t* token);
 void lwjson_print_json(const lwjson_t* lwobj);
 
+/**
+ * \brief           Callback function for every record of newline delimited JSON data
+ * \param[in]       user_data: User data from pipeline configuration
+ * \param[in]       lwobj: LwJSON instance with parsed record. Valid only during callback
+ * \param[in]       record: Record data
+ * \param[in]       len: Record length. On error, it covers the rest of the line
+ * \param[in]       res: Result of parsing the record
+ */
+typedef void (*lwjson_pipeline_record_fn)(void* user_data, const lwjson_t* lwobj, const char* record, size_t len,
+                                          lwjsonr_t res);
+
+/**
+ * \brief           Configuration of multi-threaded pipeline.
+ * Parameters set to `0` use default values
+ */
+typedef struct {
+    size_t workers;                      /*!< Number of worker threads */
+    size_t tokens_len;                   /*!< Number of tokens of every worker */
+    size_t chunk_len;                    /*!< Minimal length of data chunk, processed by worker at once */
+    size_t batch_recs;                   /*!< Max number of records parsed ahead of delivery, in ordered mode */
+    uint8_t ordered;                     /*!< Set to `1` to deliver records in input order */
+    lwjson_pipeline_record_fn record_fn; /*!< Callback function for every record */
+    void* user_data;                     /*!< User data passed to callback function */
+} lwjson_pipeline_cfg_t;
+
+#if !LWJSON_CFG_ALLOC || __DOXYGEN__
+lwjsonr_t lwjson_pipeline_run(const lwjson_pipeline_cfg_t* cfg, const void* data, size_t len);
+lwjsonr_t lwjson_parse_parallel(lwjson_t* lwobj, const void* json_data, size_t len, size_t workers);
+#endif /* !LWJSON_CFG_ALLOC || __DOXYGEN__ */
+
 /**
  * \brief           Object type for streaming parser
  */
@@ -216,6 +455,11 @@ typedef struct lwjson_stream_parser {
             size_t buff_pos;       /*!< Buffer position for next write (length of bytes in buffer) */
             size_t buff_total_pos; /*!< Total buffer position used up to now (in several data chunks) */
             uint8_t is_last;       /*!< Status indicates if this is the last part of the string */
+#if LWJSON_CFG_VALIDATE_UTF8 || __DOXYGEN__
+            uint8_t utf8_rem;      /*!< Number of continuation bytes still expected in UTF-8 sequence */
+            uint8_t utf8_lo;       /*!< Lowest valid value of next continuation byte */
+            uint8_t utf8_hi;       /*!< Highest valid value of next continuation byte */
+#endif                     /* LWJSON_CFG_VALIDATE_UTF8 || __DOXYGEN__ */
         } str;                     /*!< String structure. It is only used for keys and string objects.
                                         Use primitive part for all other options */
 
@@ -236,6 +480,14 @@ void* lwjson_stream_get_user_data(lwjson_stream_parser_t* jsp);
 lwjsonr_t lwjson_stream_reset(lwjson_stream_parser_t* jsp);
 lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
 
+#if LWJSON_CFG_COMPACT_TOKENS
+
+#define lwjson_get_tokens_used(lwobj) (((lwobj) != NULL) ? ((lwobj)->next_free_token_pos) : 0)
+#define lwjson_get_first_token(lwobj)                                                                                  \
+    (((lwobj) != NULL && (lwobj)->tokens_len > 0) ? (&(lwobj)->tokens[0]) : NULL)
+
+#else
+
 /**
  * \brief           Get number of tokens used to parse JSON
  * \param[in]       lwobj: Pointer to LwJSON instance
@@ -250,8 +502,13 @@ lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
  */
 #define lwjson_get_first_token(lwobj) (((lwobj) != NULL) ? (&(lwobj)->first_token) : NULL)
 
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+
+#if !LWJSON_CFG_LAZY_NUMBERS || __DOXYGEN__
+
 /**
  * \brief           Get token value for \ref LWJSON_TYPE_NUM_INT type
+ * \note            Macro is replaced by function when \ref LWJSON_CFG_LAZY_NUMBERS is enabled
  * \param[in]       token: token with integer type
  * \return          Int number if type is integer, `0` otherwise
  */
@@ -260,12 +517,32 @@ lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
 
 /**
  * \brief           Get token value for \ref LWJSON_TYPE_NUM_REAL type
+ * \note            Macro is replaced by function when \ref LWJSON_CFG_LAZY_NUMBERS is enabled
  * \param[in]       token: token with real type
  * \return          Real numbeer if type is real, `0` otherwise
  */
 #define lwjson_get_val_real(token)                                                                                     \
     ((lwjson_real_t)(((token) != NULL && (token)->type == LWJSON_TYPE_NUM_REAL) ? (token)->u.num_real : 0))
 
+#endif /* !LWJSON_CFG_LAZY_NUMBERS || __DOXYGEN__ */
+
+#if LWJSON_CFG_COMPACT_TOKENS
+
+#define lwjson_get_first_child(token)                                                                                  \
+    (const void*)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY)      \
+                   && (token)->u.cont.child_tokens > 0 && !(token)->packed)                                            \
+                      ? (token) + 1                                                                                    \
+                      : NULL)
+#define lwjson_get_next(token)                                                                                         \
+    ((const lwjson_token_t*)(((token) != NULL && (token)->has_next)                                                    \
+                                 ? ((token) + 1                                                                        \
+                                    + (((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY)     \
+                                           ? (token)->u.cont.child_tokens                                              \
+                                           : 0))                                                                       \
+                                 : NULL))
+
+#else
+
 /**
  * \brief           Get first child token for \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY types
  * \param[in]       token: token with integer type
@@ -273,23 +550,98 @@ lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
  */
 #define lwjson_get_first_child(token)                                                                                  \
     (const void*)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY))     \
-                      ? (token)->u.first_child                                                                         \
+                      ? (token)->u.cont.first_child                                                                         \
                       : NULL)
 
+/**
+ * \brief           Get next token on the same level (next sibling)
+ * \param[in]       token: Token to get next sibling for
+ * \return          Pointer to next token or `NULL` if token is last on the list
+ */
+#define lwjson_get_next(token) ((const lwjson_token_t*)(((token) != NULL) ? (token)->next : NULL))
+
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+
+/**
+ * \brief           Get number of all tokens in the subtree of the token, excluding the token itself
+ *
+ * Tokens are stored in document order, so the subtree of object or array
+ * is followed by the next token after it, see \ref lwjson_skip_subtree
+ *
+ * \param[in]       token: Token to get subtree size for
+ * \return          Number of children and all their descendants, `0` for other types than object or array
+ */
+#if LWJSON_CFG_COMPACT_TOKENS
+#define lwjson_get_subtree_size(token)                                                                                 \
+    ((size_t)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY))        \
+                  ? (token)->u.cont.child_tokens                                                                       \
+                  : 0))
+#else
+#define lwjson_get_subtree_size(token)                                                                                 \
+    ((size_t)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY))        \
+                  ? (token)->u.cont.child_tokens                                                                            \
+                  : 0))
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+
+/**
+ * \brief           Get token name (object key) of JSON token
+ * \note            Function works with all token layouts,
+ *                      including \ref LWJSON_CFG_COMPACT_TOKENS
+ * \param[in]       lwobj: LwJSON instance used to parse JSON data
+ * \param[in]       token: Token to get name for
+ * \param[out]      name_len: Pointer to variable holding length of name.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to name or `NULL` if token has no name
+ */
+static inline const char*
+lwjson_get_token_name(const lwjson_t* lwobj, const lwjson_token_t* token, size_t* name_len) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (lwobj != NULL && token != NULL && token->has_name) {
+        if (name_len != NULL) {
+            *name_len = token->token_name_len;
+        }
+        return lwobj->json_data + token->token_name;
+    }
+#else
+    (void)lwobj;
+    if (token != NULL && token->token_name != NULL) {
+        if (name_len != NULL) {
+            *name_len = token->token_name_len;
+        }
+        return token->token_name;
+    }
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    return NULL;
+}
+
 /**
  * \brief           Get string value from JSON token
+ * \note            Function works with all token layouts,
+ *                      including \ref LWJSON_CFG_COMPACT_TOKENS
+ * \param[in]       lwobj: LwJSON instance used to parse JSON data
  * \param[in]       token: Token with string type
  * \param[out]      str_len: Pointer to variable holding length of string.
  *                      Set to `NULL` if not used
  * \return          Pointer to string or `NULL` if invalid token type
  */
 static inline const char*
-lwjson_get_val_string(const lwjson_token_t* token, size_t* str_len) {
+lwjson_get_val_string_ex(const lwjson_t* lwobj, const lwjson_token_t* token, size_t* str_len) {
     if (token != NULL && token->type == LWJSON_TYPE_STRING) {
+#if LWJSON_CFG_COMPACT_TOKENS
+        if (lwobj == NULL) {
+            return NULL;
+        }
+#else
+        (void)lwobj;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
         if (str_len != NULL) {
             *str_len = token->u.str.token_value_len;
         }
+#if LWJSON_CFG_COMPACT_TOKENS
+        return lwobj->json_data + token->u.str.token_value;
+#else
         return token->u.str.token_value;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
     }
     return NULL;
 }
@@ -304,6 +656,76 @@ lwjson_get_val_string(const lwjson_token_t* token, size_t* str_len) {
 
 /**
  * \brief           Compare string token with user input string for a case-sensitive match
+ * \note            Function works with all token layouts,
+ *                      including \ref LWJSON_CFG_COMPACT_TOKENS
+ * \param[in]       lwobj: LwJSON instance used to parse JSON data
+ * \param[in]       token: Token with string type
+ * \param[in]       str: NULL-terminated string to compare
+ * \return          `1` if equal, `0` otherwise
+ */
+static inline uint8_t
+lwjson_string_compare_ex(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str) {
+    size_t len;
+    const char* value = lwjson_get_val_string_ex(lwobj, token, &len);
+
+    return value != NULL && strncmp(value, str, len) == 0;
+}
+
+/**
+ * \brief           Compare string token with user input string for a case-sensitive match
+ * \note            Function works with all token layouts,
+ *                      including \ref LWJSON_CFG_COMPACT_TOKENS
+ * \param[in]       lwobj: LwJSON instance used to parse JSON data
+ * \param[in]       token: Token with string type
+ * \param[in]       str: NULL-terminated string to compare
+ * \param[in]       len: Length of the string in bytes
+ * \return          `1` if equal, `0` otherwise
+ */
+static inline uint8_t
+lwjson_string_compare_n_ex(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str, size_t len) {
+    size_t value_len;
+    const char* value = lwjson_get_val_string_ex(lwobj, token, &value_len);
+
+    return value != NULL && len <= value_len && strncmp(value, str, len) == 0;
+}
+
+#if LWJSON_CFG_COMPACT_TOKENS && !__DOXYGEN__
+
+/*
+ * Compact tokens store strings as offsets in JSON data of the instance,
+ * hence functions below take LwJSON instance as first parameter in this layout.
+ * Use `_ex` variants for code, that is built with both token layouts
+ */
+#define lwjson_get_val_string(lwobj, token, str_len)   lwjson_get_val_string_ex((lwobj), (token), (str_len))
+#define lwjson_string_compare(lwobj, token, str)       lwjson_string_compare_ex((lwobj), (token), (str))
+#define lwjson_string_compare_n(lwobj, token, str, len) lwjson_string_compare_n_ex((lwobj), (token), (str), (len))
+
+#else
+
+/**
+ * \brief           Get string value from JSON token
+ * \note            With \ref LWJSON_CFG_COMPACT_TOKENS enabled, function is a macro with
+ *                      LwJSON instance as first parameter, same as \ref lwjson_get_val_string_ex
+ * \param[in]       token: Token with string type
+ * \param[out]      str_len: Pointer to variable holding length of string.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to string or `NULL` if invalid token type
+ */
+static inline const char*
+lwjson_get_val_string(const lwjson_token_t* token, size_t* str_len) {
+    if (token != NULL && token->type == LWJSON_TYPE_STRING) {
+        if (str_len != NULL) {
+            *str_len = token->u.str.token_value_len;
+        }
+        return token->u.str.token_value;
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Compare string token with user input string for a case-sensitive match
+ * \note            With \ref LWJSON_CFG_COMPACT_TOKENS enabled, function is a macro with
+ *                      LwJSON instance as first parameter, same as \ref lwjson_string_compare_ex
  * \param[in]       token: Token with string type
  * \param[in]       str: NULL-terminated string to compare
  * \return          `1` if equal, `0` otherwise
@@ -318,6 +740,8 @@ lwjson_string_compare(const lwjson_token_t* token, const char* str) {
 
 /**
  * \brief           Compare string token with user input string for a case-sensitive match
+ * \note            With \ref LWJSON_CFG_COMPACT_TOKENS enabled, function is a macro with
+ *                      LwJSON instance as first parameter, same as \ref lwjson_string_compare_n_ex
  * \param[in]       token: Token with string type
  * \param[in]       str: NULL-terminated string to compare
  * \param[in]       len: Length of the string in bytes
@@ -331,6 +755,8 @@ lwjson_string_compare_n(const lwjson_token_t* token, const char* str, size_t len
     return 0;
 }
 
+#endif /* LWJSON_CFG_COMPACT_TOKENS && !__DOXYGEN__ */
+
 /**
  * \name            LWJSON_STREAM_SEQ
  * \brief           Helper functions for stack analysis in a callback function
@@ -72,6 +72,218 @@ extern "C" {
 #define LWJSON_CFG_INT_TYPE long long
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` correctly rounded real number parsing
+ *
+ * When enabled, numbers are converted to the nearest `double` value with
+ * Eisel-Lemire algorithm, using `10` kB table of 128-bit powers of `10`.
+ * Rare ambiguous cases fall back to exact decimal conversion, that does not depend on locale.
+ * When \ref LWJSON_CFG_REAL_TYPE is `float`, `double` value is rounded to `float`,
+ * and the exact conversion is used when `double` lies half-way between two `float` values,
+ * so `float` result is correctly rounded too.
+ *
+ * When disabled, mantissa is scaled with power of 10, computed in \ref LWJSON_CFG_REAL_TYPE,
+ * which can differ from exact result in the last bits.
+ *
+ * \note            Exact decimal conversion uses about `1` kB of stack
+ */
+#ifndef LWJSON_CFG_REAL_CORRECT_ROUNDING
+#define LWJSON_CFG_REAL_CORRECT_ROUNDING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` conversion of too large integers to real numbers
+ *
+ * When enabled, integer that does not fit into \ref LWJSON_CFG_INT_TYPE
+ * is parsed as \ref LWJSON_TYPE_NUM_REAL token.
+ * When disabled, parsing fails with \ref lwjsonERRRANGE error.
+ */
+#ifndef LWJSON_CFG_INT_OVERFLOW_REAL
+#define LWJSON_CFG_INT_OVERFLOW_REAL 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` UTF-8 validation of strings and object keys
+ *
+ * When enabled, parser checks every string while it is scanned
+ * and returns \ref lwjsonERRUTF8 on invalid, overlong or incomplete sequence,
+ * surrogate code point or code point above `U+10FFFF`.
+ * Stream parser checks the same rules, one character at a time.
+ *
+ * With \ref LWJSON_CFG_SIMD enabled, `16`-byte lookup table kernel is used
+ * on targets with SSSE3 or AArch64 NEON instructions, scalar decoder otherwise.
+ */
+#ifndef LWJSON_CFG_VALIDATE_UTF8
+#define LWJSON_CFG_VALIDATE_UTF8 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` lazy number decoding
+ *
+ * When enabled, parser only checks number format and sets token type
+ * to \ref LWJSON_TYPE_NUM_INT or \ref LWJSON_TYPE_NUM_REAL.
+ * Token keeps position and length of the number in JSON data instead of its value.
+ * Number is converted on every \ref lwjson_get_val_int or \ref lwjson_get_val_real call,
+ * which are functions instead of macros in this mode.
+ *
+ * Exact number text is available with \ref lwjson_get_val_number_raw function.
+ *
+ * \note            JSON data must stay valid for as long as tokens are used
+ * \note            Option cannot be used together with \ref LWJSON_CFG_COMPACT_TOKENS
+ */
+#ifndef LWJSON_CFG_LAZY_NUMBERS
+#define LWJSON_CFG_LAZY_NUMBERS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact token layout
+ *
+ * Compact token takes `16` bytes regardless of the architecture.
+ * It stores `32`-bit offsets to JSON data instead of pointers,
+ * and keeps tokens in document order to find children and siblings without pointers.
+ *
+ * \note            Strings and token names are accessed through the instance, that holds JSON data.
+ *                      \ref lwjson_get_val_string, \ref lwjson_string_compare and \ref lwjson_string_compare_n
+ *                      take LwJSON instance as first parameter in this layout.
+ *                      Use their `_ex` variants and \ref lwjson_get_token_name for code, that is built with both layouts.
+ *                      Use \ref lwjson_get_first_child and \ref lwjson_get_next to traverse tokens.
+ * \note            Input JSON data length is limited to `4GB` and token name length to `16MB`
+ */
+#ifndef LWJSON_CFG_COMPACT_TOKENS
+#define LWJSON_CFG_COMPACT_TOKENS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` dynamic token allocation
+ *
+ * When enabled, parser allocates additional blocks of tokens with \ref LWJSON_MALLOC function,
+ * once all tokens from the array passed to \ref lwjson_init are used.
+ * Blocks are linked together, so existing tokens are never relocated,
+ * and are kept for next parse calls until \ref lwjson_free is called.
+ *
+ * \note            Option cannot be used together with \ref LWJSON_CFG_COMPACT_TOKENS
+ */
+#ifndef LWJSON_CFG_ALLOC
+#define LWJSON_CFG_ALLOC 0
+#endif
+
+/**
+ * \brief           Minimal number of tokens in single dynamically allocated block
+ *
+ * Every new block is at least as large as all previously available tokens,
+ * so the number of allocations only grows logarithmically with the JSON size.
+ *
+ * \note            Used only when \ref LWJSON_CFG_ALLOC is enabled
+ */
+#ifndef LWJSON_CFG_ALLOC_BLOCK_TOKENS
+#define LWJSON_CFG_ALLOC_BLOCK_TOKENS 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` key hash index of large objects
+ *
+ * When enabled, \ref lwjson_find function and its variants build open-addressing hash table
+ * of member names the first time they search for a key in an object with
+ * at least \ref LWJSON_CFG_KEY_INDEX_MIN_MEMBERS members. Later searches in the same object
+ * take constant time. Tables are stored in the arena, set with \ref lwjson_set_index_arena function,
+ * or allocated with \ref LWJSON_MALLOC function when arena is not set and \ref LWJSON_CFG_ALLOC is enabled.
+ *
+ * Tables are dropped when the instance is parsed again or freed.
+ */
+#ifndef LWJSON_CFG_KEY_INDEX
+#define LWJSON_CFG_KEY_INDEX 0
+#endif
+
+/**
+ * \brief           Minimal number of object members to build key hash index for
+ *
+ * Smaller objects are searched linearly.
+ *
+ * \note            Used only when \ref LWJSON_CFG_KEY_INDEX is enabled
+ */
+#ifndef LWJSON_CFG_KEY_INDEX_MIN_MEMBERS
+#define LWJSON_CFG_KEY_INDEX_MIN_MEMBERS 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` element index of large arrays
+ *
+ * When enabled, \ref lwjson_array_get function and `#N` segments of \ref lwjson_find paths
+ * build table of element tokens the first time they access an array with
+ * at least \ref LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS elements. Later accesses to the same array
+ * take constant time. Tables share the memory with \ref LWJSON_CFG_KEY_INDEX tables.
+ *
+ * Tables are dropped when the instance is parsed again or freed.
+ */
+#ifndef LWJSON_CFG_ARRAY_INDEX
+#define LWJSON_CFG_ARRAY_INDEX 0
+#endif
+
+/**
+ * \brief           Minimal number of array elements to build element index for
+ *
+ * Elements of smaller arrays are accessed by walking from the first element.
+ *
+ * \note            Used only when \ref LWJSON_CFG_ARRAY_INDEX is enabled
+ */
+#ifndef LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS
+#define LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` packed arrays of primitive values
+ *
+ * When enabled, \ref lwjson_parse_packed function stores array with only integer numbers,
+ * only real numbers or only `true` and `false` values as single array token,
+ * followed by contiguous block of values in the next tokens of the array.
+ * Elements of packed array have no tokens, so \ref lwjson_get_first_child returns `NULL`
+ * and \ref lwjson_find does not find them. Use \ref lwjson_get_packed, \ref lwjson_array_iter_next
+ * or \ref lwjson_array_get_ex functions to access them.
+ *
+ * Other parse functions never pack arrays, their tokens are the same as with option disabled.
+ *
+ * \note            Option cannot be used together with \ref LWJSON_CFG_ALLOC
+ * \note            When \ref LWJSON_CFG_LAZY_NUMBERS is enabled, only arrays of `true` and `false` values are packed
+ */
+#ifndef LWJSON_CFG_PACKED_ARRAYS
+#define LWJSON_CFG_PACKED_ARRAYS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` resumable parsing
+ *
+ * When enabled, \ref lwjson_parse_begin and \ref lwjson_parse_resume functions
+ * parse JSON data in several calls, while it is being received or to limit time spent in single call.
+ * Parser state is kept in \ref lwjson_t instance between calls.
+ */
+#ifndef LWJSON_CFG_PARSE_RESUME
+#define LWJSON_CFG_PARSE_RESUME 0
+#endif
+
+/**
+ * \brief           Maximal nesting depth of objects and arrays for functions,
+ *                  that scan JSON data without writing any tokens, such as \ref lwjson_count_tokens,
+ *                  and for \ref lwjson_parse_shaped function
+ *
+ * Each level takes `1` bit of stack memory when scanning data
+ * and `1` token pointer in \ref lwjson_parse_shaped, that is `2` kB with default value on 64-bit targets.
+ */
+#ifndef LWJSON_CFG_MAX_DEPTH
+#define LWJSON_CFG_MAX_DEPTH 256
+#endif
+
+/**
+ * \brief           Maximal number of segments in the path, passed to \ref lwjson_parse_projected
+ *                  or \ref lwjson_path_compile functions
+ *
+ * Projected parsing keeps `8` bytes of stack memory per segment for every one of \ref LWJSON_PROJ_MAX_PATHS paths
+ * and for every level of parsed data, that is about `4.3` kB with default value.
+ * Each segment takes `3` pointer sizes in every \ref lwjson_path_t compiled path.
+ */
+#ifndef LWJSON_CFG_MAX_PATH_SEGMENTS
+#define LWJSON_CFG_MAX_PATH_SEGMENTS 16
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` support for inline comments
  *
@@ -81,6 +293,37 @@ extern "C" {
 #define LWJSON_CFG_COMMENTS 0
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` SIMD accelerated input scanning
+ *
+ * When enabled, input is classified in `64`-byte blocks into bitmaps of quotes,
+ * backslashes, blank and `NULL` characters, using AVX2, SSE2 or AArch64 NEON instructions.
+ * Parser then jumps over blank regions and string contents instead of testing every byte.
+ *
+ * Scalar implementation is used on architectures without supported instruction set,
+ * and for the last bytes of the input, shorter than one block.
+ *
+ * \note            Parsed token tree is identical to the one produced by scalar implementation
+ * \note            All `len` bytes passed to \ref lwjson_parse_ex must be readable,
+ *                      even if JSON string is `NULL` terminated earlier
+ */
+#ifndef LWJSON_CFG_SIMD
+#define LWJSON_CFG_SIMD 0
+#endif
+
+/**
+ * \brief           Number of bytes, application guarantees to be readable after JSON data,
+ *                  when parsing with \ref lwjson_parse_padded function
+ *
+ * First padding byte must be set to `0` and is used as the only end-of-input sentinel,
+ * that lets parser drop length checks from all character scanning loops.
+ *
+ * \note            Value must be at least `64` when \ref LWJSON_CFG_SIMD is enabled
+ */
+#ifndef LWJSON_CFG_PADDING_LEN
+#define LWJSON_CFG_PADDING_LEN 64
+#endif
+
 /**
  * \brief           Memory set function
  * 
@@ -99,6 +342,45 @@ extern "C" {
 #define LWJSON_MEMCPY(dst, src, len) memcpy((dst), (src), (len))
 #endif
 
+/**
+ * \brief           Memory move function, for overlapping memory regions
+ * 
+ * \note            Function footprint is the same as \ref memmove
+ */
+#ifndef LWJSON_MEMMOVE
+#define LWJSON_MEMMOVE(dst, src, len) memmove((dst), (src), (len))
+#endif
+
+/**
+ * \brief           Memory allocation function
+ *
+ * \note            Function footprint is the same as \ref malloc
+ * \note            Used only when \ref LWJSON_CFG_ALLOC is enabled and by pipeline module
+ */
+#ifndef LWJSON_MALLOC
+#define LWJSON_MALLOC(size) malloc((size))
+#endif
+
+/**
+ * \brief           Memory free function
+ *
+ * \note            Function footprint is the same as \ref free
+ * \note            Used only when \ref LWJSON_CFG_ALLOC is enabled and by pipeline module
+ */
+#ifndef LWJSON_FREE
+#define LWJSON_FREE(ptr) free((ptr))
+#endif
+
+/**
+ * \brief           Thread create function
+ *
+ * \note            Function footprint is the same as `pthread_create`
+ * \note            Used only by pipeline module
+ */
+#ifndef LWJSON_THREAD_CREATE
+#define LWJSON_THREAD_CREATE(thread, attr, fn, arg) pthread_create((thread), (attr), (fn), (arg))
+#endif
+
 /**
  * \defgroup        LWJSON_OPT_STREAM JSON stream
  * \brief           JSON streaming confiuration
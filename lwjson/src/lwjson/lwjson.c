@@ -33,16 +33,406 @@
  */
 #include <string.h>
 #include "lwjson/lwjson.h"
+#if LWJSON_CFG_ALLOC
+#include <stdlib.h>
+#endif /* LWJSON_CFG_ALLOC */
+#if LWJSON_CFG_REAL_CORRECT_ROUNDING
+#include <math.h>
+#endif /* LWJSON_CFG_REAL_CORRECT_ROUNDING */
+
+#if LWJSON_CFG_ALLOC && LWJSON_CFG_COMPACT_TOKENS
+#error "LWJSON_CFG_ALLOC cannot be used together with LWJSON_CFG_COMPACT_TOKENS"
+#endif
+#if LWJSON_CFG_LAZY_NUMBERS && LWJSON_CFG_COMPACT_TOKENS
+#error "LWJSON_CFG_LAZY_NUMBERS cannot be used together with LWJSON_CFG_COMPACT_TOKENS"
+#endif
+#if LWJSON_CFG_PACKED_ARRAYS && LWJSON_CFG_ALLOC
+#error "LWJSON_CFG_PACKED_ARRAYS cannot be used together with LWJSON_CFG_ALLOC"
+#endif
+
+#if LWJSON_CFG_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LWJSON_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LWJSON_SIMD_SSE2 1
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define LWJSON_SIMD_NEON 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif /* LWJSON_CFG_SIMD */
+
+#if defined(LWJSON_SIMD_AVX2) || defined(LWJSON_SIMD_SSE2) || defined(LWJSON_SIMD_NEON)
+#define LWJSON_SIMD_BLOCK_SIZE 64
+#if LWJSON_CFG_PADDING_LEN < LWJSON_SIMD_BLOCK_SIZE
+#error "LWJSON_CFG_PADDING_LEN must be at least 64 when LWJSON_CFG_SIMD is enabled"
+#endif
+#endif
+
+/* UTF-8 validation kernel needs byte shuffle instruction, available with SSSE3 and NEON */
+#if LWJSON_CFG_VALIDATE_UTF8 && (defined(__SSSE3__) || defined(LWJSON_SIMD_NEON))                                      \
+    && defined(LWJSON_SIMD_BLOCK_SIZE)
+#define LWJSON_UTF8_SIMD 1
+#endif
+
+/* Inline function, even when compiler would keep it as separate function because of its size */
+#if defined(__GNUC__) || defined(__clang__)
+#define LWJSON_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define LWJSON_FORCE_INLINE __forceinline
+#else
+#define LWJSON_FORCE_INLINE inline
+#endif
+
+/* Keep rarely used function out of line, so it does not slow down its caller */
+#if defined(__GNUC__) || defined(__clang__)
+#define LWJSON_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define LWJSON_NOINLINE __declspec(noinline)
+#else
+#define LWJSON_NOINLINE
+#endif
+
+/* Values of compiled projection segment index, that are not array indexes */
+#define LWJSON_PROJ_INDEX_KEY UINT32_MAX         /*!< Segment is key of object member */
+#define LWJSON_PROJ_INDEX_ANY (UINT32_MAX - 1U) /*!< Segment matches any element of array */
+
+/* Every projection path has one bit in `uint32_t` masks */
+#if LWJSON_PROJ_MAX_PATHS > 32
+#error "LWJSON_PROJ_MAX_PATHS cannot be larger than number of bits in projection masks"
+#endif
+
+/**
+ * \brief           Compiled segment of projection path
+ */
+typedef struct {
+    uint32_t index; /*!< Index of array element, \ref LWJSON_PROJ_INDEX_ANY or \ref LWJSON_PROJ_INDEX_KEY */
+    uint16_t off;   /*!< Offset of the key from the beginning of the path */
+    uint16_t len;   /*!< Length of the key in units of bytes */
+} lwjson_proj_segment_t;
+
+/**
+ * \brief           Projection state, to parse only selected paths
+ */
+typedef struct {
+    const char* const* paths;    /*!< Selected paths, in the same format as for \ref lwjson_find */
+    lwjson_proj_segment_t segments[LWJSON_PROJ_MAX_PATHS]
+                                  [LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Paths, compiled before parsing */
+    uint8_t segments_cnt[LWJSON_PROJ_MAX_PATHS]; /*!< Number of compiled segments of every path */
+    const lwjson_token_t** found; /*!< Output array for the first token, found for every path, or `NULL` */
+    size_t depth;                /*!< Level of currently open object or array, where root is at level `0` */
+    size_t keep;                 /*!< Number of open objects and arrays inside subtree, that is kept completely */
+    uint32_t matched;            /*!< Paths, that are completely matched by the last checked member */
+    uint32_t left;               /*!< Paths, that are not found yet, when parsing stops once all are found */
+    uint8_t early;               /*!< Set to `1` to stop parsing once all paths are found */
+
+    struct {
+        uint32_t mask;  /*!< Bit `n` is set when path `n` matches all parents of the members at this level */
+        uint32_t index; /*!< Index of the next member at this level */
+    } level[LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Levels of objects and arrays, that match the paths */
+} lwjson_proj_t;
 
 /**
  * \brief           Internal string object
  */
 typedef struct {
-    const char* start; /*!< Original pointer to beginning of JSON object */
-    size_t len;        /*!< Total length of input json string */
-    const char* p;     /*!< Current char pointer */
+    const char* start;   /*!< Original pointer to beginning of JSON object */
+    size_t len;          /*!< Total length of input json string */
+    const char* p;       /*!< Current char pointer */
+    uint8_t padded;      /*!< Set to `1` when input is followed by \ref LWJSON_CFG_PADDING_LEN readable bytes,
+                              starting with `NULL` termination */
+    uint8_t insitu;      /*!< Set to `1` when input buffer is writable and strings are decoded in place */
+    uint8_t multi;       /*!< Set to `1` when data after the root object or array belongs to the next document */
+    uint8_t fragment;    /*!< Set to `1` when input ends after complete member of the root, without separator */
+    uint8_t packed;      /*!< Set to `1` to pack arrays of primitive values, see \ref LWJSON_CFG_PACKED_ARRAYS */
+    lwjson_proj_t* proj; /*!< Projection state, or `NULL` when all tokens are parsed */
 } lwjson_int_str_t;
 
+/**
+ * \brief           Get index of the lowest bit set in the mask
+ * \param[in]       mask: Mask to check. Must not be `0`
+ * \return          Bit index
+ */
+static inline size_t
+prv_ctz64(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(mask);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return (size_t)idx;
+#else
+    size_t idx = 0;
+    for (; (mask & 0x01) == 0; mask >>= 1, ++idx) {}
+    return idx;
+#endif
+}
+
+#if defined(LWJSON_SIMD_BLOCK_SIZE)
+
+/**
+ * \brief           Character class bitmaps of one input block.
+ * Bit `n` of each mask is set when byte `n` of the block belongs to the class
+ */
+typedef struct {
+    uint64_t quote;  /*!< Double quote `"` character */
+    uint64_t bslash; /*!< Backslash `\` character */
+    uint64_t blank;  /*!< Blank characters, as accepted by \ref prv_skip_blank */
+    uint64_t nul;    /*!< `NULL` termination character */
+} lwjson_simd_block_t;
+
+#if defined(LWJSON_SIMD_NEON)
+/**
+ * \brief           Build 64-bit mask from four 16-byte comparison results
+ * \param[in]       c0: Bytes `0..15` of comparison result
+ * \param[in]       c1: Bytes `16..31` of comparison result
+ * \param[in]       c2: Bytes `32..47` of comparison result
+ * \param[in]       c3: Bytes `48..63` of comparison result
+ * \return          Mask with one bit per byte
+ */
+static inline uint64_t
+prv_neon_movemask(uint8x16_t c0, uint8x16_t c1, uint8x16_t c2, uint8x16_t c3) {
+    static const uint8_t bits[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8x16_t bit = vld1q_u8(bits);
+    uint8x16_t s0, s1;
+
+    s0 = vpaddq_u8(vandq_u8(c0, bit), vandq_u8(c1, bit));
+    s1 = vpaddq_u8(vandq_u8(c2, bit), vandq_u8(c3, bit));
+    s0 = vpaddq_u8(s0, s1);
+    s0 = vpaddq_u8(s0, s0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(s0), 0);
+}
+#endif /* defined(LWJSON_SIMD_NEON) */
+
+/**
+ * \brief           Classify one block of \ref LWJSON_SIMD_BLOCK_SIZE input bytes
+ * \param[in]       p: Pointer to the beginning of the block. Full block must be readable
+ * \param[out]      blk: Output bitmaps
+ */
+static inline void
+prv_simd_classify(const char* p, lwjson_simd_block_t* blk) {
+#if defined(LWJSON_SIMD_AVX2)
+    const __m256i c_quote = _mm256_set1_epi8('"'), c_bslash = _mm256_set1_epi8('\\');
+    const __m256i c_nul = _mm256_setzero_si256(), c_space = _mm256_set1_epi8(' ');
+    const __m256i c_tab = _mm256_set1_epi8('\t'), c_cr = _mm256_set1_epi8('\r');
+    const __m256i c_lf = _mm256_set1_epi8('\n'), c_ff = _mm256_set1_epi8('\f');
+
+    LWJSON_MEMSET(blk, 0x00, sizeof(*blk));
+    for (size_t i = 0; i < 2; ++i) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)(p + 32 * i));
+        __m256i blank;
+
+        blank = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, c_space), _mm256_cmpeq_epi8(v, c_tab)),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(v, c_cr), _mm256_cmpeq_epi8(v, c_lf)));
+        blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(v, c_ff));
+        blk->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c_quote)) << (32 * i);
+        blk->bslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c_bslash)) << (32 * i);
+        blk->nul |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c_nul)) << (32 * i);
+        blk->blank |= (uint64_t)(uint32_t)_mm256_movemask_epi8(blank) << (32 * i);
+    }
+#elif defined(LWJSON_SIMD_SSE2)
+    const __m128i c_quote = _mm_set1_epi8('"'), c_bslash = _mm_set1_epi8('\\');
+    const __m128i c_nul = _mm_setzero_si128(), c_space = _mm_set1_epi8(' ');
+    const __m128i c_tab = _mm_set1_epi8('\t'), c_cr = _mm_set1_epi8('\r');
+    const __m128i c_lf = _mm_set1_epi8('\n'), c_ff = _mm_set1_epi8('\f');
+
+    LWJSON_MEMSET(blk, 0x00, sizeof(*blk));
+    for (size_t i = 0; i < 4; ++i) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(p + 16 * i));
+        __m128i blank;
+
+        blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c_space), _mm_cmpeq_epi8(v, c_tab)),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, c_cr), _mm_cmpeq_epi8(v, c_lf)));
+        blank = _mm_or_si128(blank, _mm_cmpeq_epi8(v, c_ff));
+        blk->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, c_quote)) << (16 * i);
+        blk->bslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, c_bslash)) << (16 * i);
+        blk->nul |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, c_nul)) << (16 * i);
+        blk->blank |= (uint64_t)(uint16_t)_mm_movemask_epi8(blank) << (16 * i);
+    }
+#elif defined(LWJSON_SIMD_NEON)
+    uint8x16_t v[4], r[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        v[i] = vld1q_u8((const uint8_t*)p + 16 * i);
+    }
+#define LWJSON_NEON_MASK(expr)                                                                                         \
+    (r[0] = (expr)(v[0]), r[1] = (expr)(v[1]), r[2] = (expr)(v[2]), r[3] = (expr)(v[3]),                               \
+     prv_neon_movemask(r[0], r[1], r[2], r[3]))
+#define LWJSON_NEON_EQ(x, c) vceqq_u8((x), vdupq_n_u8((uint8_t)(c)))
+#define LWJSON_NEON_QUOTE(x) LWJSON_NEON_EQ(x, '"')
+#define LWJSON_NEON_BSLASH(x) LWJSON_NEON_EQ(x, '\\')
+#define LWJSON_NEON_NUL(x)    LWJSON_NEON_EQ(x, 0)
+#define LWJSON_NEON_BLANK(x)                                                                                           \
+    vorrq_u8(vorrq_u8(vorrq_u8(LWJSON_NEON_EQ(x, ' '), LWJSON_NEON_EQ(x, '\t')),                                     \
+                      vorrq_u8(LWJSON_NEON_EQ(x, '\r'), LWJSON_NEON_EQ(x, '\n'))),                                   \
+             LWJSON_NEON_EQ(x, '\f'))
+    blk->quote = LWJSON_NEON_MASK(LWJSON_NEON_QUOTE);
+    blk->bslash = LWJSON_NEON_MASK(LWJSON_NEON_BSLASH);
+    blk->nul = LWJSON_NEON_MASK(LWJSON_NEON_NUL);
+    blk->blank = LWJSON_NEON_MASK(LWJSON_NEON_BLANK);
+#undef LWJSON_NEON_BLANK
+#undef LWJSON_NEON_NUL
+#undef LWJSON_NEON_BSLASH
+#undef LWJSON_NEON_QUOTE
+#undef LWJSON_NEON_EQ
+#undef LWJSON_NEON_MASK
+#endif
+}
+
+#endif /* defined(LWJSON_SIMD_BLOCK_SIZE) */
+
+/**
+ * \brief           Check if character is *blank* as per RFC4627
+ * \param[in]       c: Character to check
+ * \return          `1` if blank, `0` otherwise
+ */
+static inline uint8_t
+prv_is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f';
+}
+
+/**
+ * \brief           Find first non-blank character in the input
+ * \param[in]       p: Pointer to first character to check
+ * \param[in]       end: End of input, first character not to be checked
+ * \return          Pointer to first non-blank character or `end` if all are blank
+ */
+static inline const char*
+prv_scan_blank(const char* p, const char* end) {
+#if defined(LWJSON_SIMD_BLOCK_SIZE)
+    /* Most of the time, there is only single or no blank character */
+    if (p < end && !prv_is_blank(*p)) {
+        return p;
+    }
+    for (lwjson_simd_block_t blk; (size_t)(end - p) >= LWJSON_SIMD_BLOCK_SIZE; p += LWJSON_SIMD_BLOCK_SIZE) {
+        prv_simd_classify(p, &blk);
+        if (~blk.blank != 0) {
+            return p + prv_ctz64(~blk.blank);
+        }
+    }
+#endif /* defined(LWJSON_SIMD_BLOCK_SIZE) */
+    for (; p < end && prv_is_blank(*p); ++p) {}
+    return p;
+}
+
+/**
+ * \brief           Find first character in the string that needs special handling,
+ *                  that is one of quote `"`, backslash `\` or `NULL` termination
+ * \param[in]       p: Pointer to first character to check
+ * \param[in]       end: End of input, first character not to be checked
+ * \return          Pointer to first special character or `end` if there is none
+ */
+static inline const char*
+prv_scan_string(const char* p, const char* end) {
+#if defined(LWJSON_SIMD_BLOCK_SIZE)
+    for (lwjson_simd_block_t blk; (size_t)(end - p) >= LWJSON_SIMD_BLOCK_SIZE; p += LWJSON_SIMD_BLOCK_SIZE) {
+        uint64_t special;
+
+        prv_simd_classify(p, &blk);
+        special = blk.quote | blk.bslash | blk.nul;
+        if (special != 0) {
+            return p + prv_ctz64(special);
+        }
+    }
+#endif /* defined(LWJSON_SIMD_BLOCK_SIZE) */
+    for (; p < end && *p != '"' && *p != '\\' && *p != '\0'; ++p) {}
+    return p;
+}
+
+/**
+ * \brief           Find first non-blank character in the padded input.
+ * `NULL` termination at the end of data is the only end-of-input check
+ * \param[in]       p: Pointer to first character to check
+ * \return          Pointer to first non-blank character
+ */
+static inline const char*
+prv_scan_blank_padded(const char* p) {
+#if defined(LWJSON_SIMD_BLOCK_SIZE)
+    if (!prv_is_blank(*p)) {
+        return p;
+    }
+    for (lwjson_simd_block_t blk;; p += LWJSON_SIMD_BLOCK_SIZE) {
+        prv_simd_classify(p, &blk);
+        if (~blk.blank != 0) {
+            return p + prv_ctz64(~blk.blank);
+        }
+    }
+#else
+    for (; prv_is_blank(*p); ++p) {}
+    return p;
+#endif /* defined(LWJSON_SIMD_BLOCK_SIZE) */
+}
+
+/**
+ * \brief           Find first character in the padded input string that needs special handling.
+ * `NULL` termination at the end of data is the only end-of-input check
+ * \param[in]       p: Pointer to first character to check
+ * \return          Pointer to first quote `"`, backslash `\` or `NULL` termination
+ */
+static inline const char*
+prv_scan_string_padded(const char* p) {
+#if defined(LWJSON_SIMD_BLOCK_SIZE)
+    for (lwjson_simd_block_t blk;; p += LWJSON_SIMD_BLOCK_SIZE) {
+        uint64_t special;
+
+        prv_simd_classify(p, &blk);
+        special = blk.quote | blk.bslash | blk.nul;
+        if (special != 0) {
+            return p + prv_ctz64(special);
+        }
+    }
+#else
+    for (; *p != '"' && *p != '\\' && *p != '\0'; ++p) {}
+    return p;
+#endif /* defined(LWJSON_SIMD_BLOCK_SIZE) */
+}
+
+#if LWJSON_CFG_ALLOC
+
+/**
+ * \brief           Get token from dynamically allocated blocks
+ *
+ * Blocks allocated during previous parse calls are reused first,
+ * new block is allocated and appended to the list when all are used
+ *
+ * \param[in]       lwobj: LwJSON instance
+ * \return          Pointer to new token, `NULL` if memory cannot be allocated
+ */
+static lwjson_token_t*
+prv_alloc_block_token(lwjson_t* lwobj) {
+    if (lwobj->block == NULL || lwobj->block_pos >= lwobj->block->tokens_len) {
+        lwjson_token_block_t** next = lwobj->block == NULL ? &lwobj->blocks : &lwobj->block->next;
+
+        if (*next == NULL) {
+            size_t len = lwobj->next_free_token_pos;
+
+            /* Grow geometrically, new block is as large as all available tokens so far */
+            if (len < LWJSON_CFG_ALLOC_BLOCK_TOKENS) {
+                len = LWJSON_CFG_ALLOC_BLOCK_TOKENS;
+            }
+            *next = LWJSON_MALLOC(sizeof(**next) + len * sizeof(lwjson_token_t));
+            if (*next == NULL) {
+                return NULL;
+            }
+            (*next)->next = NULL;
+            (*next)->tokens_len = len;
+        }
+        lwobj->block = *next;
+        lwobj->block_pos = 0;
+    }
+    return &lwobj->block->tokens[lwobj->block_pos++];
+}
+
+#endif /* LWJSON_CFG_ALLOC */
+
 /**
  * \brief           Allocate new token for JSON block
  * \param[in]       lwobj: LwJSON instance
@@ -50,11 +440,127 @@ typedef struct {
  */
 static lwjson_token_t*
 prv_alloc_token(lwjson_t* lwobj) {
+    lwjson_token_t* t = NULL;
+
     if (lwobj->next_free_token_pos < lwobj->tokens_len) {
-        LWJSON_MEMSET(&lwobj->tokens[lwobj->next_free_token_pos], 0x00, sizeof(*lwobj->tokens));
-        return &lwobj->tokens[lwobj->next_free_token_pos++];
+        t = &lwobj->tokens[lwobj->next_free_token_pos];
     }
-    return NULL;
+#if LWJSON_CFG_ALLOC
+    else {
+        t = prv_alloc_block_token(lwobj);
+    }
+#endif /* LWJSON_CFG_ALLOC */
+    if (t != NULL) {
+        LWJSON_MEMSET(t, 0x00, sizeof(*t));
+        ++lwobj->next_free_token_pos;
+    }
+    return t;
+}
+
+/**
+ * \brief           Set name of the token
+ * \param[in]       pobj: Input string object the name belongs to
+ * \param[out]      t: Token to set name to
+ * \param[in]       name: Pointer to the beginning of the name
+ * \param[in]       name_len: Length of the name in units of bytes
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static inline lwjsonr_t
+prv_token_set_name(const lwjson_int_str_t* pobj, lwjson_token_t* t, const char* name, size_t name_len) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (name_len >= ((size_t)1 << 24)) {
+        return lwjsonERRMEM;
+    }
+    t->token_name = (uint32_t)(name - pobj->start);
+    t->token_name_len = (uint32_t)name_len;
+    t->has_name = 1;
+#else
+    (void)pobj;
+    t->token_name = name;
+    t->token_name_len = name_len;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Set string value of the token
+ * \param[in]       pobj: Input string object the string belongs to
+ * \param[out]      t: Token to set string value to
+ * \param[in]       str: Pointer to the beginning of the string
+ * \param[in]       str_len: Length of the string in units of bytes
+ */
+static inline void
+prv_token_set_string(const lwjson_int_str_t* pobj, lwjson_token_t* t, const char* str, size_t str_len) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    t->u.str.token_value = (uint32_t)(str - pobj->start);
+    t->u.str.token_value_len = (uint32_t)str_len;
+#else
+    (void)pobj;
+    t->u.str.token_value = str;
+    t->u.str.token_value_len = str_len;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+}
+
+/**
+ * \brief           Append token to the list of children of object or array
+ * \param[in,out]   parent: Parent object or array token
+ * \param[in,out]   tail: Current last child of the parent or `NULL` if parent has no children yet
+ * \param[in]       t: Token to append. Tokens are appended in the order of allocation
+ */
+static inline void
+prv_token_append(lwjson_token_t* parent, lwjson_token_t* tail, lwjson_token_t* t) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    /* First child is always the next token after parent */
+    (void)parent;
+    (void)t;
+    if (tail != NULL) {
+        tail->has_next = 1;
+    }
+#else
+    if (tail == NULL) {
+        parent->u.cont.first_child = t;
+    } else {
+        tail->next = t;
+    }
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+}
+
+/**
+ * \brief           Save parent of object or array token, that is being opened for parsing
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in,out]   t: Object or array token
+ * \param[in]       parent: Parent token
+ */
+static inline void
+prv_token_open(lwjson_t* lwobj, lwjson_token_t* t, lwjson_token_t* parent) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    t->u.cont.parent = (uint32_t)(parent - lwobj->tokens) + 1;
+#else
+    t->next = parent; /* Temporary saved as parent object */
+    t->u.cont.child_tokens = lwobj->next_free_token_pos; /* Temporary saved as number of tokens before subtree */
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+}
+
+/**
+ * \brief           Finish parsing of object or array token
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in,out]   t: Object or array token to close
+ * \return          Parent token or `NULL` if token is the root
+ */
+static inline lwjson_token_t*
+prv_token_close(lwjson_t* lwobj, lwjson_token_t* t) {
+    lwjson_token_t* parent;
+
+#if LWJSON_CFG_COMPACT_TOKENS
+    parent = t->u.cont.parent > 0 ? &lwobj->tokens[t->u.cont.parent - 1] : NULL;
+    t->u.cont.parent = 0;
+    t->u.cont.child_tokens = (uint32_t)(lwobj->next_free_token_pos - (size_t)(t - lwobj->tokens) - 1);
+#else
+    parent = t->next;
+    t->next = NULL;
+    t->u.cont.child_tokens = lwobj->next_free_token_pos - t->u.cont.child_tokens;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    return parent;
 }
 
 /**
@@ -63,10 +569,12 @@ prv_alloc_token(lwjson_t* lwobj) {
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 static lwjsonr_t
-prv_skip_blank(lwjson_int_str_t* pobj) {
-    while (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
-        if (*pobj->p == ' ' || *pobj->p == '\t' || *pobj->p == '\r' || *pobj->p == '\n' || *pobj->p == '\f') {
-            ++pobj->p;
+prv_skip_blank_run(lwjson_int_str_t* pobj) {
+    const char* end = pobj->start + pobj->len;
+
+    while (pobj->p != NULL && *pobj->p != '\0' && pobj->p < end) {
+        if (prv_is_blank(*pobj->p)) {
+            pobj->p = pobj->padded ? prv_scan_blank_padded(pobj->p + 1) : prv_scan_blank(pobj->p + 1, end);
 #if LWJSON_CFG_COMMENTS
             /* Check for comments and remove them */
         } else if (*pobj->p == '/') {
@@ -95,9 +603,305 @@ prv_skip_blank(lwjson_int_str_t* pobj) {
     return lwjsonERRJSON;
 }
 
+/**
+ * \brief           Skip all characters that are considered *blank* as per RFC4627
+ *
+ * Values are mostly followed by separator without any blank characters,
+ * that is checked without a function call.
+ *
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static inline lwjsonr_t
+prv_skip_blank(lwjson_int_str_t* pobj) {
+    /* All blank characters and `NULL` termination are below or equal to space character */
+    if (pobj->p != NULL && (size_t)(pobj->p - pobj->start) < pobj->len && (uint8_t)*pobj->p > ' '
+#if LWJSON_CFG_COMMENTS
+        && *pobj->p != '/'
+#endif /* LWJSON_CFG_COMMENTS */
+    ) {
+        return lwjsonOK;
+    }
+    return prv_skip_blank_run(pobj);
+}
+
+#if LWJSON_CFG_VALIDATE_UTF8
+
+#if defined(LWJSON_UTF8_SIMD)
+
+#if defined(LWJSON_SIMD_NEON)
+typedef uint8x16_t lwjson_u8x16_t;
+#define LWJSON_V_LOAD(p)         vld1q_u8((const uint8_t*)(p))
+#define LWJSON_V_ZERO()          vdupq_n_u8(0)
+#define LWJSON_V_AND(a, b)       vandq_u8((a), (b))
+#define LWJSON_V_OR(a, b)        vorrq_u8((a), (b))
+#define LWJSON_V_XOR(a, b)       veorq_u8((a), (b))
+#define LWJSON_V_SET1(c)         vdupq_n_u8(c)
+#define LWJSON_V_SUBS(a, c)      vqsubq_u8((a), vdupq_n_u8(c))
+#define LWJSON_V_SHR4(a)         vshrq_n_u8((a), 4)
+#define LWJSON_V_LOOKUP(tbl, a)  vqtbl1q_u8(vld1q_u8(tbl), (a))
+#define LWJSON_V_PREV(a, prev, n) vextq_u8((prev), (a), 16 - (n))
+#define LWJSON_V_HAS_HIGH(a)     (vmaxvq_u8(a) >= 0x80)
+#define LWJSON_V_NONZERO(a)      (vmaxvq_u8(a) != 0)
+#else
+typedef __m128i lwjson_u8x16_t;
+#define LWJSON_V_LOAD(p)          _mm_loadu_si128((const __m128i*)(const void*)(p))
+#define LWJSON_V_ZERO()           _mm_setzero_si128()
+#define LWJSON_V_AND(a, b)        _mm_and_si128((a), (b))
+#define LWJSON_V_OR(a, b)         _mm_or_si128((a), (b))
+#define LWJSON_V_XOR(a, b)        _mm_xor_si128((a), (b))
+#define LWJSON_V_SET1(c)          _mm_set1_epi8((char)(c))
+#define LWJSON_V_SUBS(a, c)       _mm_subs_epu8((a), _mm_set1_epi8((char)(c)))
+#define LWJSON_V_SHR4(a)          _mm_and_si128(_mm_srli_epi16((a), 4), _mm_set1_epi8(0x0F))
+#define LWJSON_V_LOOKUP(tbl, a)   _mm_shuffle_epi8(LWJSON_V_LOAD(tbl), (a))
+#define LWJSON_V_PREV(a, prev, n) _mm_alignr_epi8((a), (prev), 16 - (n))
+#define LWJSON_V_HAS_HIGH(a)      (_mm_movemask_epi8(a) != 0)
+#define LWJSON_V_NONZERO(a)       (_mm_movemask_epi8(_mm_cmpeq_epi8((a), _mm_setzero_si128())) != 0xFFFF)
+#endif /* defined(LWJSON_SIMD_NEON) */
+
+/* Error classes of 2-byte sequences, looked up by high and low nibble of first byte and high nibble of second byte */
+#define LWJSON_U8_TOO_SHORT  0x01 /*!< Lead byte not followed by continuation byte */
+#define LWJSON_U8_TOO_LONG   0x02 /*!< ASCII byte followed by continuation byte */
+#define LWJSON_U8_OVERLONG_3 0x04 /*!< `E0` followed by `80..9F` */
+#define LWJSON_U8_TOO_LARGE  0x08 /*!< Code point above `10FFFF` */
+#define LWJSON_U8_SURROGATE  0x10 /*!< `ED` followed by `A0..BF` */
+#define LWJSON_U8_OVERLONG_2 0x20 /*!< `C0` or `C1` lead byte */
+#define LWJSON_U8_TOO_LARGE2 0x40 /*!< `F5..FF` or overlong `F0`, followed by `80..8F` */
+#define LWJSON_U8_TWO_CONTS  0x80 /*!< Two continuation bytes, only valid after 3 or 4 byte lead */
+#define LWJSON_U8_CARRY      (LWJSON_U8_TOO_SHORT | LWJSON_U8_TOO_LONG | LWJSON_U8_TWO_CONTS)
+
+static const uint8_t prv_utf8_byte1_high[16] = {
+    LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,
+    LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,  LWJSON_U8_TOO_LONG,
+    LWJSON_U8_TWO_CONTS, LWJSON_U8_TWO_CONTS, LWJSON_U8_TWO_CONTS, LWJSON_U8_TWO_CONTS,
+    LWJSON_U8_TOO_SHORT | LWJSON_U8_OVERLONG_2,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT | LWJSON_U8_OVERLONG_3 | LWJSON_U8_SURROGATE,
+    LWJSON_U8_TOO_SHORT | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+};
+static const uint8_t prv_utf8_byte1_low[16] = {
+    LWJSON_U8_CARRY | LWJSON_U8_OVERLONG_3 | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_OVERLONG_2,
+    LWJSON_U8_CARRY,
+    LWJSON_U8_CARRY,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2 | LWJSON_U8_SURROGATE,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+};
+static const uint8_t prv_utf8_byte2_high[16] = {
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_OVERLONG_3 | LWJSON_U8_TOO_LARGE2,
+    LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_OVERLONG_3 | LWJSON_U8_TOO_LARGE,
+    LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_SURROGATE | LWJSON_U8_TOO_LARGE,
+    LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_SURROGATE | LWJSON_U8_TOO_LARGE,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+    LWJSON_U8_TOO_SHORT,
+};
+
+/**
+ * \brief           Check one block of `16` bytes for invalid UTF-8 sequences
+ *
+ * Every pair of consecutive bytes is classified with `3` table lookups,
+ * then continuation bytes are checked against expected length of `3` and `4` byte sequences.
+ *
+ * \param[in]       in: Input block
+ * \param[in]       prev: Previous input block, or zeros at the beginning
+ * \return          Non-zero bytes on error
+ */
+static inline lwjson_u8x16_t
+prv_utf8_check_block(lwjson_u8x16_t in, lwjson_u8x16_t prev) {
+    const lwjson_u8x16_t prev1 = LWJSON_V_PREV(in, prev, 1);
+    const lwjson_u8x16_t prev2 = LWJSON_V_PREV(in, prev, 2);
+    const lwjson_u8x16_t prev3 = LWJSON_V_PREV(in, prev, 3);
+    lwjson_u8x16_t sc, must23;
+
+    sc = LWJSON_V_AND(LWJSON_V_LOOKUP(prv_utf8_byte1_high, LWJSON_V_SHR4(prev1)),
+                      LWJSON_V_LOOKUP(prv_utf8_byte1_low, LWJSON_V_AND(prev1, LWJSON_V_SET1(0x0F))));
+    sc = LWJSON_V_AND(sc, LWJSON_V_LOOKUP(prv_utf8_byte2_high, LWJSON_V_SHR4(in)));
+
+    /* High bit is set where byte must be 2nd continuation of 3 or 4 byte sequence */
+    must23 = LWJSON_V_OR(LWJSON_V_SUBS(prev2, 0xE0 - 0x80), LWJSON_V_SUBS(prev3, 0xF0 - 0x80));
+    return LWJSON_V_XOR(LWJSON_V_AND(must23, LWJSON_V_SET1(0x80)), sc);
+}
+
+#endif /* defined(LWJSON_UTF8_SIMD) */
+
+/**
+ * \brief           Check if bytes form valid UTF-8 text
+ *
+ * ASCII text is skipped `8` or `16` bytes at a time,
+ * multi-byte sequences are checked with SIMD lookup kernel or scalar decoder.
+ *
+ * \param[in]       p: Pointer to first byte to check
+ * \param[in]       end: Pointer to first byte after the text
+ * \return          `1` if valid, `0` otherwise
+ */
+static inline uint8_t
+prv_utf8_validate(const char* p, const char* end) {
+#if defined(LWJSON_UTF8_SIMD)
+    lwjson_u8x16_t in, prev, err;
+    uint8_t tail[16];
+
+    /* Skip ASCII text, until first block with non-ASCII character */
+    for (; end - p >= 16; p += 16) {
+        if (LWJSON_V_HAS_HIGH(LWJSON_V_LOAD(p))) {
+            break;
+        }
+    }
+    if (end - p < 16) {
+        const char* t = p;
+        uint64_t v = 0;
+
+        if (end - t >= 8) {
+            LWJSON_MEMCPY(&v, t, sizeof(v));
+            t += 8;
+        }
+        for (; t < end && (uint8_t)*t < 0x80; ++t) {}
+        if (t == end && (v & 0x8080808080808080ULL) == 0) {
+            return 1;
+        }
+    }
+    prev = err = LWJSON_V_ZERO();
+    for (; end - p >= 16; p += 16) {
+        in = LWJSON_V_LOAD(p);
+        err = LWJSON_V_OR(err, prv_utf8_check_block(in, prev));
+        prev = in;
+    }
+
+    /* Last bytes are padded with zeros, that also detect incomplete sequence at the end */
+    LWJSON_MEMSET(tail, 0x00, sizeof(tail));
+    LWJSON_MEMCPY(tail, p, (size_t)(end - p));
+    in = LWJSON_V_LOAD(tail);
+    err = LWJSON_V_OR(err, prv_utf8_check_block(in, prev));
+    return !LWJSON_V_NONZERO(err);
+#else
+    const uint8_t* s = (const uint8_t*)p;
+    const uint8_t* e = (const uint8_t*)end;
+
+    while (s < e) {
+        uint8_t lo = 0x80, hi = 0xBF;
+        size_t n;
+
+        /* Skip ASCII characters, 8 at a time */
+        for (uint64_t v; e - s >= 8; s += 8) {
+            LWJSON_MEMCPY(&v, s, sizeof(v));
+            if ((v & 0x8080808080808080ULL) != 0) {
+                break;
+            }
+        }
+        if (s >= e) {
+            break;
+        }
+        if (*s < 0x80) {
+            ++s;
+            continue;
+        }
+
+        /* Length of sequence and valid range of the second byte depend on lead byte */
+        if (*s >= 0xC2 && *s <= 0xDF) {
+            n = 1;
+        } else if (*s >= 0xE0 && *s <= 0xEF) {
+            n = 2;
+            lo = *s == 0xE0 ? 0xA0 : 0x80;
+            hi = *s == 0xED ? 0x9F : 0xBF;
+        } else if (*s >= 0xF0 && *s <= 0xF4) {
+            n = 3;
+            lo = *s == 0xF0 ? 0x90 : 0x80;
+            hi = *s == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return 0;
+        }
+        if ((size_t)(e - s) <= n || s[1] < lo || s[1] > hi) {
+            return 0;
+        }
+        for (size_t i = 2; i <= n; ++i) {
+            if (s[i] < 0x80 || s[i] > 0xBF) {
+                return 0;
+            }
+        }
+        s += n + 1;
+    }
+    return 1;
+#endif /* defined(LWJSON_UTF8_SIMD) */
+}
+
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
+/**
+ * \brief           Parse `4` hexadecimal characters of `\uXXXX` escape sequence
+ * \param[in]       p: Pointer to first hexadecimal character
+ * \param[out]      cp: Output variable for decoded code unit
+ * \return          `1` on success, `0` if any character is not hexadecimal
+ */
+static inline uint8_t
+prv_parse_hex4(const char* p, uint32_t* cp) {
+    uint32_t val = 0;
+
+    for (size_t i = 0; i < 4; ++i, ++p) {
+        if (*p >= '0' && *p <= '9') {
+            val = (val << 4) | (uint32_t)(*p - '0');
+        } else if (*p >= 'a' && *p <= 'f') {
+            val = (val << 4) | (uint32_t)(*p - 'a' + 10);
+        } else if (*p >= 'A' && *p <= 'F') {
+            val = (val << 4) | (uint32_t)(*p - 'A' + 10);
+        } else {
+            return 0;
+        }
+    }
+    *cp = val;
+    return 1;
+}
+
+/**
+ * \brief           Write unicode code point in UTF-8 encoding
+ * \param[in]       w: Pointer to write position
+ * \param[in]       cp: Code point to write
+ * \return          Pointer to first character after written sequence
+ */
+static inline char*
+prv_write_utf8(char* w, uint32_t cp) {
+    if (cp < 0x80) {
+        *w++ = (char)cp;
+    } else if (cp < 0x800) {
+        *w++ = (char)(0xC0 | (cp >> 6));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *w++ = (char)(0xE0 | (cp >> 12));
+        *w++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *w++ = (char)(0xF0 | (cp >> 18));
+        *w++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *w++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return w;
+}
+
 /**
  * \brief           Parse JSON string that must start end end with double quotes `"` character
- * It just parses length of characters and does not perform any decode operation
+ *
+ * By default it just parses length of characters and does not perform any decode operation.
+ * For in-situ input, escape sequences are decoded in place, as decoded text is never longer than the original.
+ *
  * \param[in,out]   pobj: Pointer to text that is modified on success
  * \param[out]      pout: Pointer to pointer to string that is set where string starts
  * \param[out]      poutlen: Length of string in units of characters is stored here
@@ -106,7 +910,9 @@ prv_skip_blank(lwjson_int_str_t* pobj) {
 static lwjsonr_t
 prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
     lwjsonr_t res;
-    size_t len = 0;
+    const char* end = pobj->start + pobj->len;
+    const char* run;
+    char* w = NULL; /* Write pointer for in-situ decoding, set at first escape sequence */
 
     res = prv_skip_blank(pobj);
     if (res != lwjsonOK) {
@@ -117,62 +923,90 @@ prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
     }
     *pout = pobj->p;
     /* Parse string but take care of escape characters */
-    for (;; ++pobj->p, ++len) {
-        if (pobj->p == NULL || *pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
+    for (;; ++pobj->p) {
+        /* Jump directly to the next character that is not regular string content */
+        run = pobj->p;
+        pobj->p = pobj->padded ? prv_scan_string_padded(pobj->p) : prv_scan_string(pobj->p, end);
+        if (pobj->p >= end || *pobj->p == '\0') {
             return lwjsonERRJSON;
         }
+#if LWJSON_CFG_VALIDATE_UTF8
+        if (!prv_utf8_validate(run, pobj->p)) {
+            return lwjsonERRUTF8;
+        }
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+        /* Move regular content after already decoded characters */
+        if (w != NULL) {
+            LWJSON_MEMMOVE(w, run, (size_t)(pobj->p - run));
+            w += pobj->p - run;
+        }
         /* Check special characters */
         if (*pobj->p == '\\') {
-            ++pobj->p;
-            ++len;
+            char ch = 0;
+
+            if (pobj->insitu && w == NULL) {
+                w = (char*)pobj->p;
+            }
+            if (++pobj->p >= end) {
+                return lwjsonERRJSON;
+            }
             switch (*pobj->p) {
                 case '"':  /* fallthrough */
                 case '\\': /* fallthrough */
-                case '/':  /* fallthrough */
-                case 'b':  /* fallthrough */
-                case 'f':  /* fallthrough */
-                case 'n':  /* fallthrough */
-                case 'r':  /* fallthrough */
-                case 't': break;
-                case 'u':
-                    ++pobj->p;
-                    for (size_t i = 0; i < 4; ++i, ++len) {
-                        if (!((*pobj->p >= '0' && *pobj->p <= '9') || (*pobj->p >= 'a' && *pobj->p <= 'f')
-                              || (*pobj->p >= 'A' && *pobj->p <= 'F'))) {
+                case '/': ch = *pobj->p; break;
+                case 'b': ch = '\b'; break;
+                case 'f': ch = '\f'; break;
+                case 'n': ch = '\n'; break;
+                case 'r': ch = '\r'; break;
+                case 't': ch = '\t'; break;
+                case 'u': {
+                    uint32_t cp, low;
+
+                    if ((size_t)(end - pobj->p) <= 4 || !prv_parse_hex4(pobj->p + 1, &cp)) {
+                        return lwjsonERRJSON;
+                    }
+                    pobj->p += 4;
+                    if (w == NULL) {
+                        break;
+                    }
+
+                    /* High surrogate must be followed by low surrogate, they encode single code point */
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        if ((size_t)(end - pobj->p) <= 6 || pobj->p[1] != '\\' || pobj->p[2] != 'u'
+                            || !prv_parse_hex4(pobj->p + 3, &low) || low < 0xDC00 || low > 0xDFFF) {
                             return lwjsonERRJSON;
                         }
-                        if (i < 3) {
-                            ++pobj->p;
-                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        pobj->p += 6;
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return lwjsonERRJSON;
                     }
+                    w = prv_write_utf8(w, cp);
                     break;
+                }
                 default: return lwjsonERRJSON;
             }
-        } else if (*pobj->p == '"') {
-            ++pobj->p;
+            if (w != NULL && ch != 0) {
+                *w++ = ch;
+            }
+        } else { /* Closing quote character */
             break;
         }
     }
-    *poutlen = len;
+    *poutlen = (size_t)((w != NULL ? (const char*)w : pobj->p) - *pout);
+    ++pobj->p;
     return res;
 }
 
 /**
- * \brief           Parse property name that must comply with JSON string format as in RFC4627
- * Property string must be followed by colon character ":"
- * \param[in,out]   pobj: Pointer to text that is modified on success
- * \param[out]      t: Token instance to write property name to
+ * \brief           Parse colon character ":" after property name, together with blanks around it
+ * \param[in,out]   pobj: Pointer to text, set after closing quote of the name. Modified on success
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
-static lwjsonr_t
-prv_parse_property_name(lwjson_int_str_t* pobj, lwjson_token_t* t) {
+static inline lwjsonr_t
+prv_parse_name_separator(lwjson_int_str_t* pobj) {
     lwjsonr_t res;
 
-    /* Parse property string first */
-    res = prv_parse_string(pobj, &t->token_name, &t->token_name_len);
-    if (res != lwjsonOK) {
-        return res;
-    }
     /* Skip any spaces */
     res = prv_skip_blank(pobj);
     if (res != lwjsonOK) {
@@ -183,570 +1017,4815 @@ prv_parse_property_name(lwjson_int_str_t* pobj, lwjson_token_t* t) {
         return lwjsonERRJSON;
     }
     /* Skip any spaces */
-    res = prv_skip_blank(pobj);
+    return prv_skip_blank(pobj);
+}
+
+/**
+ * \brief           Parse property name that must comply with JSON string format as in RFC4627
+ * Property string must be followed by colon character ":"
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[out]      name: Output variable for name pointer
+ * \param[out]      name_len: Output variable for name length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_property_name(lwjson_int_str_t* pobj, const char** name, size_t* name_len) {
+    lwjsonr_t res;
+
+    /* Parse property string first */
+    res = prv_parse_string(pobj, name, name_len);
     if (res != lwjsonOK) {
         return res;
     }
-    return lwjsonOK;
+    return prv_parse_name_separator(pobj);
 }
 
+/* Number of decimal digits, that always fit into 64-bit unsigned integer */
+#define LWJSON_NUM_MAX_DIGITS 19
+
+/* Number of decimal digits, that always fit into integer type */
+#define LWJSON_INT_SAFE_DIGITS (sizeof(lwjson_int_t) >= 8 ? 18 : (sizeof(lwjson_int_t) >= 4 ? 9 : 4))
+
+/* SWAR number parsing loads 8 digits at a time in little-endian order */
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_X64) || defined(_M_IX86)     \
+    || defined(_M_ARM64)
+#define LWJSON_NUM_SWAR 1
+#endif
+
+#if defined(LWJSON_NUM_SWAR)
+
 /**
- * \brief           Calculate new value for exponent 10^exponent.
- * \param[in]       exp: Exponent.
- * \param[in]       is_minus: Indicates whether the exponent is negative.
- * \return          Value of 10^exponent.
+ * \brief           Check if all 8 characters are decimal digits
+ * \param[in]       v: 8 characters loaded in little-endian order
+ * \return          `1` if all are digits, `0` otherwise
  */
-static lwjson_real_t prv_power10(lwjson_int_t exp, uint8_t is_minus)
-{
-    lwjson_real_t result = (lwjson_real_t)1;
-    lwjson_real_t base = (lwjson_real_t)10;
+static inline uint8_t
+prv_is_8digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+           == 0x3333333333333333ULL;
+}
 
-    for (;exp > 0; base *= base, exp >>= 1) {
-        if ((exp & 1) == 1) {
-            result *= base;
+/**
+ * \brief           Convert 8 decimal digits to integer in 3 multiplications
+ * \param[in]       v: 8 digit characters loaded in little-endian order
+ * \return          Value of the digits, first character is most significant
+ */
+static inline uint32_t
+prv_parse_8digits(uint64_t v) {
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+         + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))))
+        >> 32;
+    return (uint32_t)v;
+}
+
+#endif /* defined(LWJSON_NUM_SWAR) */
+
+/**
+ * \brief           Parse sequence of decimal digits into 64-bit mantissa
+ *
+ * Mantissa silently wraps around when there are more than \ref LWJSON_NUM_MAX_DIGITS digits,
+ * caller must check number of parsed digits.
+ *
+ * \param[in]       pobj: JSON string, used to check how many bytes are readable
+ * \param[in]       p: Pointer to first character to check
+ * \param[in,out]   mantissa: Mantissa to add digits to
+ * \return          Pointer to first non-digit character
+ */
+static inline const char*
+prv_parse_digits(const lwjson_int_str_t* pobj, const char* p, uint64_t* mantissa) {
+    uint64_t m = *mantissa;
+    const char* first = p;
+
+    /* Typical numbers are short, scalar loop is faster for them */
+    for (; *p >= '0' && *p <= '9' && p - first < 8; ++p) {
+        m = m * 10 + (uint64_t)(*p - '0');
+    }
+#if defined(LWJSON_NUM_SWAR)
+    /* Continue with 8 digits at a time, when they are guaranteed to be readable */
+    if (p - first == 8) {
+        const char* end = pobj->start + pobj->len;
+        for (uint64_t v; pobj->padded ? LWJSON_CFG_PADDING_LEN >= 8 : (end - p) >= 8; p += 8) {
+            LWJSON_MEMCPY(&v, p, sizeof(v));
+            if (!prv_is_8digits(v)) {
+                break;
+            }
+            m = m * 100000000ULL + prv_parse_8digits(v);
         }
     }
+#else
+    (void)pobj;
+#endif /* defined(LWJSON_NUM_SWAR) */
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        m = m * 10 + (uint64_t)(*p - '0');
+    }
+    *mantissa = m;
+    return p;
+}
 
-    return is_minus ? ((lwjson_real_t)1 / result) : result;
+/**
+ * \brief           Parse mantissa of number with more than \ref LWJSON_NUM_MAX_DIGITS digits
+ *
+ * First \ref LWJSON_NUM_MAX_DIGITS significant digits are kept in the mantissa,
+ * remaining digits only increase the exponent.
+ *
+ * \param[in]       p: Pointer to first digit of the number
+ * \param[in]       end: Pointer to the end of integer and fraction part
+ * \param[out]      mantissa: Output variable for mantissa
+ * \param[out]      truncated: Set to `1` if any non-zero digit was dropped
+ * \return          Number of digits dropped from the integer part,
+ *                  minus number of digits kept from the fraction part
+ */
+static int32_t
+prv_parse_long_mantissa(const char* p, const char* end, uint64_t* mantissa, uint8_t* truncated) {
+    uint64_t m = 0;
+    size_t ndigits = 0;
+    int32_t exp10 = 0;
+    uint8_t in_fraction = 0;
+
+    for (; p < end; ++p) {
+        if (*p == '.') {
+            in_fraction = 1;
+        } else if (ndigits < LWJSON_NUM_MAX_DIGITS) {
+            m = m * 10 + (uint64_t)(*p - '0');
+            ndigits += m > 0; /* Leading zeros are not significant */
+            exp10 -= in_fraction;
+        } else {
+            *truncated |= *p != '0';
+            exp10 += !in_fraction;
+        }
+    }
+    *mantissa = m;
+    return exp10;
 }
 
 /**
- * \brief           Parse number as described in RFC4627
- * \param[in,out]   pobj: Pointer to text that is modified on success
- * \param[out]      tout: Pointer to output number format
- * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
- * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Parse exponent part of number, saturated as anything above is either `0` or infinity
+ * \param[in]       p: Pointer to first character after `e` or `E` character
+ * \param[in,out]   exp10: Decimal exponent to add parsed exponent to
+ * \return          Pointer to first character after the exponent, `NULL` if exponent has no digits
  */
-static lwjsonr_t
-prv_parse_number(lwjson_int_str_t* pobj, lwjson_type_t* tout, lwjson_real_t* fout, lwjson_int_t* iout) {
-    lwjsonr_t res;
-    uint8_t is_minus;
-    lwjson_real_t real_num = 0;
-    lwjson_int_t int_num = 0;
-    lwjson_type_t type = LWJSON_TYPE_NUM_INT;
+static const char*
+prv_parse_exponent(const char* p, int32_t* exp10) {
+    uint8_t is_minus_exp;
+    int32_t exp_cnt;
 
-    res = prv_skip_blank(pobj);
-    if (res != lwjsonOK) {
-        return res;
+    is_minus_exp = *p == '-' ? (++p, 1) : 0; /* Check if negative */
+    if (*p == '+') {                         /* Optional '+' is possible too */
+        ++p;
     }
-    if (*pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
-        return lwjsonERRJSON;
+    if (*p < '0' || *p > '9') { /* Must be followed by number characters */
+        return NULL;
     }
-    is_minus = *pobj->p == '-' ? (++pobj->p, 1) : 0;
-    if (*pobj->p == '\0'                    /* Invalid string */
-        || *pobj->p < '0' || *pobj->p > '9' /* Character outside number range */
-        || (*pobj->p == '0'
-            && (pobj->p[1] < '0' && pobj->p[1] > '9'))) { /* Number starts with 0 but not followed by dot */
-        return lwjsonERRJSON;
+    for (exp_cnt = 0; *p >= '0' && *p <= '9'; ++p) {
+        if (exp_cnt < 100000) {
+            exp_cnt = exp_cnt * 10 + (int32_t)(*p - '0');
+        }
     }
+    *exp10 += is_minus_exp ? -exp_cnt : exp_cnt;
+    return p;
+}
 
-    /* Parse number */
-    for (int_num = 0; *pobj->p >= '0' && *pobj->p <= '9'; ++pobj->p) {
-        int_num = int_num * (lwjson_int_t)10 + (*pobj->p - '0');
-    }
+#if LWJSON_CFG_REAL_CORRECT_ROUNDING
 
-    real_num = (lwjson_real_t)int_num;
+/* Range of decimal exponents in power of 10 table */
+#define LWJSON_POW10_MIN_EXP (-342)
+#define LWJSON_POW10_MAX_EXP 308
 
-    if (pobj->p != NULL && *pobj->p == '.') { /* Number has exponent */
-        lwjson_real_t exp;
-        lwjson_int_t dec_num;
+/**
+ * \brief           128-bit normalized mantissas of powers of 10, rounded down
+ *
+ * Entry at index `i` is `{high, low}` 64-bit part of `10^(i - 342)`,
+ * shifted so that most significant bit is set
+ */
+static const uint64_t prv_pow10_128[][2] = {
+    {0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL}, {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+    {0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL}, {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+    {0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL}, {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+    {0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL}, {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+    {0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL}, {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+    {0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL}, {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+    {0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL}, {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+    {0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL}, {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+    {0x84A57695FE98746DULL, 0x014BB630F7604B57ULL}, {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+    {0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL}, {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+    {0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL}, {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+    {0xFD00B897478238D0ULL, 0x8920B098955522B4ULL}, {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+    {0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL}, {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+    {0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL}, {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+    {0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL}, {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+    {0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL}, {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+    {0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL}, {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+    {0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL}, {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+    {0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL}, {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+    {0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL}, {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+    {0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL}, {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+    {0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL}, {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+    {0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL}, {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+    {0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL}, {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+    {0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL}, {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+    {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+    {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+    {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+    {0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+    {0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+    {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+    {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+    {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+    {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+    {0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+    {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+    {0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+    {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+    {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+    {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+    {0xC987434744AC874EULL, 0xA327FFB266B56220ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+    {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+    {0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+    {0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+    {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+    {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+    {0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+    {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+    {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+    {0xAECC49914078536DULL, 0x58FAE9F773886E18ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+    {0x888F99797A5E012DULL, 0x6D8406C952429603ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+    {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+    {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+    {0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+    {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+    {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+    {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+    {0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+    {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+    {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+    {0xB913179899F68584ULL, 0x28E2557B59846E3FULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+    {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+    {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+    {0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+    {0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+    {0xD77485CB25823AC7ULL, 0x7D633293366B828BULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+    {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+    {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+    {0xCD795BE870516656ULL, 0x67902E276C921F8BULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+    {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+    {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+    {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+    {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+    {0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+    {0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+    {0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+    {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+    {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+    {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+    {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+    {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL}, {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+    {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+    {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+    {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+    {0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+    {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+    {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+    {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+    {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+    {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+    {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+    {0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+    {0x8C974F7383725573ULL, 0x1E414218C73A13FBULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+    {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+    {0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+    {0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+    {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+    {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+    {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+    {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+    {0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+    {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+    {0xBE89523386091465ULL, 0xF6BBB397F1135823ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+    {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+    {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+    {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+    {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+    {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+    {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+    {0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+    {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+    {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+    {0x811CCC668829B887ULL, 0x0806357D5A3F525FULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+    {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+    {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+    {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+    {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+    {0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+    {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+    {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+    {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+    {0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+    {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+    {0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+    {0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+    {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+    {0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+    {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+    {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+    {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+    {0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+    {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+    {0xED246723473E3813ULL, 0x290123E9AAB23B68ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+    {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+    {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+    {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+    {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+    {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+    {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+    {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+    {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+    {0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+    {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+    {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+    {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+    {0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+    {0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+    {0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+    {0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+    {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+    {0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+    {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+    {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+    {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+    {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+    {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+    {0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+    {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL},
+    {0xC612062576589DDAULL, 0x95364AFE032A819DULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL},
+    {0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL},
+    {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL},
+    {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL},
+    {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL},
+    {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL},
+    {0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL},
+    {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL},
+    {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953030ULL},
+    {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL},
+    {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL},
+    {0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL},
+    {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL},
+    {0x8000000000000000ULL, 0x0000000000000000ULL}, {0xA000000000000000ULL, 0x0000000000000000ULL},
+    {0xC800000000000000ULL, 0x0000000000000000ULL}, {0xFA00000000000000ULL, 0x0000000000000000ULL},
+    {0x9C40000000000000ULL, 0x0000000000000000ULL}, {0xC350000000000000ULL, 0x0000000000000000ULL},
+    {0xF424000000000000ULL, 0x0000000000000000ULL}, {0x9896800000000000ULL, 0x0000000000000000ULL},
+    {0xBEBC200000000000ULL, 0x0000000000000000ULL}, {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+    {0x9502F90000000000ULL, 0x0000000000000000ULL}, {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+    {0xE8D4A51000000000ULL, 0x0000000000000000ULL}, {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+    {0xB5E620F480000000ULL, 0x0000000000000000ULL}, {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+    {0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+    {0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+    {0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+    {0x878678326EAC9000ULL, 0x0000000000000000ULL}, {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+    {0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, {0x84595161401484A0ULL, 0x0000000000000000ULL},
+    {0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+    {0x813F3978F8940984ULL, 0x4000000000000000ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+    {0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+    {0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+    {0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+    {0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+    {0x96769950B50D88F4ULL, 0x1314448000000000ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+    {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+    {0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+    {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+    {0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+    {0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+    {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+    {0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+    {0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+    {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+    {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+    {0x9F4F2726179A2245ULL, 0x01D762422C946590ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+    {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+    {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+    {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+    {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+    {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+    {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+    {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+    {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+    {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+    {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+    {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+    {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+    {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+    {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+    {0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+    {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+    {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+    {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+    {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+    {0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+    {0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+    {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+    {0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+    {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+    {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+    {0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+    {0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+    {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+    {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+    {0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+    {0x9AE757596946075FULL, 0x3375788DE9B06958ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+    {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+    {0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+    {0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+    {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+    {0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+    {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+    {0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+    {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+    {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+    {0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+    {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+    {0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+    {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+    {0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+    {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+    {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+    {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+    {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+    {0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+    {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+    {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+    {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+    {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+    {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+    {0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+    {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+    {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+    {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+    {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+    {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+    {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+    {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+    {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+    {0x8FA475791A569D10ULL, 0xF96E017D694487BCULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+    {0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+    {0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+    {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+    {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+    {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+    {0x82A45B450226B39CULL, 0xECC0024661173473ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+    {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+    {0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+    {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+    {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+    {0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+    {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+    {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+    {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+    {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+    {0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+    {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+    {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+    {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+    {0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+    {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+    {0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+    {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+    {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+    {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+    {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+    {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+    {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+    {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+    {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+    {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+    {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+    {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+    {0x8533285C936B35DEULL, 0xD53A88958F87275FULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+    {0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+    {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+    {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+    {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+    {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+    {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+    {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+    {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+    {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+    {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+    {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+    {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+    {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+    {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+    {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+    {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+    {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+    {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+    {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+    {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+    {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+    {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+    {0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+    {0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+    {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL},
+};
 
-        real_num = (lwjson_real_t)int_num;
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 lwjson_uint128_t;
+#endif /* defined(__SIZEOF_INT128__) */
 
-        type = LWJSON_TYPE_NUM_REAL;            /* Format is real */
-        ++pobj->p;                              /* Ignore comma character */
-        if (*pobj->p < '0' || *pobj->p > '9') { /* Must be followed by number characters */
-            return lwjsonERRJSON;
-        }
+/**
+ * \brief           Multiply two 64-bit unsigned integers to 128-bit result
+ * \param[in]       a: First operand
+ * \param[in]       b: Second operand
+ * \param[out]      lo: Lower 64-bits of the result
+ * \return          Upper 64-bits of the result
+ */
+static inline uint64_t
+prv_mul64(uint64_t a, uint64_t b, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    lwjson_uint128_t r = (lwjson_uint128_t)a * b;
+    *lo = (uint64_t)r;
+    return (uint64_t)(r >> 64);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
 
-        /* Get number after decimal point */
-        for (exp = (lwjson_real_t)1, dec_num = 0; *pobj->p >= '0' && *pobj->p <= '9';
-             ++pobj->p, exp *= (lwjson_real_t)10) {
-            dec_num = dec_num * (lwjson_int_t)10 + (lwjson_int_t)(*pobj->p - '0');
-        }
+    *lo = (mid << 32) | (uint32_t)p0;
+    return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
 
-        /* Add decimal part to number */
-        real_num += (lwjson_real_t)dec_num / exp;
-    }
-    if (pobj->p != NULL && (*pobj->p == 'e' || *pobj->p == 'E')) { /* Engineering mode */
-        uint8_t is_minus_exp;
-        lwjson_int_t exp_cnt;
+/**
+ * \brief           Count leading zero bits in non-zero 64-bit value
+ * \param[in]       v: Value to check. Must not be `0`
+ * \return          Number of leading zero bits
+ */
+static inline uint32_t
+prv_clz64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clzll(v);
+#else
+    uint32_t n = 0;
+    for (; (v & 0x8000000000000000ULL) == 0; v <<= 1, ++n) {}
+    return n;
+#endif
+}
 
-        type = LWJSON_TYPE_NUM_REAL;                         /* Format is real */
-        ++pobj->p;                                           /* Ignore enginnering sing part */
-        is_minus_exp = *pobj->p == '-' ? (++pobj->p, 1) : 0; /* Check if negative */
-        if (*pobj->p == '+') {                               /* Optional '+' is possible too */
-            ++pobj->p;
+/**
+ * \brief           Convert `mantissa * 10^exp10` to correctly rounded double,
+ *                  with Eisel-Lemire algorithm
+ * \param[in]       mantissa: Non-zero decimal mantissa
+ * \param[in]       exp10: Decimal exponent, in range of power of 10 table
+ * \param[out]      out: Output variable for result
+ * \return          `1` on success, `0` if result cannot be determined and slow path must be used
+ */
+static uint8_t
+prv_eisel_lemire(uint64_t mantissa, int32_t exp10, double* out) {
+    const uint64_t* pow10 = prv_pow10_128[exp10 - LWJSON_POW10_MIN_EXP];
+    uint64_t x_hi, x_lo, bits, msb, exp2;
+    uint32_t clz;
+
+    /* Normalize mantissa and estimate binary exponent: floor(exp10 * log2(10)) */
+    clz = prv_clz64(mantissa);
+    mantissa <<= clz;
+    exp2 = (uint64_t)(((217706 * exp10) >> 16) + 64 + 1023) - clz;
+
+    /* Multiply with 128-bit approximation of the power of 10 */
+    x_hi = prv_mul64(mantissa, pow10[0], &x_lo);
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + mantissa < mantissa) {
+        uint64_t y_lo, y_hi, merged_hi = x_hi, merged_lo;
+
+        /* Result is too close to rounding boundary, use lower part of the power too */
+        y_hi = prv_mul64(mantissa, pow10[1], &y_lo);
+        merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) {
+            ++merged_hi;
         }
-        if (*pobj->p < '0' || *pobj->p > '9') { /* Must be followed by number characters */
-            return lwjsonERRJSON;
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + mantissa < mantissa) {
+            return 0;
         }
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
 
-        /* Parse exponent number */
-        for (exp_cnt = 0; *pobj->p >= '0' && *pobj->p <= '9'; ++pobj->p) {
-            exp_cnt = exp_cnt * (lwjson_int_t)10 + (lwjson_int_t)(*pobj->p - '0');
-        }
+    /* Shift to 54 bits */
+    msb = x_hi >> 63;
+    bits = x_hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
 
-        /* Calculate new value for exponent 10^exponent */
-        real_num *= prv_power10(exp_cnt, is_minus_exp);
+    /* Exactly half-way between two doubles */
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (bits & 0x03) == 1) {
+        return 0;
     }
 
-    /* Write output values */
-    if (tout != NULL) {
-        *tout = type;
+    /* Round to 53 bits */
+    bits += bits & 0x01;
+    bits >>= 1;
+    if ((bits >> 53) > 0) {
+        bits >>= 1;
+        ++exp2;
     }
-    if (type == LWJSON_TYPE_NUM_INT) {
-        *iout = is_minus ? -int_num : int_num;
-    } else {
-        *fout = is_minus ? -real_num : real_num;
+
+    /* Subnormal and infinite results are handled by slow path */
+    if (exp2 - 1 >= 0x7FF - 1) {
+        return 0;
     }
-    return lwjsonOK;
+    bits = (exp2 << 52) | (bits & 0x000FFFFFFFFFFFFFULL);
+    LWJSON_MEMCPY(out, &bits, sizeof(*out));
+    return 1;
 }
 
+/* Number of significant digits kept by slow path, enough to round any double correctly */
+#define LWJSON_DECIMAL_MAX_DIGITS 800
+
+/* Largest shift of decimal number, that cannot overflow 64-bit accumulator */
+#define LWJSON_DECIMAL_MAX_SHIFT 60
+
 /**
- * \brief           Create path segment from input path for search operation
- * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is modified
- * \param[out]      opath: Pointer to pointer to write path segment
- * \param[out]      olen: Pointer to variable to write length of segment
- * \param[out]      is_last: Pointer to write if this is last segment
- * \return          `1` on success, `0` otherwise
+ * \brief           Decimal number with many digits, used by slow path of real number conversion.
+ *                  Value is `0.d[0]d[1]d[2]... * 10^decimal_point`
  */
-static uint8_t
-prv_create_path_segment(const char** ppath, const char** opath, size_t* olen, uint8_t* is_last) {
-    const char* segment = *ppath;
-
-    *is_last = 0;
-    *opath = NULL;
-    *olen = 0;
+typedef struct {
+    uint32_t num_digits;                       /*!< Number of used digits, without trailing zeros */
+    int32_t decimal_point;                     /*!< Position of decimal point relative to the first digit */
+    uint8_t truncated;                         /*!< Set to `1` if non-zero digits were dropped */
+    uint8_t d[LWJSON_DECIMAL_MAX_DIGITS + 20]; /*!< Digit values, with room for digits added by left shift */
+} lwjson_decimal_t;
 
-    /* Check input path */
-    if (segment == NULL || *segment == '\0') {
-        *is_last = 1;
-        return 0;
-    }
+/**
+ * \brief           Remove trailing zero digits of decimal number
+ * \param[in,out]   dec: Decimal number
+ */
+static void
+prv_decimal_trim(lwjson_decimal_t* dec) {
+    for (; dec->num_digits > 0 && dec->d[dec->num_digits - 1] == 0; --dec->num_digits) {}
+}
 
-    /*
-     * Path must be one of:
-     * - literal text
-     * - "#" followed by dot "."
-     */
-    if (*segment == '#') {
-        *opath = segment;
-        for (*olen = 0;; ++segment, ++(*olen)) {
-            if (*segment == '.') {
-                ++segment;
-                break;
-            } else if (*segment == '\0') {
-                if (*olen == 1) {
-                    return 0;
-                } else {
-                    break;
-                }
-            }
-        }
-        *ppath = segment;
+/**
+ * \brief           Add next digit to decimal number, or mark it truncated when there is no more space
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       c: Digit character
+ */
+static void
+prv_decimal_add(lwjson_decimal_t* dec, char c) {
+    if (dec->num_digits < LWJSON_DECIMAL_MAX_DIGITS) {
+        dec->d[dec->num_digits++] = (uint8_t)(c - '0');
     } else {
-        *opath = segment;
-        for (*olen = 0; *segment != '\0' && *segment != '.'; ++(*olen), ++segment) {}
-        *ppath = segment + 1;
-    }
-    if (*segment == '\0') {
-        *is_last = 1;
+        dec->truncated |= c != '0';
     }
-    return 1;
 }
 
 /**
- * \brief           Input recursive function for find operation
- * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
- * \param[in]       path: Path to search for starting this token further
- * \return          Found token on success, `NULL` otherwise
+ * \brief           Parse number text to decimal number
+ * \param[out]      dec: Output decimal number
+ * \param[in]       num: Number text in JSON data without sign, already validated
  */
-static const lwjson_token_t*
-prv_find(const lwjson_token_t* parent, const char* path) {
-    const char* segment;
-    size_t segment_len;
-    uint8_t is_last, res;
-
-    /* Get path segments */
-    res = prv_create_path_segment(&path, &segment, &segment_len, &is_last);
-    if (res != 0) {
-        /* Check if detected an array request */
-        if (*segment == '#') {
-            /* Parent must be array */
-            if (parent->type != LWJSON_TYPE_ARRAY) {
-                return NULL;
-            }
-
-            /* Check if index requested */
-            if (segment_len > 1) {
-                const lwjson_token_t* tkn;
-                size_t index = 0;
-
-                /* Parse number */
-                for (size_t i = 1; i < segment_len; ++i) {
-                    if (segment[i] < '0' || segment[i] > '9') {
-                        return NULL;
-                    } else {
-                        index = index * 10 + (segment[i] - '0');
-                    }
-                }
+static void
+prv_decimal_parse(lwjson_decimal_t* dec, const char* num) {
+    const char* p = num;
 
-                /* Start from beginning */
-                for (tkn = parent->u.first_child; tkn != NULL && index > 0; tkn = tkn->next, --index) {}
-                if (tkn != NULL) {
-                    if (is_last) {
-                        return tkn;
-                    } else {
-                        return prv_find(tkn, path);
-                    }
-                }
-                return NULL;
-            }
+    dec->num_digits = 0;
+    dec->decimal_point = 0;
+    dec->truncated = 0;
+    for (; *p == '0'; ++p) {}
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        prv_decimal_add(dec, *p);
+        ++dec->decimal_point;
+    }
+    if (*p == '.') {
+        for (++p; dec->num_digits == 0 && *p == '0'; ++p) {
+            --dec->decimal_point;
+        }
+        for (; *p >= '0' && *p <= '9'; ++p) {
+            prv_decimal_add(dec, *p);
+        }
+    }
+    if (*p == 'e' || *p == 'E') {
+        int32_t exp10 = 0;
 
-            /* Scan all indexes and get first match */
-            for (const lwjson_token_t* tkn = parent->u.first_child; tkn != NULL; tkn = tkn->next) {
-                const lwjson_token_t* tmp = prv_find(tkn, path);
-                if (tmp != NULL) {
-                    return tmp;
-                }
-            }
-        } else {
-            if (parent->type != LWJSON_TYPE_OBJECT) {
-                return NULL;
-            }
-            for (const lwjson_token_t* tkn = parent->u.first_child; tkn != NULL; tkn = tkn->next) {
-                if (tkn->token_name_len == segment_len && !strncmp(tkn->token_name, segment, segment_len)) {
-                    const lwjson_token_t* tmp;
-                    if (is_last) {
-                        return tkn;
-                    }
-                    tmp = prv_find(tkn, path);
-                    if (tmp != NULL) {
-                        return tmp;
-                    }
-                }
-            }
+        if (prv_parse_exponent(p + 1, &exp10) != NULL) {
+            dec->decimal_point += exp10;
         }
     }
-    return NULL;
+    prv_decimal_trim(dec);
 }
 
 /**
- * \brief           Check for character after opening bracket of array or object
- * \param[in,out]   pobj: JSON string
- * \param[in]       t: Token to check for type
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Multiply decimal number with `2^shift`
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       shift: Number of bits to shift, up to \ref LWJSON_DECIMAL_MAX_SHIFT
  */
-static inline lwjsonr_t
-prv_check_valid_char_after_open_bracket(lwjson_int_str_t* pobj, lwjson_token_t* t) {
-    lwjsonr_t res;
+static void
+prv_decimal_shl(lwjson_decimal_t* dec, uint32_t shift) {
+    /* Digits are written from the end, product has at most 19 more digits than the number */
+    int32_t r = (int32_t)dec->num_digits - 1, w = (int32_t)dec->num_digits + 19;
+    uint32_t cnt;
+    uint64_t n = 0, q;
 
-    /* Check next character after object open */
-    res = prv_skip_blank(pobj);
-    if (res != lwjsonOK) {
-        return res;
+    for (; r >= 0 || n > 0; --r, --w) {
+        if (r >= 0) {
+            n += (uint64_t)dec->d[r] << shift;
+        }
+        q = n / 10;
+        dec->d[w] = (uint8_t)(n - q * 10);
+        n = q;
     }
-    if (*pobj->p == '\0' || (t->type == LWJSON_TYPE_OBJECT && (*pobj->p != '"' && *pobj->p != '}'))
-        || (t->type == LWJSON_TYPE_ARRAY
-            && (*pobj->p != '"' && *pobj->p != ']' && *pobj->p != '[' && *pobj->p != '{' && *pobj->p != '-'
-                && (*pobj->p < '0' || *pobj->p > '9') && *pobj->p != 't' && *pobj->p != 'n' && *pobj->p != 'f'))) {
-        res = lwjsonERRJSON;
+    cnt = (uint32_t)(dec->num_digits + 19 - w);
+    memmove(dec->d, &dec->d[w + 1], cnt);
+    dec->decimal_point += (int32_t)(cnt - dec->num_digits);
+    for (; cnt > LWJSON_DECIMAL_MAX_DIGITS; --cnt) {
+        dec->truncated |= dec->d[cnt - 1] != 0;
     }
-    return res;
+    dec->num_digits = cnt;
+    prv_decimal_trim(dec);
 }
 
 /**
- * \brief           Setup LwJSON instance for parsing JSON strings
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       tokens: Pointer to array of tokens used for parsing
- * \param[in]       tokens_len: Number of tokens
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Divide decimal number with `2^shift`
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       shift: Number of bits to shift, up to \ref LWJSON_DECIMAL_MAX_SHIFT
  */
-lwjsonr_t
-lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len) {
-    LWJSON_MEMSET(lwobj, 0x00, sizeof(*lwobj));
-    LWJSON_MEMSET(tokens, 0x00, sizeof(*tokens) * tokens_len);
-    lwobj->tokens = tokens;
-    lwobj->tokens_len = tokens_len;
-    lwobj->first_token.type = LWJSON_TYPE_OBJECT;
-    return lwjsonOK;
+static void
+prv_decimal_shr(lwjson_decimal_t* dec, uint32_t shift) {
+    uint32_t r = 0, w = 0;
+    uint64_t n = 0, mask = ((uint64_t)1 << shift) - 1;
+
+    /* Leading digits, that become zero */
+    for (; (n >> shift) == 0; ++r) {
+        if (r < dec->num_digits) {
+            n = n * 10 + dec->d[r];
+        } else if (n == 0) {
+            return;
+        } else {
+            n *= 10;
+        }
+    }
+    dec->decimal_point -= (int32_t)r - 1;
+    for (; r < dec->num_digits; ++r) {
+        dec->d[w++] = (uint8_t)(n >> shift);
+        n = (n & mask) * 10 + dec->d[r];
+    }
+    for (; n > 0; n = (n & mask) * 10) {
+        if (w < LWJSON_DECIMAL_MAX_DIGITS) {
+            dec->d[w++] = (uint8_t)(n >> shift);
+        } else {
+            dec->truncated |= (n >> shift) > 0;
+        }
+    }
+    dec->num_digits = w;
+    prv_decimal_trim(dec);
 }
 
 /**
- * \brief           Parse JSON data with length parameter
- * JSON format must be complete and must comply with RFC4627
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       json_data: JSON string to parse
- * \param[in]       jsonČlen: JSON data length
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Get integer part of decimal number, rounded half to even
+ * \param[in]       dec: Decimal number
+ * \return          Rounded integer part
  */
-lwjsonr_t
-lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t json_len) {
-    lwjsonr_t res = lwjsonOK;
-    lwjson_token_t *t, *to;
-    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+static uint64_t
+prv_decimal_round(const lwjson_decimal_t* dec) {
+    uint64_t n = 0;
+    uint32_t dp;
 
-    /* Check input parameters */
-    if (lwobj == NULL || json_data == NULL || json_len == 0) {
-        res = lwjsonERRPAR;
-        goto ret;
+    if (dec->num_digits == 0 || dec->decimal_point < 0) {
+        return 0;
+    } else if (dec->decimal_point > 18) {
+        return UINT64_MAX;
+    }
+    dp = (uint32_t)dec->decimal_point;
+    for (uint32_t i = 0; i < dp; ++i) {
+        n = n * 10 + (i < dec->num_digits ? dec->d[i] : 0);
     }
+    if (dp < dec->num_digits
+        && (dec->d[dp] > 5
+            || (dec->d[dp] == 5 && (dec->truncated || dp + 1 < dec->num_digits || (n & 0x01) > 0)))) {
+        ++n;
+    }
+    return n;
+}
 
-    /* set first token */
-    to = &lwobj->first_token;
+/**
+ * \brief           Convert decimal number to correctly rounded binary floating point value
+ *
+ * Number is shifted to range `[1, 2)` with exact decimal arithmetic,
+ * mantissa bits are then taken from its integer part.
+ *
+ * \param[in,out]   dec: Decimal number, modified during conversion
+ * \param[in]       mant_bits: Number of explicit mantissa bits in output format
+ * \param[in]       bias: Exponent bias of output format
+ * \return          Bits of floating point value, without the sign
+ */
+static uint64_t
+prv_decimal_to_bits(lwjson_decimal_t* dec, uint32_t mant_bits, int32_t bias) {
+    /* Binary shifts, that do not move decimal point over 0, indexed by distance of decimal point from 0 */
+    static const uint8_t shifts[] = {0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59};
+    const uint64_t inf_bits = (uint64_t)(2 * bias + 1) << mant_bits;
+    int32_t exp2 = 0;
+    uint32_t shift;
+    uint64_t mantissa;
 
-    /* values from very beginning */
-    lwobj->flags.parsed = 0;
-    lwobj->next_free_token_pos = 0;
-    LWJSON_MEMSET(to, 0x00, sizeof(*to));
+    if (dec->num_digits == 0 || dec->decimal_point < -324) {
+        return 0;
+    } else if (dec->decimal_point > 310) {
+        return inf_bits;
+    }
 
-    /* First parse */
-    res = prv_skip_blank(&pobj);
-    if (res != lwjsonOK) {
-        goto ret;
+    /* Scale number to range [0.5, 1) */
+    while (dec->decimal_point > 0) {
+        shift = (uint32_t)dec->decimal_point < LWJSON_ARRAYSIZE(shifts) ? shifts[dec->decimal_point]
+                                                                         : LWJSON_DECIMAL_MAX_SHIFT;
+        prv_decimal_shr(dec, shift);
+        exp2 += (int32_t)shift;
     }
-    if (*pobj.p == '{') {
-        to->type = LWJSON_TYPE_OBJECT;
-    } else if (*pobj.p == '[') {
-        to->type = LWJSON_TYPE_ARRAY;
-    } else {
-        res = lwjsonERRJSON;
-        goto ret;
+    while (dec->decimal_point < 0 || (dec->decimal_point == 0 && dec->d[0] < 5)) {
+        if (dec->decimal_point == 0) {
+            shift = dec->d[0] < 2 ? 2 : 1;
+        } else {
+            shift = (uint32_t)-dec->decimal_point < LWJSON_ARRAYSIZE(shifts) ? shifts[-dec->decimal_point]
+                                                                              : LWJSON_DECIMAL_MAX_SHIFT;
+        }
+        prv_decimal_shl(dec, shift);
+        exp2 -= (int32_t)shift;
     }
-    ++pobj.p;
-    res = prv_check_valid_char_after_open_bracket(&pobj, to);
-    if (res != lwjsonOK) {
-        goto ret;
+
+    /* Scale to range [1, 2) and shift subnormal numbers to the minimal exponent */
+    --exp2;
+    while (exp2 < 1 - bias) {
+        shift = (uint32_t)(1 - bias - exp2) > LWJSON_DECIMAL_MAX_SHIFT ? LWJSON_DECIMAL_MAX_SHIFT
+                                                                      : (uint32_t)(1 - bias - exp2);
+        prv_decimal_shr(dec, shift);
+        exp2 += (int32_t)shift;
+    }
+    if (exp2 + bias >= 2 * bias + 1) {
+        return inf_bits;
     }
 
-    /* Process all characters as indicated by input user */
-    while (pobj.p != NULL && *pobj.p != '\0' && (size_t)(pobj.p - pobj.start) < pobj.len) {
-        /* Filter out blanks */
-        res = prv_skip_blank(&pobj);
-        if (res != lwjsonOK) {
-            goto ret;
+    /* Take mantissa with implicit bit, rounding can carry to the next exponent */
+    prv_decimal_shl(dec, mant_bits + 1);
+    mantissa = prv_decimal_round(dec);
+    if (mantissa >= ((uint64_t)2 << mant_bits)) {
+        prv_decimal_shr(dec, 1);
+        ++exp2;
+        mantissa = prv_decimal_round(dec);
+        if (exp2 + bias >= 2 * bias + 1) {
+            return inf_bits;
         }
-        if (*pobj.p == ',') {
-            ++pobj.p;
-            continue;
+    }
+
+    /* Subnormal number has no implicit bit and exponent bits are 0 */
+    if (mantissa < ((uint64_t)1 << mant_bits)) {
+        return mantissa;
+    }
+    return ((uint64_t)(exp2 + bias) << mant_bits) | (mantissa & (((uint64_t)1 << mant_bits) - 1));
+}
+
+/**
+ * \brief           Convert number text to correctly rounded real number with exact decimal arithmetic.
+ *                  Slow path for cases, that fast algorithms cannot decide.
+ *                  It does not depend on locale settings, contrary to `strtod` function
+ * \param[in]       num: Number text in JSON data without sign
+ * \return          Absolute value of the number
+ */
+static lwjson_real_t
+prv_real_slow(const char* num) {
+    lwjson_decimal_t dec;
+
+    prv_decimal_parse(&dec, num);
+    if (sizeof(lwjson_real_t) == sizeof(float)) {
+        uint32_t bits = (uint32_t)prv_decimal_to_bits(&dec, 23, 127);
+        float res;
+
+        LWJSON_MEMCPY(&res, &bits, sizeof(res));
+        return (lwjson_real_t)res;
+    } else {
+        uint64_t bits = prv_decimal_to_bits(&dec, 52, 1023);
+        double res;
+
+        LWJSON_MEMCPY(&res, &bits, sizeof(res));
+        return (lwjson_real_t)res;
+    }
+}
+
+/**
+ * \brief           Get float value from its bits as double, where infinity is treated as next power of 2
+ * \param[in]       bits: Bits of positive float value
+ * \return          Value as double
+ */
+static double
+prv_float_bits_to_double(uint32_t bits) {
+    float f;
+
+    if (bits == 0x7F800000UL) {
+        return 340282366920938463463374607431768211456.0; /* 2^128 */
+    }
+    LWJSON_MEMCPY(&f, &bits, sizeof(f));
+    return (double)f;
+}
+
+/**
+ * \brief           Check if double value lies exactly between two float values.
+ *                  Only then the correctly rounded double can round to wrong float value
+ * \param[in]       d: Positive, correctly rounded double value
+ * \return          `1` if value is half-way between two floats, `0` otherwise
+ */
+static uint8_t
+prv_is_float_halfway(double d) {
+    float f = (float)d;
+    uint32_t bits;
+    double lo;
+
+    LWJSON_MEMCPY(&bits, &f, sizeof(bits));
+    lo = prv_float_bits_to_double(bits);
+    if (lo == d) {
+        return 0;
+    }
+    return lo + prv_float_bits_to_double(lo < d ? bits + 1 : bits - 1) == 2 * d;
+}
+
+/**
+ * \brief           Convert decimal number to correctly rounded real number
+ *
+ * Double result is correctly rounded by the fast algorithms.
+ * When \ref LWJSON_CFG_REAL_TYPE is `float`, double is rounded once more,
+ * which is exact unless double is half-way between two floats, then slow path decides.
+ *
+ * \param[in]       mantissa: Decimal mantissa with up to \ref LWJSON_NUM_MAX_DIGITS significant digits
+ * \param[in]       exp10: Decimal exponent
+ * \param[in]       truncated: Set to `1` if non-zero digits were dropped from the mantissa
+ * \param[in]       num: Number text in JSON data without sign, used for slow path
+ * \return          Absolute value of the number
+ */
+static lwjson_real_t
+prv_real_correct(uint64_t mantissa, int32_t exp10, uint8_t truncated, const char* num) {
+    static const double pow10_exact[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    double res, res_up;
+
+    if (mantissa == 0 || exp10 < LWJSON_POW10_MIN_EXP) {
+        return (lwjson_real_t)0;
+    } else if (exp10 > LWJSON_POW10_MAX_EXP) {
+        return (lwjson_real_t)HUGE_VAL;
+    }
+
+    if (!truncated && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+        /* Both mantissa and power of 10 are exact doubles, single operation rounds correctly */
+        res = (double)mantissa;
+        res = exp10 < 0 ? res / pow10_exact[-exp10] : res * pow10_exact[exp10];
+    } else if (!prv_eisel_lemire(mantissa, exp10, &res)
+               || (truncated && (!prv_eisel_lemire(mantissa + 1, exp10, &res_up) || res != res_up))) {
+        /* Truncated number is in range [mantissa, mantissa + 1) and both must round to the same value */
+        return prv_real_slow(num);
+    }
+    if (sizeof(lwjson_real_t) == sizeof(float) && prv_is_float_halfway(res)) {
+        return prv_real_slow(num);
+    }
+    return (lwjson_real_t)res;
+}
+
+#endif /* LWJSON_CFG_REAL_CORRECT_ROUNDING */
+
+#if !LWJSON_CFG_REAL_CORRECT_ROUNDING
+
+/**
+ * \brief           Calculate new value for exponent 10^exponent.
+ * \param[in]       exp: Exponent.
+ * \param[in]       is_minus: Indicates whether the exponent is negative.
+ * \return          Value of 10^exponent.
+ */
+static lwjson_real_t prv_power10(lwjson_int_t exp, uint8_t is_minus)
+{
+    lwjson_real_t result = (lwjson_real_t)1;
+    lwjson_real_t base = (lwjson_real_t)10;
+
+    for (;exp > 0; base *= base, exp >>= 1) {
+        if ((exp & 1) == 1) {
+            result *= base;
+        }
+    }
+
+    return is_minus ? ((lwjson_real_t)1 / result) : result;
+}
+
+/* Powers of 10 for the most common exponents */
+static const lwjson_real_t prv_pow10_real[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                               1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+#endif /* !LWJSON_CFG_REAL_CORRECT_ROUNDING */
+
+/**
+ * \brief           Calculate real number as `mantissa * 10^exp10`
+ * \param[in]       mantissa: Decimal mantissa with up to \ref LWJSON_NUM_MAX_DIGITS significant digits
+ * \param[in]       exp10: Decimal exponent
+ * \param[in]       truncated: Set to `1` if non-zero digits were dropped from the mantissa
+ * \param[in]       num: Number text in JSON data without sign
+ * \return          Absolute value of the number
+ */
+static LWJSON_FORCE_INLINE lwjson_real_t
+prv_real_calc(uint64_t mantissa, int32_t exp10, uint8_t truncated, const char* num) {
+#if LWJSON_CFG_REAL_CORRECT_ROUNDING
+    return prv_real_correct(mantissa, exp10, truncated, num);
+#else
+    lwjson_real_t real_num = (lwjson_real_t)mantissa;
+
+    (void)truncated;
+    (void)num;
+    if (exp10 < 0) {
+        real_num /= -exp10 < (int32_t)LWJSON_ARRAYSIZE(prv_pow10_real) ? prv_pow10_real[-exp10] : prv_power10(-exp10, 0);
+    } else if (exp10 > 0) {
+        real_num *= exp10 < (int32_t)LWJSON_ARRAYSIZE(prv_pow10_real) ? prv_pow10_real[exp10] : prv_power10(exp10, 0);
+    }
+    return real_num;
+#endif /* LWJSON_CFG_REAL_CORRECT_ROUNDING */
+}
+
+/**
+ * \brief           Parse number, that does not fit to fast path of \ref prv_parse_number function
+ *
+ * Digits are accumulated in 64-bit mantissa, 8 digits at a time when possible.
+ * Integers, that do not fit into \ref lwjson_int_t, are returned as real numbers
+ * or cause \ref lwjsonERRRANGE error, depending on \ref LWJSON_CFG_INT_OVERFLOW_REAL
+ *
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[in]       num: Pointer to the first digit of the number
+ * \param[in]       is_minus: Set to `1` if number is negative
+ * \param[out]      tout: Pointer to output number format
+ * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
+ * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static LWJSON_NOINLINE lwjsonr_t
+prv_parse_number_long(lwjson_int_str_t* pobj, const char* num, uint8_t is_minus, lwjson_type_t* tout,
+                      lwjson_real_t* fout, lwjson_int_t* iout) {
+    uint8_t truncated = 0;
+    uint64_t mantissa = 0;
+    int32_t exp10 = 0, frac_len = 0;
+    size_t ndigits;
+    const char *p, *num_end;
+    lwjson_real_t real_num;
+    lwjson_type_t type = LWJSON_TYPE_NUM_INT;
+
+    /* Parse integer part */
+    p = prv_parse_digits(pobj, num, &mantissa);
+    ndigits = (size_t)(p - num);
+
+    if (*p == '.') { /* Number has fraction part */
+        const char* frac;
+
+        type = LWJSON_TYPE_NUM_REAL;
+        frac = ++p;
+        if (*p < '0' || *p > '9') { /* Must be followed by number characters */
+            return lwjsonERRJSON;
+        }
+        p = prv_parse_digits(pobj, p, &mantissa);
+        ndigits += (size_t)(p - frac);
+        frac_len = (int32_t)(p - frac > INT32_MAX / 2 ? INT32_MAX / 2 : p - frac);
+        exp10 = -frac_len;
+    }
+    num_end = p;
+    if (*p == 'e' || *p == 'E') { /* Engineering mode */
+        type = LWJSON_TYPE_NUM_REAL;
+        p = prv_parse_exponent(p + 1, &exp10);
+        if (p == NULL) {
+            return lwjsonERRJSON;
+        }
+    }
+    pobj->p = p;
+
+    /* Mantissa wrapped around, parse it again and keep only significant digits */
+    if (ndigits > LWJSON_NUM_MAX_DIGITS) {
+        exp10 += frac_len + prv_parse_long_mantissa(num, num_end, &mantissa, &truncated);
+    }
+
+    /* Check if integer fits into its type */
+    if (type == LWJSON_TYPE_NUM_INT) {
+        uint64_t limit = ((uint64_t)1 << (sizeof(lwjson_int_t) * 8 - 1)) - 1;
+
+        if (exp10 == 0 && mantissa <= limit + is_minus) {
+            if (tout != NULL) {
+                *tout = type;
+            }
+            /* Negate in unsigned domain to support minimal integer value */
+            *iout = is_minus && mantissa > 0 ? -(lwjson_int_t)(mantissa - 1) - 1 : (lwjson_int_t)mantissa;
+            return lwjsonOK;
+        }
+#if LWJSON_CFG_INT_OVERFLOW_REAL
+        type = LWJSON_TYPE_NUM_REAL;
+#else
+        return lwjsonERRRANGE;
+#endif /* LWJSON_CFG_INT_OVERFLOW_REAL */
+    }
+
+    /* Calculate real number as mantissa * 10^exp10 */
+    real_num = prv_real_calc(mantissa, exp10, truncated, num);
+
+    /* Write output values */
+    if (tout != NULL) {
+        *tout = type;
+    }
+    *fout = is_minus ? -real_num : real_num;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Finish parsing of number with exponent, that has short mantissa
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[in]       p: Pointer to first character after `e` or `E` character
+ * \param[in]       num: Pointer to the first digit of the number
+ * \param[in]       mantissa: Decimal mantissa of integer and fraction part
+ * \param[in]       exp10: Decimal exponent of fraction part
+ * \param[in]       is_minus: Set to `1` if number is negative
+ * \param[out]      tout: Pointer to output number format
+ * \param[out]      fout: Pointer to output real-type variable
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static LWJSON_NOINLINE lwjsonr_t
+prv_parse_number_exp(lwjson_int_str_t* pobj, const char* p, const char* num, uint64_t mantissa, int32_t exp10,
+                     uint8_t is_minus, lwjson_type_t* tout, lwjson_real_t* fout) {
+    lwjson_real_t real_num;
+
+    p = prv_parse_exponent(p, &exp10);
+    if (p == NULL) {
+        return lwjsonERRJSON;
+    }
+    pobj->p = p;
+    real_num = prv_real_calc(mantissa, exp10, 0, num);
+    if (tout != NULL) {
+        *tout = LWJSON_TYPE_NUM_REAL;
+    }
+    *fout = is_minus ? -real_num : real_num;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Parse number as described in RFC4627
+ *
+ * Typical numbers are short and plain scalar loop converts them faster than SWAR kernel.
+ * Numbers with exponent continue in \ref prv_parse_number_exp function.
+ * Integers, that may not fit into \ref lwjson_int_t, and numbers with too many digits
+ * for 64-bit mantissa are parsed again by \ref prv_parse_number_long function
+ *
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[out]      tout: Pointer to output number format
+ * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
+ * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_number(lwjson_int_str_t* pobj, lwjson_type_t* tout, lwjson_real_t* fout, lwjson_int_t* iout) {
+    lwjsonr_t res;
+    uint8_t is_minus;
+    uint64_t mantissa = 0;
+    int32_t exp10;
+    const char *p, *num, *frac;
+    lwjson_real_t real_num;
+
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (*pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
+        return lwjsonERRJSON;
+    }
+    is_minus = *pobj->p == '-' ? (++pobj->p, 1) : 0;
+    if (*pobj->p == '\0'                    /* Invalid string */
+        || *pobj->p < '0' || *pobj->p > '9' /* Character outside number range */
+        || (*pobj->p == '0'
+            && (pobj->p[1] < '0' && pobj->p[1] > '9'))) { /* Number starts with 0 but not followed by dot */
+        return lwjsonERRJSON;
+    }
+
+    /* Parse integer and fraction part */
+    num = pobj->p;
+    for (p = num; *p >= '0' && *p <= '9'; ++p) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+    }
+    if (*p != '.' && *p != 'e' && *p != 'E') {
+        /* Integer with this many digits always fits into its type */
+        if ((size_t)(p - num) <= LWJSON_INT_SAFE_DIGITS) {
+            pobj->p = p;
+            if (tout != NULL) {
+                *tout = LWJSON_TYPE_NUM_INT;
+            }
+            *iout = is_minus ? -(lwjson_int_t)mantissa : (lwjson_int_t)mantissa;
+            return lwjsonOK;
+        }
+    } else {
+        frac = p;
+        if (*p == '.') {
+            frac = ++p;
+            if (*p < '0' || *p > '9') { /* Must be followed by number characters */
+                return lwjsonERRJSON;
+            }
+            for (; *p >= '0' && *p <= '9'; ++p) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            }
+        }
+
+        /* Mantissa did not wrap around, it is only scaled by fraction digits and exponent */
+        if ((size_t)(p - num) <= LWJSON_NUM_MAX_DIGITS) {
+            exp10 = -(int32_t)(p - frac);
+            if (*p == 'e' || *p == 'E') {
+                return prv_parse_number_exp(pobj, p + 1, num, mantissa, exp10, is_minus, tout, fout);
+            }
+            pobj->p = p;
+            real_num = prv_real_calc(mantissa, exp10, 0, num);
+            if (tout != NULL) {
+                *tout = LWJSON_TYPE_NUM_REAL;
+            }
+            *fout = is_minus ? -real_num : real_num;
+            return lwjsonOK;
+        }
+    }
+    return prv_parse_number_long(pobj, num, is_minus, tout, fout, iout);
+}
+
+/**
+ * \brief           Skip number in JSON string and check its format, without converting it
+ *
+ * Accepted format and number type are the same as in \ref prv_parse_number function
+ *
+ * \param[in,out]   pobj: JSON string, set to the first number character
+ * \param[out]      tout: Output variable for number type
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_skip_number(lwjson_int_str_t* pobj, lwjson_type_t* tout) {
+    const char* p = pobj->p;
+    const char* digits;
+
+    *tout = LWJSON_TYPE_NUM_INT;
+    if (*p == '-') {
+        ++p;
+    }
+    if (*p < '0' || *p > '9') {
+        return lwjsonERRJSON;
+    }
+    for (digits = p; *p >= '0' && *p <= '9'; ++p) {}
+
+    /* Long integer may not fit into its type, full parse decides */
+    if ((size_t)(p - digits) > LWJSON_INT_SAFE_DIGITS && *p != '.' && *p != 'e' && *p != 'E') {
+        lwjson_real_t fval;
+        lwjson_int_t ival;
+
+        return prv_parse_number(pobj, tout, &fval, &ival);
+    }
+    if (*p == '.') {
+        *tout = LWJSON_TYPE_NUM_REAL;
+        ++p;
+        if (*p < '0' || *p > '9') {
+            return lwjsonERRJSON;
+        }
+        for (; *p >= '0' && *p <= '9'; ++p) {}
+    }
+    if (*p == 'e' || *p == 'E') {
+        *tout = LWJSON_TYPE_NUM_REAL;
+        ++p;
+        if (*p == '-') {
+            ++p;
+        }
+        if (*p == '+') {
+            ++p;
+        }
+        if (*p < '0' || *p > '9') {
+            return lwjsonERRJSON;
+        }
+        for (; *p >= '0' && *p <= '9'; ++p) {}
+    }
+    pobj->p = p;
+    return lwjsonOK;
+}
+
+#if LWJSON_CFG_PACKED_ARRAYS
+
+/**
+ * \brief           Header of packed array values, stored in the first token after array token.
+ *                  Values follow immediately after the header
+ */
+typedef union {
+    struct {
+        size_t len;   /*!< Number of values */
+        uint8_t type; /*!< Type of values. \ref LWJSON_TYPE_TRUE is used for `true` and `false` values */
+    } h;              /*!< Header data */
+
+    lwjson_real_t r; /*!< Alignment of real values */
+    lwjson_int_t i;  /*!< Alignment of int values */
+} lwjson_packed_hdr_t;
+
+/**
+ * \brief           Get size of single packed value
+ * \param[in]       type: Type of packed values
+ * \return          Size of value in units of bytes
+ */
+static inline size_t
+prv_packed_size(lwjson_type_t type) {
+    return type == LWJSON_TYPE_NUM_INT ? sizeof(lwjson_int_t)
+                                       : (type == LWJSON_TYPE_NUM_REAL ? sizeof(lwjson_real_t) : sizeof(uint8_t));
+}
+
+/**
+ * \brief           Parse array of primitive values of the same type to packed values
+ *
+ * Array is packed only when it has at least one value and packed values
+ * take fewer tokens than one token per value.
+ * On failure, input string and token storage are restored, array has to be parsed to tokens
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object, set after array opening bracket
+ * \param[in,out]   t: Array token. Set as packed on success
+ * \return          `1` when array is packed and its closing bracket is consumed, `0` otherwise
+ */
+static uint8_t
+prv_parse_packed(lwjson_t* lwobj, lwjson_int_str_t* pobj, lwjson_token_t* t) {
+    const char* p = pobj->p;
+    size_t pos = lwobj->next_free_token_pos, cnt = 0, cap = 0, size = 0;
+    lwjson_packed_hdr_t* hdr = NULL;
+    lwjson_type_t type = LWJSON_TYPE_NULL;
+
+    for (;;) {
+        lwjson_type_t vtype;
+        lwjson_int_t ival = 0;
+        lwjson_real_t rval = 0;
+        uint8_t* val;
+
+        if (prv_skip_blank(pobj) != lwjsonOK) {
+            break;
+        }
+        if (*pobj->p == 't' && strncmp(pobj->p, "true", 4) == 0) {
+            vtype = LWJSON_TYPE_TRUE;
+            ival = 1;
+            pobj->p += 4;
+        } else if (*pobj->p == 'f' && strncmp(pobj->p, "false", 5) == 0) {
+            vtype = LWJSON_TYPE_TRUE;
+            pobj->p += 5;
+#if !LWJSON_CFG_LAZY_NUMBERS
+        } else if (*pobj->p == '-' || (*pobj->p >= '0' && *pobj->p <= '9')) {
+            if (prv_parse_number(pobj, &vtype, &rval, &ival) != lwjsonOK) {
+                break;
+            }
+#endif /* !LWJSON_CFG_LAZY_NUMBERS */
+        } else {
+            break;
+        }
+        if (cnt == 0) {
+            type = vtype;
+            size = prv_packed_size(type);
+        } else if (vtype != type) {
+            break;
+        }
+
+        /* Tokens are contiguous, allocate next ones when value does not fit */
+        while (sizeof(*hdr) + (cnt + 1) * size > cap) {
+            lwjson_token_t* slot = prv_alloc_token(lwobj);
+            if (slot == NULL) {
+                break;
+            }
+            if (hdr == NULL) {
+                hdr = (lwjson_packed_hdr_t*)slot;
+            }
+            cap += sizeof(*slot);
+        }
+        if (sizeof(*hdr) + (cnt + 1) * size > cap) {
+            break;
+        }
+        val = (uint8_t*)(hdr + 1) + cnt * size;
+        if (type == LWJSON_TYPE_NUM_INT) {
+            LWJSON_MEMCPY(val, &ival, sizeof(ival));
+        } else if (type == LWJSON_TYPE_NUM_REAL) {
+            LWJSON_MEMCPY(val, &rval, sizeof(rval));
+        } else {
+            *val = (uint8_t)ival;
+        }
+        ++cnt;
+
+        /* Value must be followed by next value or end of array */
+        if (prv_skip_blank(pobj) != lwjsonOK) {
+            break;
+        }
+        if (*pobj->p == ',') {
+            ++pobj->p;
+        } else if (*pobj->p == ']' && lwobj->next_free_token_pos - pos <= cnt) {
+            ++pobj->p;
+            hdr->h.len = cnt;
+            hdr->h.type = (uint8_t)type;
+#if LWJSON_CFG_COMPACT_TOKENS
+            t->packed = 1;
+            t->u.cont.child_tokens = (uint32_t)(lwobj->next_free_token_pos - pos);
+#else
+            t->u.cont.first_child = NULL;
+            t->u.cont.child_tokens = lwobj->next_free_token_pos - pos;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+            return 1;
+        } else {
+            break;
+        }
+    }
+    pobj->p = p;
+    lwobj->next_free_token_pos = pos;
+    return 0;
+}
+
+/**
+ * \brief           Check if array with children tokens is packed, when its data is parsed with \ref prv_parse_packed
+ * \param[in]       t: Array token with children tokens
+ * \return          `1` if array is packed, `0` otherwise
+ */
+static uint8_t
+prv_packed_check(const lwjson_token_t* t) {
+    lwjson_type_t type = LWJSON_TYPE_NULL;
+    size_t cnt = 0;
+
+    for (const lwjson_token_t* c = lwjson_get_first_child(t); c != NULL; c = lwjson_get_next(c), ++cnt) {
+        lwjson_type_t vtype = c->type == LWJSON_TYPE_FALSE ? LWJSON_TYPE_TRUE : c->type;
+
+#if LWJSON_CFG_LAZY_NUMBERS
+        if (vtype != LWJSON_TYPE_TRUE || (cnt > 0 && vtype != type)) {
+#else
+        if ((vtype != LWJSON_TYPE_TRUE && vtype != LWJSON_TYPE_NUM_INT && vtype != LWJSON_TYPE_NUM_REAL)
+            || (cnt > 0 && vtype != type)) {
+#endif /* LWJSON_CFG_LAZY_NUMBERS */
+            return 0;
+        }
+        type = vtype;
+    }
+    return cnt > 0 && (sizeof(lwjson_packed_hdr_t) + cnt * prv_packed_size(type) + sizeof(*t) - 1) / sizeof(*t) <= cnt;
+}
+
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+
+/**
+ * \brief           Get packed values of array token
+ * \param[in]       token: Array token
+ * \return          Header of packed values, `NULL` if array is not packed
+ */
+static const void*
+prv_packed_hdr(const lwjson_token_t* token) {
+#if LWJSON_CFG_PACKED_ARRAYS
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (token != NULL && token->type == LWJSON_TYPE_ARRAY && token->packed) {
+        return token + 1;
+    }
+#else
+    if (token != NULL && token->type == LWJSON_TYPE_ARRAY && token->u.cont.first_child == NULL
+        && token->u.cont.child_tokens > 0) {
+        return token + 1;
+    }
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+#else
+    (void)token;
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+    return NULL;
+}
+
+/**
+ * \brief           Set token to the value of packed array
+ * \param[in]       array: Packed array token
+ * \param[in]       index: Index of the value
+ * \param[out]      out: Token to set
+ * \return          Pointer to output token on success, `NULL` if index is out of range
+ */
+static const lwjson_token_t*
+prv_packed_get(const lwjson_token_t* array, size_t index, lwjson_token_t* out) {
+#if LWJSON_CFG_PACKED_ARRAYS
+    const lwjson_packed_hdr_t* hdr = prv_packed_hdr(array);
+    const uint8_t* val;
+
+    if (hdr == NULL || index >= hdr->h.len) {
+        return NULL;
+    }
+    val = (const uint8_t*)(hdr + 1) + index * prv_packed_size((lwjson_type_t)hdr->h.type);
+    LWJSON_MEMSET(out, 0x00, sizeof(*out));
+    if (hdr->h.type == LWJSON_TYPE_NUM_INT) {
+        out->type = LWJSON_TYPE_NUM_INT;
+        LWJSON_MEMCPY(&out->u.num_int, val, sizeof(out->u.num_int));
+    } else if (hdr->h.type == LWJSON_TYPE_NUM_REAL) {
+        out->type = LWJSON_TYPE_NUM_REAL;
+        LWJSON_MEMCPY(&out->u.num_real, val, sizeof(out->u.num_real));
+    } else {
+        out->type = *val ? LWJSON_TYPE_TRUE : LWJSON_TYPE_FALSE;
+    }
+    return out;
+#else
+    (void)array;
+    (void)index;
+    (void)out;
+    return NULL;
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+}
+
+/**
+ * \brief           Create path segment from input path for search operation
+ * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is modified
+ * \param[out]      opath: Pointer to pointer to write path segment
+ * \param[out]      olen: Pointer to variable to write length of segment
+ * \param[out]      is_last: Pointer to write if this is last segment
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_create_path_segment(const char** ppath, const char** opath, size_t* olen, uint8_t* is_last) {
+    const char* segment = *ppath;
+
+    *is_last = 0;
+    *opath = NULL;
+    *olen = 0;
+
+    /* Check input path */
+    if (segment == NULL || *segment == '\0') {
+        *is_last = 1;
+        return 0;
+    }
+
+    /*
+     * Path must be one of:
+     * - literal text
+     * - "#" followed by dot "."
+     */
+    if (*segment == '#') {
+        *opath = segment;
+        for (*olen = 0;; ++segment, ++(*olen)) {
+            if (*segment == '.') {
+                ++segment;
+                break;
+            } else if (*segment == '\0') {
+                if (*olen == 1) {
+                    return 0;
+                } else {
+                    break;
+                }
+            }
+        }
+        *ppath = segment;
+    } else {
+        *opath = segment;
+        for (*olen = 0; *segment != '\0' && *segment != '.'; ++(*olen), ++segment) {}
+        *ppath = segment + 1;
+    }
+    if (*segment == '\0') {
+        *is_last = 1;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Rest of the path to find, as text or as compiled path
+ */
+typedef struct {
+    const char* path;           /*!< Rest of the path text. Used when compiled path is `NULL` */
+    const lwjson_path_t* cpath; /*!< Compiled path or `NULL` */
+    size_t seg;                 /*!< Index of next segment of compiled path */
+} lwjson_find_rest_t;
+
+#if LWJSON_CFG_KEY_INDEX
+
+/**
+ * \brief           Calculate FNV-1a hash of the key
+ * \param[in]       key: Key to hash
+ * \param[in]       key_len: Length of the key in units of bytes
+ * \return          Hash of the key
+ */
+static uint32_t
+prv_hash_key(const char* key, size_t key_len) {
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < key_len; ++i) {
+        hash = (hash ^ (uint8_t)key[i]) * 16777619U;
+    }
+    return hash;
+}
+
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+/**
+ * \brief           Get next path segment with parsed array index
+ * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is modified
+ * \param[out]      seg: Output segment
+ * \param[out]      is_last: Pointer to write if this is last segment
+ * \return          `1` on success, `0` if there is no segment or array index is not valid
+ */
+static uint8_t
+prv_path_segment(const char** ppath, lwjson_path_segment_t* seg, uint8_t* is_last) {
+    const char* segment;
+    size_t segment_len;
+
+    if (!prv_create_path_segment(ppath, &segment, &segment_len, is_last)) {
+        return 0;
+    }
+    if (*segment == '#') {
+        seg->key = NULL;
+        seg->key_len = 0;
+        seg->index = LWJSON_PATH_INDEX_ANY;
+        if (segment_len > 1) {
+            seg->index = 0;
+            for (size_t i = 1; i < segment_len; ++i) {
+                if (segment[i] < '0' || segment[i] > '9' || seg->index >= LWJSON_PATH_INDEX_ANY / 10) {
+                    return 0;
+                }
+                seg->index = seg->index * 10 + (size_t)(segment[i] - '0');
+            }
+        }
+    } else {
+        seg->key = segment;
+        seg->key_len = segment_len;
+        seg->index = 0;
+#if LWJSON_CFG_KEY_INDEX
+        seg->hash = prv_hash_key(segment, segment_len);
+#endif /* LWJSON_CFG_KEY_INDEX */
+    }
+    return 1;
+}
+
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+
+/**
+ * \brief           Index table of single object or array, followed by its slots or elements
+ */
+typedef struct {
+    const lwjson_token_t* token; /*!< Object or array token */
+    size_t size; /*!< Number of key hash slots for object, power of two, or number of elements for array */
+} lwjson_index_t;
+
+/**
+ * \brief           Minimal number of children of object or array with index table.
+ * Children of different tokens are different tokens, so there are at most
+ * as many tables as number of used tokens, divided by this value
+ */
+#if LWJSON_CFG_KEY_INDEX && LWJSON_CFG_ARRAY_INDEX
+#define LWJSON_INDEX_MIN_CHILDREN                                                                                      \
+    (LWJSON_CFG_KEY_INDEX_MIN_MEMBERS < LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS ? LWJSON_CFG_KEY_INDEX_MIN_MEMBERS          \
+                                                                            : LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS)
+#elif LWJSON_CFG_KEY_INDEX
+#define LWJSON_INDEX_MIN_CHILDREN LWJSON_CFG_KEY_INDEX_MIN_MEMBERS
+#else
+#define LWJSON_INDEX_MIN_CHILDREN LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS
+#endif
+
+/**
+ * \brief           Drop all index tables
+ * \param[in,out]   lwobj: LwJSON instance
+ */
+static void
+prv_index_reset(lwjson_t* lwobj) {
+#if LWJSON_CFG_ALLOC
+    if (lwobj->index.arena == NULL && lwobj->index.dir != NULL) {
+        for (size_t i = 0; i < lwobj->index.dir_size; ++i) {
+            LWJSON_FREE(lwobj->index.dir[i]);
+        }
+        LWJSON_FREE(lwobj->index.dir);
+    }
+#endif /* LWJSON_CFG_ALLOC */
+    lwobj->index.dir = NULL;
+    lwobj->index.dir_size = 0;
+    lwobj->index.count = 0;
+    lwobj->index.arena_used = 0;
+    lwobj->index.full = 0;
+}
+
+/**
+ * \brief           Allocate zeroed memory for index table or table of index tables
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       len: Number of bytes to allocate
+ * \return          Pointer to memory or `NULL` if there is no memory
+ */
+static void*
+prv_index_mem(lwjson_t* lwobj, size_t len) {
+    void* mem = NULL;
+
+    if (lwobj->index.arena != NULL) {
+        size_t pos = (lwobj->index.arena_used + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+        if (pos <= lwobj->index.arena_len && len <= lwobj->index.arena_len - pos) {
+            mem = &lwobj->index.arena[pos];
+            lwobj->index.arena_used = pos + len;
+        }
+    } else {
+#if LWJSON_CFG_ALLOC
+        mem = LWJSON_MALLOC(len);
+#endif /* LWJSON_CFG_ALLOC */
+    }
+    if (mem != NULL) {
+        LWJSON_MEMSET(mem, 0x00, len);
+    }
+    return mem;
+}
+
+/**
+ * \brief           Get first entry to check for the token in the table of index tables
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Object or array token
+ * \return          Entry position
+ */
+static inline size_t
+prv_index_dir_pos(const lwjson_t* lwobj, const lwjson_token_t* token) {
+    /* Multiplicative hash spreads tokens, that are close together in the tokens array */
+    return (size_t)(((uintptr_t)token / sizeof(*token)) * 0x9E3779B1U) & (lwobj->index.dir_size - 1);
+}
+
+/**
+ * \brief           Find already built index table of the token
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Object or array token
+ * \return          Index table or `NULL` if not built yet
+ */
+static const lwjson_index_t*
+prv_index_find(const lwjson_t* lwobj, const lwjson_token_t* token) {
+    if (lwobj->index.count == 0) {
+        return NULL;
+    }
+    for (size_t i = prv_index_dir_pos(lwobj, token);; i = (i + 1) & (lwobj->index.dir_size - 1)) {
+        const lwjson_index_t* idx = lwobj->index.dir[i];
+
+        if (idx == NULL || idx->token == token) {
+            return idx;
+        }
+    }
+}
+
+/**
+ * \brief           Count children of object or array, when there are at least `min` of them
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Object or array token
+ * \param[in]       min: Minimal number of children
+ * \return          Number of children or `0` if there are less than `min` or there is no memory for new table
+ */
+static size_t
+prv_index_count(const lwjson_t* lwobj, const lwjson_token_t* token, size_t min) {
+    size_t cnt = 0;
+
+    /* Subtree has at least one token per child */
+    if (lwobj->index.full || lwjson_get_subtree_size(token) < min) {
+        return 0;
+    }
+    for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
+        ++cnt;
+    }
+    return cnt >= min ? cnt : 0;
+}
+
+/**
+ * \brief           Allocate new index table and add it to the table of index tables
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       token: Object or array token
+ * \param[in]       size: Number of slots or elements
+ * \param[in]       item_size: Size of single slot or element in units of bytes
+ * \return          Zeroed index table or `NULL` if there is no memory for it
+ */
+static lwjson_index_t*
+prv_index_alloc(lwjson_t* lwobj, const lwjson_token_t* token, size_t size, size_t item_size) {
+    lwjson_index_t* idx = NULL;
+    size_t i;
+
+    /* Table of index tables is at most half full, its size is known once tokens are parsed */
+    if (lwobj->index.dir == NULL) {
+        size_t max_cnt = lwjson_get_tokens_used(lwobj) / (LWJSON_INDEX_MIN_CHILDREN > 0 ? LWJSON_INDEX_MIN_CHILDREN : 1);
+
+        for (lwobj->index.dir_size = 2; lwobj->index.dir_size < 2 * max_cnt; lwobj->index.dir_size <<= 1) {}
+        lwobj->index.dir = prv_index_mem(lwobj, lwobj->index.dir_size * sizeof(*lwobj->index.dir));
+    }
+    if (lwobj->index.dir != NULL && 2 * (lwobj->index.count + 1) <= lwobj->index.dir_size) {
+        idx = prv_index_mem(lwobj, sizeof(*idx) + size * item_size);
+    }
+    if (idx == NULL) {
+        lwobj->index.full = 1;
+        return NULL;
+    }
+    idx->token = token;
+    idx->size = size;
+    for (i = prv_index_dir_pos(lwobj, token); lwobj->index.dir[i] != NULL; i = (i + 1) & (lwobj->index.dir_size - 1)) {}
+    lwobj->index.dir[i] = idx;
+    ++lwobj->index.count;
+    return idx;
+}
+
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+
+#if LWJSON_CFG_KEY_INDEX
+
+/**
+ * \brief           Slot of key hash table
+ */
+typedef struct {
+    const lwjson_token_t* t; /*!< First member with the name or `NULL` for empty slot */
+    uint32_t hash;           /*!< Hash of member name */
+} lwjson_key_slot_t;
+
+/**
+ * \brief           Find slot for the name in key hash table
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       idx: Key hash table
+ * \param[in]       name: Name to find
+ * \param[in]       name_len: Length of the name in units of bytes
+ * \param[in]       hash: Hash of the name
+ * \return          Slot with the name or empty slot, where name is to be inserted
+ */
+static lwjson_key_slot_t*
+prv_index_slot(const lwjson_t* lwobj, const lwjson_index_t* idx, const char* name, size_t name_len, uint32_t hash) {
+    lwjson_key_slot_t* slots = (lwjson_key_slot_t*)(void*)(idx + 1);
+    size_t mask = idx->size - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        if (slots[i].t == NULL) {
+            return &slots[i];
+        }
+        if (slots[i].hash == hash) {
+            size_t len = 0;
+            const char* str = lwjson_get_token_name(lwobj, slots[i].t, &len);
+
+            if (len == name_len && !strncmp(str, name, name_len)) {
+                return &slots[i];
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Get key hash table of the object, build it on first use
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       obj: Object token
+ * \return          Key hash table or `NULL` if object is too small or there is no memory for it
+ */
+static const lwjson_index_t*
+prv_index_get(lwjson_t* lwobj, const lwjson_token_t* obj) {
+    lwjson_index_t* idx;
+    size_t cnt, slots_cnt;
+
+    if (lwjson_get_subtree_size(obj) < LWJSON_CFG_KEY_INDEX_MIN_MEMBERS) {
+        return NULL;
+    }
+    idx = (lwjson_index_t*)prv_index_find(lwobj, obj);
+    if (idx != NULL) {
+        return idx;
+    }
+    cnt = prv_index_count(lwobj, obj, LWJSON_CFG_KEY_INDEX_MIN_MEMBERS);
+    if (cnt == 0) {
+        return NULL;
+    }
+
+    /* Table is at most half full */
+    for (slots_cnt = 1; slots_cnt < 2 * cnt; slots_cnt <<= 1) {}
+    idx = prv_index_alloc(lwobj, obj, slots_cnt, sizeof(lwjson_key_slot_t));
+    if (idx == NULL) {
+        return NULL;
+    }
+
+    /* Only the first member with the same name is stored */
+    for (const lwjson_token_t* t = lwjson_get_first_child(obj); t != NULL; t = lwjson_get_next(t)) {
+        size_t name_len = 0;
+        const char* name = lwjson_get_token_name(lwobj, t, &name_len);
+        uint32_t hash = prv_hash_key(name, name_len);
+        lwjson_key_slot_t* slot = prv_index_slot(lwobj, idx, name, name_len, hash);
+
+        if (slot->t == NULL) {
+            slot->t = t;
+            slot->hash = hash;
+        }
+    }
+    return idx;
+}
+
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+#if LWJSON_CFG_ARRAY_INDEX
+
+/**
+ * \brief           Get element table of the array, build it on first use
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       arr: Array token, not packed
+ * \return          Element table or `NULL` if array is too small or there is no memory for it
+ */
+static const lwjson_index_t*
+prv_array_index_get(lwjson_t* lwobj, const lwjson_token_t* arr) {
+    lwjson_index_t* idx;
+    const lwjson_token_t** elems;
+    size_t cnt;
+
+    if (lwjson_get_subtree_size(arr) < LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS) {
+        return NULL;
+    }
+    idx = (lwjson_index_t*)prv_index_find(lwobj, arr);
+    if (idx != NULL) {
+        return idx;
+    }
+    cnt = prv_index_count(lwobj, arr, LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS);
+    if (cnt == 0) {
+        return NULL;
+    }
+    idx = prv_index_alloc(lwobj, arr, cnt, sizeof(*elems));
+    if (idx == NULL) {
+        return NULL;
+    }
+    elems = (const lwjson_token_t**)(void*)(idx + 1);
+    for (const lwjson_token_t* t = lwjson_get_first_child(arr); t != NULL; t = lwjson_get_next(t)) {
+        *elems++ = t;
+    }
+    return idx;
+}
+
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+
+/**
+ * \brief           Get element of array by index
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       arr: Array token, not packed
+ * \param[in]       index: Index of the element
+ * \return          Element token or `NULL` if index is out of range
+ */
+static const lwjson_token_t*
+prv_array_get(lwjson_t* lwobj, const lwjson_token_t* arr, size_t index) {
+    const lwjson_token_t* tkn;
+#if LWJSON_CFG_ARRAY_INDEX
+    const lwjson_index_t* idx;
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+
+#if LWJSON_CFG_ARRAY_INDEX
+    idx = prv_array_index_get(lwobj, arr);
+    if (idx != NULL) {
+        return index < idx->size ? ((const lwjson_token_t* const*)(const void*)(idx + 1))[index] : NULL;
+    }
+#else
+    (void)lwobj;
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+
+    /* Start from beginning */
+    for (tkn = lwjson_get_first_child(arr); tkn != NULL && index > 0; tkn = lwjson_get_next(tkn), --index) {}
+    return tkn;
+}
+
+/**
+ * \brief           Input recursive function for find operation
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       rest: Path to search for starting this token further
+ * \return          Found token on success, `NULL` otherwise
+ */
+static const lwjson_token_t*
+prv_find(lwjson_t* lwobj, const lwjson_token_t* parent, const lwjson_find_rest_t* rest) {
+    const lwjson_path_segment_t* seg;
+    lwjson_path_segment_t segment;
+    lwjson_find_rest_t next = *rest;
+    size_t min_size = 0;
+    uint8_t is_last;
+
+    /* Get path segment */
+    if (rest->cpath != NULL) {
+        if (rest->seg >= rest->cpath->segments_cnt) {
+            return NULL;
+        }
+        seg = &rest->cpath->segments[next.seg++];
+        is_last = next.seg == rest->cpath->segments_cnt;
+        min_size = rest->cpath->segments_cnt - next.seg;
+    } else {
+        if (!prv_path_segment(&next.path, &segment, &is_last)) {
+            return NULL;
+        }
+        seg = &segment;
+
+        /* Every next segment is one level deeper, smaller subtrees cannot have a match */
+        if (!is_last) {
+            min_size = 1;
+            for (const char* p = next.path; *p != '\0'; ++p) {
+                min_size += *p == '.';
+            }
+        }
+    }
+
+    /* Check if detected an array request */
+    if (seg->key == NULL) {
+        /* Parent must be array */
+        if (parent->type != LWJSON_TYPE_ARRAY) {
+            return NULL;
+        }
+
+        /* Check if index requested */
+        if (seg->index != LWJSON_PATH_INDEX_ANY) {
+            const lwjson_token_t* tkn;
+
+            /* Values of packed array have no tokens */
+            if (prv_packed_hdr(parent) != NULL) {
+                return NULL;
+            }
+            tkn = prv_array_get(lwobj, parent, seg->index);
+            if (tkn != NULL) {
+                if (is_last) {
+                    return tkn;
+                } else if (lwjson_get_subtree_size(tkn) >= min_size) {
+                    return prv_find(lwobj, tkn, &next);
+                }
+            }
+            return NULL;
+        }
+
+        /* Scan all indexes and get first match */
+        for (const lwjson_token_t* tkn = lwjson_get_first_child(parent); tkn != NULL; tkn = lwjson_get_next(tkn)) {
+            const lwjson_token_t* tmp;
+
+            if (lwjson_get_subtree_size(tkn) < min_size) {
+                continue;
+            }
+            tmp = prv_find(lwobj, tkn, &next);
+            if (tmp != NULL) {
+                return tmp;
+            }
+        }
+    } else {
+        const lwjson_token_t* first;
+#if LWJSON_CFG_KEY_INDEX
+        const lwjson_index_t* idx;
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+        if (parent->type != LWJSON_TYPE_OBJECT) {
+            return NULL;
+        }
+        first = lwjson_get_first_child(parent);
+#if LWJSON_CFG_KEY_INDEX
+        /* Large object starts at the first member with the name, next ones are checked linearly */
+        idx = prv_index_get(lwobj, parent);
+        if (idx != NULL) {
+            first = prv_index_slot(lwobj, idx, seg->key, seg->key_len, seg->hash)->t;
+        }
+#endif /* LWJSON_CFG_KEY_INDEX */
+        for (const lwjson_token_t* tkn = first; tkn != NULL; tkn = lwjson_get_next(tkn)) {
+            size_t name_len;
+            const char* name = lwjson_get_token_name(lwobj, tkn, &name_len);
+
+            if (name != NULL && name_len == seg->key_len && !strncmp(name, seg->key, seg->key_len)) {
+                const lwjson_token_t* tmp;
+                if (is_last) {
+                    return tkn;
+                }
+                if (lwjson_get_subtree_size(tkn) < min_size) {
+                    continue;
+                }
+                tmp = prv_find(lwobj, tkn, &next);
+                if (tmp != NULL) {
+                    return tmp;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Actions for members of object or array in projected parsing */
+#define LWJSON_PROJ_SKIP  0 /*!< Member is not selected and is skipped without token */
+#define LWJSON_PROJ_ALL   1 /*!< Member is selected and is stored with all its children */
+#define LWJSON_PROJ_PATH  2 /*!< Member is parent of selected members and its children are checked further */
+#define LWJSON_PROJ_EMPTY 3 /*!< Member is stored without children, to keep indexes of next array members */
+
+/**
+ * \brief           Check if member of currently open object or array is selected by any projection path
+ * \param[in,out]   proj: Projection state. Index of next member at current level is advanced
+ * \param[in]       is_obj: Set to `1` when member belongs to object, `0` when it belongs to array
+ * \param[in]       name: Name of the object member. Not used for array members
+ * \param[in]       name_len: Length of the name in units of bytes
+ * \param[out]      mask: Output variable for paths, that continue in children of the member
+ * \return          Action for the member, one of `LWJSON_PROJ_*` values
+ */
+static uint8_t
+prv_proj_member(lwjson_proj_t* proj, uint8_t is_obj, const char* name, size_t name_len, uint32_t* mask) {
+    uint32_t live, index;
+    uint8_t action = LWJSON_PROJ_SKIP;
+
+    /* Everything is kept inside selected member */
+    if (proj->keep > 0) {
+        return LWJSON_PROJ_ALL;
+    }
+    live = proj->level[proj->depth].mask;
+    index = proj->level[proj->depth].index++;
+    *mask = 0;
+    proj->matched = 0;
+    for (size_t i = 0; live != 0; ++i, live >>= 1) {
+        const lwjson_proj_segment_t* seg;
+
+        if ((live & 0x01) == 0) {
+            continue;
+        }
+
+        /* Path has segment for current level, as all parents matched */
+        seg = &proj->segments[i][proj->depth];
+
+        /* Same rules as for find operation */
+        if (seg->index != LWJSON_PROJ_INDEX_KEY) {
+            if (is_obj) {
+                continue;
+            }
+            if (seg->index != LWJSON_PROJ_INDEX_ANY) {
+                if (seg->index > index) {
+                    /* Member is needed to keep index of selected member */
+                    if (action == LWJSON_PROJ_SKIP) {
+                        action = LWJSON_PROJ_EMPTY;
+                    }
+                    continue;
+                } else if (seg->index < index) {
+                    continue;
+                }
+            }
+        } else if (!is_obj || name_len != seg->len || strncmp(name, proj->paths[i] + seg->off, seg->len) != 0) {
+            continue;
+        }
+        if (proj->depth + 1 == proj->segments_cnt[i]) {
+            proj->matched |= (uint32_t)1 << i;
+            action = LWJSON_PROJ_ALL;
+        } else if (action != LWJSON_PROJ_ALL) {
+            *mask |= (uint32_t)1 << i;
+            action = LWJSON_PROJ_PATH;
+        }
+    }
+    return action;
+}
+
+/**
+ * \brief           Save token of the member, that is completely matched by projection paths
+ * \param[in,out]   proj: Projection state
+ * \param[in]       t: Token of the member
+ */
+static void
+prv_proj_found(lwjson_proj_t* proj, const lwjson_token_t* t) {
+    uint32_t matched = proj->matched;
+
+    for (size_t i = 0; matched != 0; ++i, matched >>= 1) {
+        if ((matched & 0x01) == 0) {
+            continue;
+        }
+        if (proj->found != NULL && proj->found[i] == NULL) {
+            proj->found[i] = t;
+        }
+
+        /* Find operation returns the first match only, next ones are not needed */
+        if (proj->early) {
+            for (size_t level = 0; level <= proj->depth; ++level) {
+                proj->level[level].mask &= ~((uint32_t)1 << i);
+            }
+            proj->left &= ~((uint32_t)1 << i);
+        }
+    }
+    proj->matched = 0;
+}
+
+/**
+ * \brief           Check for character after opening bracket of array or object
+ * \param[in,out]   pobj: JSON string
+ * \param[in]       type: Type of opened token, \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static inline lwjsonr_t
+prv_check_valid_char_after_open_bracket(lwjson_int_str_t* pobj, lwjson_type_t type) {
+    lwjsonr_t res;
+
+    /* Check next character after object open */
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (*pobj->p == '\0' || (type == LWJSON_TYPE_OBJECT && (*pobj->p != '"' && *pobj->p != '}'))
+        || (type == LWJSON_TYPE_ARRAY
+            && (*pobj->p != '"' && *pobj->p != ']' && *pobj->p != '[' && *pobj->p != '{' && *pobj->p != '-'
+                && (*pobj->p < '0' || *pobj->p > '9') && *pobj->p != 't' && *pobj->p != 'n' && *pobj->p != 'f'))) {
+        res = lwjsonERRJSON;
+    }
+    return res;
+}
+
+/**
+ * \brief           Setup LwJSON instance for parsing JSON strings
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       tokens: Pointer to array of tokens used for parsing.
+ *                      Can be set to `NULL` when \ref LWJSON_CFG_ALLOC is enabled,
+ *                      to allocate all tokens dynamically
+ * \param[in]       tokens_len: Number of tokens
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len) {
+    LWJSON_MEMSET(lwobj, 0x00, sizeof(*lwobj));
+    if (tokens != NULL) {
+        LWJSON_MEMSET(tokens, 0x00, sizeof(*tokens) * tokens_len);
+    } else {
+        tokens_len = 0;
+    }
+    lwobj->tokens = tokens;
+    lwobj->tokens_len = tokens_len;
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (tokens_len > 0) {
+        tokens[0].type = LWJSON_TYPE_OBJECT;
+    }
+#else
+    lwobj->first_token.type = LWJSON_TYPE_OBJECT;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Reset instance and create root token
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       pobj: Input string object
+ * \param[out]      pto: Output variable for root token
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_reset(lwjson_t* lwobj, const lwjson_int_str_t* pobj, lwjson_token_t** pto) {
+    lwjson_token_t* to;
+
+    /* values from very beginning */
+    lwobj->flags.parsed = 0;
+    lwobj->flags.insitu = pobj->insitu;
+    lwobj->flags.packed = pobj->packed;
+    lwobj->next_free_token_pos = 0;
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+    prv_index_reset(lwobj);
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+#if LWJSON_CFG_ALLOC
+    lwobj->block = NULL;
+    lwobj->block_pos = 0;
+#endif /* LWJSON_CFG_ALLOC */
+
+    /* set first token */
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (pobj->len > UINT32_MAX) {
+        return lwjsonERRPAR;
+    }
+    lwobj->json_data = pobj->start;
+    to = prv_alloc_token(lwobj);
+    if (to == NULL) {
+        return lwjsonERRMEM;
+    }
+#else
+    (void)pobj;
+    to = &lwobj->first_token;
+    LWJSON_MEMSET(to, 0x00, sizeof(*to));
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    *pto = to;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Reset instance and parse opening bracket of the root object or array
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object, set to the beginning of JSON data
+ * \param[out]      pto: Output variable for root token
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_root(lwjson_t* lwobj, lwjson_int_str_t* pobj, lwjson_token_t** pto) {
+    lwjsonr_t res;
+    lwjson_token_t* to;
+
+    res = prv_parse_reset(lwobj, pobj, pto);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    to = *pto;
+
+    /* First parse */
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (*pobj->p == '{') {
+        to->type = LWJSON_TYPE_OBJECT;
+    } else if (*pobj->p == '[') {
+        to->type = LWJSON_TYPE_ARRAY;
+    } else {
+        return lwjsonERRJSON;
+    }
+    ++pobj->p;
+    return prv_check_valid_char_after_open_bracket(pobj, to->type);
+}
+
+/**
+ * \brief           Scan one value without writing any tokens
+ *
+ * Function follows the same rules as \ref prv_parse_tokens, but keeps only
+ * one bit per nesting level, to know if currently open token is object or array.
+ * Primitive value must be followed by separator or closing bracket, that is skipped
+ * in case of comma separator.
+ *
+ * \param[in,out]   pobj: Input string object, set to the first character of the value
+ * \param[out]      count: Output variable for number of tokens inside the value, excluding the value itself
+ * \param[out]      max_depth: Output variable for maximal nesting depth, relative to the value
+ * \return          \ref lwjsonOK on success, \ref lwjsonPARSEINPROG when input ends
+ *                      with only the value object or array left open, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_scan_value(lwjson_int_str_t* pobj, size_t* count, size_t* max_depth) {
+    uint32_t stack[(LWJSON_CFG_MAX_DEPTH + 31) / 32]; /* Bit is set when object is open at that level */
+    size_t depth = 0, cnt = 0, depth_max = 0;
+    lwjsonr_t res = lwjsonOK;
+    uint8_t is_obj, is_open;
+
+    while (1) {
+        /* Check next character to process */
+        is_open = 0;
+        switch (*pobj->p) {
+            case '{':
+            case '[':
+                is_obj = *pobj->p == '{';
+                is_open = 1;
+                ++pobj->p;
+                res = prv_check_valid_char_after_open_bracket(pobj, is_obj ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+                if (depth >= LWJSON_CFG_MAX_DEPTH) {
+                    return lwjsonERRMEM;
+                }
+                if (is_obj) {
+                    stack[depth / 32] |= (uint32_t)1 << (depth % 32);
+                } else {
+                    stack[depth / 32] &= ~((uint32_t)1 << (depth % 32));
+                }
+                if (++depth > depth_max) {
+                    depth_max = depth;
+                }
+                break;
+            case '"': {
+                const char* str;
+                size_t str_len;
+
+                res = prv_parse_string(pobj, &str, &str_len);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+                break;
+            }
+            case 't':
+                if (strncmp(pobj->p, "true", 4) != 0) {
+                    return lwjsonERRJSON;
+                }
+                pobj->p += 4;
+                break;
+            case 'f':
+                if (strncmp(pobj->p, "false", 5) != 0) {
+                    return lwjsonERRJSON;
+                }
+                pobj->p += 5;
+                break;
+            case 'n':
+                if (strncmp(pobj->p, "null", 4) != 0) {
+                    return lwjsonERRJSON;
+                }
+                pobj->p += 4;
+                break;
+            default:
+                if (*pobj->p == '-' || (*pobj->p >= '0' && *pobj->p <= '9')) {
+                    lwjson_type_t type;
+
+                    res = prv_skip_number(pobj, &type);
+                    if (res != lwjsonOK) {
+                        return res;
+                    }
+                } else {
+                    return lwjsonERRJSON;
+                }
+                break;
+        }
+
+        /* Check characters after valid primitive */
+        if (!is_open) {
+            res = prv_skip_blank(pobj);
+            if (res != lwjsonOK) {
+                return res;
+            }
+            if (pobj->p == NULL || *pobj->p == '\0' || (*pobj->p != ',' && *pobj->p != ']' && *pobj->p != '}')) {
+                return lwjsonERRJSON;
+            } else if (*pobj->p == ',') {
+                ++pobj->p;
+            }
+        }
+
+        /* Find next value, while closing finished objects and arrays */
+        while (depth > 0) {
+            if (pobj->p == NULL || *pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
+                res = depth > 1 ? lwjsonERRJSON : lwjsonPARSEINPROG;
+                break;
+            }
+
+            /* Filter out blanks */
+            res = prv_skip_blank(pobj);
+            if (res != lwjsonOK) {
+                return res;
+            }
+            if (*pobj->p == ',') {
+                ++pobj->p;
+                continue;
+            }
+
+            /* Check if end of object or array */
+            is_obj = (stack[(depth - 1) / 32] >> ((depth - 1) % 32)) & 0x01;
+            if (*pobj->p == (is_obj ? '}' : ']')) {
+                ++pobj->p;
+                --depth;
+                continue;
+            }
+            ++cnt;
+
+            /* Objects have property name first */
+            if (is_obj) {
+                const char* name;
+                size_t name_len;
+
+                if (*pobj->p != '"') {
+                    return lwjsonERRJSON;
+                }
+                res = prv_parse_property_name(pobj, &name, &name_len);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+            }
+            break;
+        }
+        if (depth == 0 || res != lwjsonOK) {
+            break;
+        }
+    }
+    if (res == lwjsonOK || res == lwjsonPARSEINPROG) {
+        *count = cnt;
+        *max_depth = depth_max;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse primitive value to the token
+ * \param[in,out]   pobj: Input string object, set to the first character of the value
+ * \param[out]      t: Token to set type and value to
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static inline lwjsonr_t
+prv_parse_primitive(lwjson_int_str_t* pobj, lwjson_token_t* t) {
+    lwjsonr_t res = lwjsonOK;
+
+    switch (*pobj->p) {
+        case '"': {
+            const char* str;
+            size_t str_len;
+
+            res = prv_parse_string(pobj, &str, &str_len);
+            if (res == lwjsonOK) {
+                prv_token_set_string(pobj, t, str, str_len);
+                t->type = LWJSON_TYPE_STRING;
+            }
+            break;
+        }
+        case 't':
+            /* RFC4627 is lower-case only */
+            if (strncmp(pobj->p, "true", 4) == 0) {
+                t->type = LWJSON_TYPE_TRUE;
+                pobj->p += 4;
+            } else {
+                res = lwjsonERRJSON;
+            }
+            break;
+        case 'f':
+            /* RFC4627 is lower-case only */
+            if (strncmp(pobj->p, "false", 5) == 0) {
+                t->type = LWJSON_TYPE_FALSE;
+                pobj->p += 5;
+            } else {
+                res = lwjsonERRJSON;
+            }
+            break;
+        case 'n':
+            /* RFC4627 is lower-case only */
+            if (strncmp(pobj->p, "null", 4) == 0) {
+                t->type = LWJSON_TYPE_NULL;
+                pobj->p += 4;
+            } else {
+                res = lwjsonERRJSON;
+            }
+            break;
+        default:
+            if (*pobj->p == '-' || (*pobj->p >= '0' && *pobj->p <= '9')) {
+                lwjson_type_t type;
+#if LWJSON_CFG_LAZY_NUMBERS
+                const char* num = pobj->p;
+
+                /* Keep number text in string value, it is converted when requested */
+                res = prv_skip_number(pobj, &type);
+                if (res == lwjsonOK) {
+                    prv_token_set_string(pobj, t, num, (size_t)(pobj->p - num));
+                    t->type = type;
+                }
+#else
+                res = prv_parse_number(pobj, &type, &t->u.num_real, &t->u.num_int);
+                if (res == lwjsonOK) {
+                    t->type = type;
+                }
+#endif /* LWJSON_CFG_LAZY_NUMBERS */
+            } else {
+                res = lwjsonERRJSON;
+            }
+            break;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse tokens until root object or array is closed
+ *
+ * Parsing stops at the beginning of the next token, when input ends or token limit is reached.
+ * Object and array tokens, that are not closed yet, keep their parent in the token itself,
+ * so parsing can continue with the same state later.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object
+ * \param[in,out]   pto: Currently open object or array token
+ * \param[in,out]   ptail: Last child of currently open object or array, or `NULL` if it has no children yet
+ * \param[in]       max_tokens: Max number of new tokens to parse. Set to `0` for no limit
+ * \param[in]       ext: Set to `1` to support projection, token limit, packed arrays, fragments and multiple
+ *                      documents, `0` for plain parsing. Function is inlined with constant value,
+ *                      so plain parsing has no checks for these features
+ * \return          \ref lwjsonOK when root is closed, \ref lwjsonPARSEINPROG when input ends
+ *                      or token limit is reached, member of \ref lwjsonr_t otherwise
+ */
+static LWJSON_FORCE_INLINE lwjsonr_t
+prv_parse_tokens_int(lwjson_t* lwobj, lwjson_int_str_t* pobj, lwjson_token_t** pto, lwjson_token_t** ptail,
+                     size_t max_tokens, uint8_t ext) {
+    lwjsonr_t res = lwjsonOK;
+    lwjson_token_t *t, *to = *pto, *tail = *ptail;
+    size_t tokens_end = lwobj->next_free_token_pos + max_tokens;
+    const char* name = NULL;
+    size_t name_len = 0;
+    uint32_t mask = 0;
+    uint8_t action = LWJSON_PROJ_ALL;
+
+    /* Process all characters as indicated by input user */
+    while (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
+        /* All paths are found and their values are complete */
+        if (ext && pobj->proj != NULL && pobj->proj->early && pobj->proj->left == 0 && pobj->proj->keep == 0) {
+            res = lwjsonPARSEPARTIAL;
+            goto ret;
+        }
+
+        /* Filter out blanks */
+        res = prv_skip_blank(pobj);
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+        if (*pobj->p == ',') {
+            ++pobj->p;
+            continue;
+        }
+
+        /* Check if end of object or array*/
+        if (*pobj->p == (to->type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
+            lwjson_token_t* parent = prv_token_close(lwobj, to);
+            ++pobj->p;
+            if (ext && pobj->proj != NULL) {
+                if (pobj->proj->keep > 0) {
+                    --pobj->proj->keep;
+                } else if (pobj->proj->depth > 0) {
+                    --pobj->proj->depth;
+                }
+            }
+
+            /* Closed object or array is the last child of its parent */
+            tail = to;
+
+            /* End of string if to == NULL (no parent), check if properly terminated */
+            to = parent;
+            if (to == NULL) {
+                /* Next document may follow immediately, it is parsed with next call */
+                if (ext && pobj->multi) {
+                    res = lwjsonOK;
+                    goto ret;
+                }
+                prv_skip_blank(pobj);
+                res = (pobj->p == NULL || *pobj->p == '\0' || (size_t)(pobj->p - pobj->start) == pobj->len)
+                          ? lwjsonOK
+                          : lwjsonERR;
+                goto ret;
+            }
+            continue;
+        }
+
+        /* Allocate new token */
+        if (ext && max_tokens > 0 && lwobj->next_free_token_pos >= tokens_end) {
+            res = lwjsonPARSEINPROG;
+            goto ret;
+        }
+
+        /* If object type is not array, first thing is property that starts with quotes */
+        if (to->type != LWJSON_TYPE_ARRAY) {
+            if (*pobj->p != '"') {
+                res = lwjsonERRJSON;
+                goto ret;
+            }
+            res = prv_parse_property_name(pobj, &name, &name_len);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+        }
+
+        /* Members, that are not selected by projection, are only checked */
+        if (ext && pobj->proj != NULL) {
+            action = prv_proj_member(pobj->proj, to->type != LWJSON_TYPE_ARRAY, name, name_len, &mask);
+            if (action == LWJSON_PROJ_SKIP
+                || (action == LWJSON_PROJ_PATH && to->type != LWJSON_TYPE_ARRAY && *pobj->p != '{'
+                    && *pobj->p != '[')) {
+                size_t cnt, depth;
+
+                res = prv_scan_value(pobj, &cnt, &depth);
+                if (res != lwjsonOK) {
+                    res = res == lwjsonPARSEINPROG ? lwjsonERRJSON : res;
+                    goto ret;
+                }
+                continue;
+            }
+        }
+
+        t = prv_alloc_token(lwobj);
+        if (t == NULL) {
+            res = lwjsonERRMEM;
+            goto ret;
+        }
+        if (to->type != LWJSON_TYPE_ARRAY) {
+            res = prv_token_set_name(pobj, t, name, name_len);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+        }
+        if (ext && pobj->proj != NULL && pobj->proj->matched != 0) {
+            prv_proj_found(pobj->proj, t);
+        }
+
+        /*
+         * Add element to linked list
+         *
+         * Tail always points to the last child of currently open object or array,
+         * or is set to NULL if object or array has no children yet
+         */
+        prv_token_append(to, tail, t);
+        tail = t;
+
+        /* Object or array, that only keeps index of next array members, has no children */
+        if (ext && action == LWJSON_PROJ_EMPTY && (*pobj->p == '{' || *pobj->p == '[')) {
+            size_t cnt, depth;
+
+            t->type = *pobj->p == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
+            res = prv_scan_value(pobj, &cnt, &depth);
+            if (res != lwjsonOK) {
+                res = res == lwjsonPARSEINPROG ? lwjsonERRJSON : res;
+                goto ret;
+            }
+            continue;
+        }
+
+        /* Check next character to process */
+        switch (*pobj->p) {
+            case '{':
+            case '[':
+                t->type = *pobj->p == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
+                ++pobj->p;
+
+                res = prv_check_valid_char_after_open_bracket(pobj, t->type);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+#if LWJSON_CFG_PACKED_ARRAYS
+                /* Array of primitive values of the same type is stored without children tokens */
+                if (t->type == LWJSON_TYPE_ARRAY && ext && pobj->packed && prv_parse_packed(lwobj, pobj, t)) {
+                    break;
+                }
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+                prv_token_open(lwobj, t, to);
+                to = t;
+                tail = NULL;
+                if (ext && pobj->proj != NULL) {
+                    if (action == LWJSON_PROJ_ALL) {
+                        ++pobj->proj->keep;
+                    } else {
+                        ++pobj->proj->depth;
+                        pobj->proj->level[pobj->proj->depth].mask = mask;
+                        pobj->proj->level[pobj->proj->depth].index = 0;
+                    }
+                }
+                break;
+            default:
+                res = prv_parse_primitive(pobj, t);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                break;
+        }
+
+        /* Below code is used to check characters after valid tokens */
+        if (t->type == LWJSON_TYPE_ARRAY || t->type == LWJSON_TYPE_OBJECT) {
+            continue;
+        }
+
+        /*
+         * Check what are values after the token value
+         *
+         * As per RFC4627, every token value may have one or more
+         * blank characters, followed by one of below options:
+         *  - Comma separator for next token
+         *  - End of array indication
+         *  - End of object indication
+         */
+        res = prv_skip_blank(pobj);
+        if (res != lwjsonOK) {
+            /* Fragment may end with value of the member */
+            if (ext && pobj->fragment && (size_t)(pobj->p - pobj->start) == pobj->len) {
+                break;
+            }
+            goto ret;
+        }
+        /* Check if valid string is availabe after */
+        if (pobj->p == NULL || *pobj->p == '\0' || (*pobj->p != ',' && *pobj->p != ']' && *pobj->p != '}')) {
+            res = lwjsonERRJSON;
+            goto ret;
+        } else if (*pobj->p == ',') { /* Check to advance to next token immediatey */
+            ++pobj->p;
+        }
+    }
+    res = lwjsonPARSEINPROG;
+ret:
+    *pto = to;
+    *ptail = tail;
+    return res;
+}
+
+/**
+ * \brief           Parse tokens until root object or array is closed, with all parsing features
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object
+ * \param[in,out]   pto: Currently open object or array token
+ * \param[in,out]   ptail: Last child of currently open object or array, or `NULL` if it has no children yet
+ * \param[in]       max_tokens: Max number of new tokens to parse. Set to `0` for no limit
+ * \return          Same as \ref prv_parse_tokens_int
+ */
+static lwjsonr_t
+prv_parse_tokens(lwjson_t* lwobj, lwjson_int_str_t* pobj, lwjson_token_t** pto, lwjson_token_t** ptail,
+                 size_t max_tokens) {
+    return prv_parse_tokens_int(lwobj, pobj, pto, ptail, max_tokens, 1);
+}
+
+/**
+ * \brief           Parse tokens of complete single document, without projection and packed arrays
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object
+ * \param[in,out]   pto: Currently open object or array token
+ * \param[in,out]   ptail: Last child of currently open object or array, or `NULL` if it has no children yet
+ * \return          Same as \ref prv_parse_tokens_int
+ */
+static lwjsonr_t
+prv_parse_tokens_plain(lwjson_t* lwobj, lwjson_int_str_t* pobj, lwjson_token_t** pto, lwjson_token_t** ptail) {
+    return prv_parse_tokens_int(lwobj, pobj, pto, ptail, 0, 0);
+}
+
+/**
+ * \brief           Parse complete JSON input to the tokens
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   pobj: Input string object, set to the beginning of JSON data
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse(lwjson_t* lwobj, lwjson_int_str_t* pobj) {
+    lwjsonr_t res;
+    lwjson_token_t *to, *root, *tail = NULL;
+
+    res = prv_parse_root(lwobj, pobj, &root);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    to = root;
+    if (pobj->proj == NULL && !pobj->packed && !pobj->multi && !pobj->fragment) {
+        res = prv_parse_tokens_plain(lwobj, pobj, &to, &tail);
+    } else {
+        res = prv_parse_tokens(lwobj, pobj, &to, &tail, 0);
+    }
+
+    /* Input ended, only root object or array of the last document may be left open */
+    if (res == lwjsonPARSEINPROG) {
+        res = to == root && !pobj->multi ? lwjsonOK : lwjsonERRJSON;
+    } else if (res == lwjsonPARSEPARTIAL) {
+        /* Rest of the data is not needed, finish objects and arrays, that are still open */
+        while (to != NULL) {
+            to = prv_token_close(lwobj, to);
+        }
+    }
+    if (res == lwjsonOK || res == lwjsonPARSEPARTIAL) {
+        lwobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Scan complete JSON input without writing any tokens
+ *
+ * Function follows the same rules as \ref prv_parse, including root object or array,
+ * that is left open at the end of input.
+ *
+ * \param[in,out]   pobj: Input string object, set to the beginning of JSON data
+ * \param[out]      count: Output variable for number of tokens, excluding root token
+ * \param[out]      max_depth: Output variable for maximal nesting depth
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_scan(lwjson_int_str_t* pobj, size_t* count, size_t* max_depth) {
+    size_t cnt, depth;
+    lwjsonr_t res;
+
+    /* First parse */
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (*pobj->p != '{' && *pobj->p != '[') {
+        return lwjsonERRJSON;
+    }
+    res = prv_scan_value(pobj, &cnt, &depth);
+    if (res == lwjsonOK) {
+        /* Root is closed, check if properly terminated */
+        prv_skip_blank(pobj);
+        res = (pobj->p == NULL || *pobj->p == '\0' || (size_t)(pobj->p - pobj->start) == pobj->len) ? lwjsonOK
+                                                                                                     : lwjsonERR;
+    } else if (res == lwjsonPARSEINPROG) {
+        res = lwjsonOK;
+    }
+    if (res == lwjsonOK) {
+        if (count != NULL) {
+            *count = cnt;
+        }
+        if (max_depth != NULL) {
+            *max_depth = depth;
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse JSON data with length parameter
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON string to parse
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, &pobj);
+}
+
+/**
+ * \brief           Parse JSON data, followed by readable padding bytes
+ *
+ * Application guarantees that \ref LWJSON_CFG_PADDING_LEN bytes after `json_len` are readable
+ * and that the first of them is set to `0`. Parser then uses `NULL` termination
+ * as the only end-of-input check when scanning blanks and strings,
+ * instead of checking input length for every character.
+ *
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse, followed by padding bytes
+ * \param[in]       json_len: JSON data length, excluding padding bytes
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_padded(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data, .padded = 1};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0 || ((const char*)json_data)[json_len] != '\0') {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, &pobj);
+}
+
+/**
+ * \brief           Parse JSON data in writable buffer and decode strings in place
+ *
+ * Escape sequences in strings and object keys, including `\uXXXX` sequences and surrogate pairs,
+ * are decoded to UTF-8 directly in the input buffer.
+ * Tokens then point to decoded text, ready to use without any further processing.
+ * Decoded strings are not `NULL` terminated, use their length instead.
+ *
+ * \note            Input buffer is modified, even if parsing fails
+ * \note            Unpaired surrogate escape sequence is treated as invalid JSON
+ *
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   json_data: JSON data to parse and decode
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_insitu(lwjson_t* lwobj, void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data, .insitu = 1};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, &pobj);
+}
+
+#if LWJSON_CFG_PACKED_ARRAYS || __DOXYGEN__
+
+/**
+ * \brief           Parse JSON data and pack arrays of primitive values
+ *
+ * Array with only integer numbers, only real numbers or only `true` and `false` values
+ * is stored as single array token, followed by its values, when they take fewer tokens than one token per value.
+ * Such array has no children tokens, see \ref LWJSON_CFG_PACKED_ARRAYS for functions to access its values.
+ *
+ * JSON format must be complete and must comply with RFC4627
+ * \note            Used only when \ref LWJSON_CFG_PACKED_ARRAYS is enabled
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_packed(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data, .packed = 1};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, &pobj);
+}
+
+#endif /* LWJSON_CFG_PACKED_ARRAYS || __DOXYGEN__ */
+
+/**
+ * \brief           Parse JSON data to tokens of the previous document with the same shape
+ *
+ * Tokens are visited in document order and only their names and values are rewritten.
+ * New data must have the same objects and arrays with the same number of members,
+ * primitive values may change their type.
+ *
+ * \param[in,out]   lwobj: LwJSON instance with previous document parsed
+ * \param[in,out]   pobj: Input string object, set to the beginning of JSON data
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t when shape is different
+ *                      or data is invalid. Tokens are not valid anymore in this case
+ */
+static lwjsonr_t
+prv_parse_shaped(lwjson_t* lwobj, lwjson_int_str_t* pobj) {
+    lwjson_token_t* stack[LWJSON_CFG_MAX_DEPTH]; /* Parents of currently open object or array */
+    lwjson_token_t *to, *t;
+    size_t depth = 0;
+    lwjsonr_t res;
+#if LWJSON_CFG_COMPACT_TOKENS
+    const char* prev_data = lwobj->json_data;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+
+    to = (lwjson_token_t*)lwjson_get_first_token(lwobj);
+    lwobj->flags.parsed = 0;
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+    prv_index_reset(lwobj);
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+#if LWJSON_CFG_COMPACT_TOKENS
+    if (pobj->len > UINT32_MAX) {
+        return lwjsonERRPAR;
+    }
+    lwobj->json_data = pobj->start;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK || *pobj->p != (to->type == LWJSON_TYPE_OBJECT ? '{' : '[')) {
+        return lwjsonERRJSON;
+    }
+    ++pobj->p;
+
+    for (t = (lwjson_token_t*)lwjson_get_first_child(to);;) {
+        res = prv_skip_blank(pobj);
+        if (res != lwjsonOK) {
+            return res;
+        }
+        if (t == NULL) {
+            /* All members are parsed, object or array must be closed */
+            if (*pobj->p != (to->type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
+                return lwjsonERRJSON;
+            }
+            ++pobj->p;
+            if (depth == 0) {
+                break;
+            }
+#if LWJSON_CFG_PACKED_ARRAYS
+            /* Array, that is packed with new values, is not the same shape */
+            if (lwobj->flags.packed && to->type == LWJSON_TYPE_ARRAY && prv_packed_check(to)) {
+                return lwjsonERRJSON;
+            }
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+            t = to;
+            to = stack[--depth];
+        } else {
+            if (to->type == LWJSON_TYPE_OBJECT) {
+                const char* name;
+                size_t name_len = t->token_name_len;
+
+#if LWJSON_CFG_COMPACT_TOKENS
+                name = prev_data + t->token_name;
+#else
+                name = t->token_name;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+                if (*pobj->p != '"') {
+                    return lwjsonERRJSON;
+                }
+
+                /*
+                 * Key with the same raw bytes as the key of previous document is valid
+                 * and is not parsed again. Previous key is used only when it is not decoded in place
+                 * and when it is not in the memory of new data, that may have overwritten it
+                 */
+                if (!lwobj->flags.insitu
+                    && (name + name_len <= pobj->start || name >= pobj->start + pobj->len)
+                    && name_len + 1 < pobj->len - (size_t)(pobj->p - pobj->start) && pobj->p[name_len + 1] == '"'
+                    && memcmp(pobj->p + 1, name, name_len) == 0) {
+                    name = pobj->p + 1;
+                    pobj->p += name_len + 2;
+                    res = prv_parse_name_separator(pobj);
+                } else {
+                    res = prv_parse_property_name(pobj, &name, &name_len);
+                }
+                if (res != lwjsonOK) {
+                    return res;
+                }
+                res = prv_token_set_name(pobj, t, name, name_len);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+            }
+            if (t->type == LWJSON_TYPE_OBJECT || t->type == LWJSON_TYPE_ARRAY) {
+                if (*pobj->p != (t->type == LWJSON_TYPE_OBJECT ? '{' : '[')) {
+                    return lwjsonERRJSON;
+                }
+                ++pobj->p;
+#if LWJSON_CFG_PACKED_ARRAYS
+                /* Packed array is parsed again to the same tokens */
+                if (prv_packed_hdr(t) != NULL) {
+                    size_t pos = lwobj->next_free_token_pos, size = lwjson_get_subtree_size(t);
+                    uint8_t packed;
+
+                    lwobj->next_free_token_pos = (size_t)(t - lwobj->tokens) + 1;
+                    packed = prv_parse_packed(lwobj, pobj, t) && lwjson_get_subtree_size(t) == size;
+                    lwobj->next_free_token_pos = pos;
+                    if (!packed) {
+                        return lwjsonERRJSON;
+                    }
+                } else
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+                {
+                    if (depth >= LWJSON_ARRAYSIZE(stack)) {
+                        return lwjsonERRMEM;
+                    }
+                    stack[depth++] = to;
+                    to = t;
+                    t = (lwjson_token_t*)lwjson_get_first_child(t);
+                    continue;
+                }
+            } else {
+                if (*pobj->p == '{' || *pobj->p == '[') {
+                    return lwjsonERRJSON;
+                }
+                res = prv_parse_primitive(pobj, t);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+            }
+        }
+
+        /* Value must be followed by separator, when it is not the last member. Last one may have it too */
+        res = prv_skip_blank(pobj);
+        if (res != lwjsonOK) {
+            return res;
+        }
+        if (*pobj->p == ',') {
+            ++pobj->p;
+        } else if (lwjson_get_next(t) != NULL) {
+            return lwjsonERRJSON;
+        }
+        t = (lwjson_token_t*)lwjson_get_next(t);
+    }
+
+    /* Nothing else than blank characters may follow */
+    prv_skip_blank(pobj);
+    if (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
+        return lwjsonERR;
+    }
+    lwobj->flags.parsed = 1;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Parse JSON data with the same structure as previously parsed document
+ *
+ * When instance holds successfully parsed document, tokens are reused as template
+ * and only names and values are rewritten from the new data, without allocating and linking the tokens.
+ * Data must have the same objects and arrays, with the same number of members, in the same order.
+ * Primitive values and names may be different.
+ * When structure is different, data is parsed again as with \ref lwjson_parse_ex function,
+ * or as with \ref lwjson_parse_packed function when previous document was parsed with it.
+ *
+ * Names and values are always taken from the new data, so the result is the same as with full parsing.
+ * Arrays are packed only when the same arrays are packed by full parsing of new data.
+ *
+ * Keys, that have the same bytes as the keys of previous document, are only compared and not parsed again.
+ * Previous data must therefore stay readable and unchanged until function returns,
+ * except for the part overwritten by new data, when new data is placed to the same buffer.
+ * Keys, that are in the memory of new data, are always parsed again.
+ *
+ * \note            Function uses array of \ref LWJSON_CFG_MAX_DEPTH token pointers on the stack,
+ *                      that is `2` kB with default options on 64-bit targets
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_shaped(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    if (lwobj->flags.parsed) {
+        if (prv_parse_shaped(lwobj, &pobj) == lwjsonOK) {
+            return lwjsonOK;
+        }
+        pobj.p = json_data;
+    }
+
+    /* Arrays are packed the same way as in previous document */
+    pobj.packed = lwobj->flags.packed;
+    return prv_parse(lwobj, &pobj);
+}
+
+/**
+ * \brief           Parse JSON data and store only tokens, selected by the paths
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in]       paths: Array of paths to select
+ * \param[in]       paths_cnt: Number of paths
+ * \param[out]      found: Output array for the first token found for every path, or `NULL`
+ * \param[in]       early: Set to `1` to stop parsing once all paths are found
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_projected(lwjson_t* lwobj, const void* json_data, size_t json_len, const char* const* paths,
+                    size_t paths_cnt, const lwjson_token_t** found, uint8_t early) {
+    lwjson_proj_t proj = {.paths = paths, .found = found, .early = early};
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data, .proj = &proj};
+    uint32_t mask;
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0 || paths == NULL || paths_cnt == 0
+        || paths_cnt > LWJSON_PROJ_MAX_PATHS) {
+        return lwjsonERRPAR;
+    }
+    mask = UINT32_MAX >> (32U - (uint32_t)paths_cnt); /* One bit for every path */
+    proj.level[0].mask = mask;
+    for (size_t i = 0; i < paths_cnt; ++i) {
+        const char* path = paths[i];
+        lwjson_path_segment_t seg;
+        size_t segments = 0;
+        uint8_t is_last = 0, valid = 1;
+
+        if (path == NULL) {
+            return lwjsonERRPAR;
+        }
+        if (found != NULL) {
+            found[i] = NULL;
+        }
+
+        /* Compile path once, invalid path is not found the same as with find operation */
+        while (!is_last) {
+            if (!prv_path_segment(&path, &seg, &is_last)) {
+                valid = 0;
+                break;
+            }
+            if (segments >= LWJSON_CFG_MAX_PATH_SEGMENTS
+                || (seg.key != NULL && (size_t)(seg.key + seg.key_len - paths[i]) > UINT16_MAX)) {
+                return lwjsonERRPAR;
+            }
+            if (seg.key != NULL) {
+                proj.segments[i][segments].index = LWJSON_PROJ_INDEX_KEY;
+                proj.segments[i][segments].off = (uint16_t)(seg.key - paths[i]);
+                proj.segments[i][segments].len = (uint16_t)seg.key_len;
+            } else if (seg.index == LWJSON_PATH_INDEX_ANY) {
+                proj.segments[i][segments].index = LWJSON_PROJ_INDEX_ANY;
+            } else if (seg.index < LWJSON_PROJ_INDEX_ANY) {
+                /* Members are counted with 32-bit index, larger index is never found */
+                proj.segments[i][segments].index = (uint32_t)seg.index;
+            } else {
+                valid = 0;
+            }
+            ++segments;
+        }
+        if (!valid) {
+            proj.level[0].mask &= ~((uint32_t)1 << i);
+        }
+        proj.segments_cnt[i] = (uint8_t)segments;
+    }
+    proj.left = mask;
+    return prv_parse(lwobj, &pobj);
+}
+
+/**
+ * \brief           Parse JSON data and store only tokens, selected by the paths
+ *
+ * Paths use the same format as in \ref lwjson_find function.
+ * Selected members are stored with all their children, together with all their parents.
+ * Other members are only checked to be valid JSON, without using any tokens,
+ * so token array can be sized for selected data instead of complete JSON data.
+ *
+ * Array members before the member, selected with `#N` segment, are stored without children,
+ * to keep the same indexes as in complete JSON data.
+ *
+ * JSON format must be complete and must comply with RFC4627
+ *
+ * \note            Compiled paths take `8 * LWJSON_PROJ_MAX_PATHS * LWJSON_CFG_MAX_PATH_SEGMENTS` bytes
+ *                      of stack memory, about `4.3` kB with default options
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in]       paths: Array of paths to select. Every path has up to \ref LWJSON_CFG_MAX_PATH_SEGMENTS segments
+ *                      and up to `65535` characters. Paths are compiled once, before parsing starts
+ * \param[in]       paths_cnt: Number of paths, up to \ref LWJSON_PROJ_MAX_PATHS
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_projected(lwjson_t* lwobj, const void* json_data, size_t json_len, const char* const* paths,
+                       size_t paths_cnt) {
+    return prv_parse_projected(lwobj, json_data, json_len, paths, paths_cnt, NULL, 0);
+}
+
+/**
+ * \brief           Parse JSON data only until all paths are found
+ *
+ * Tokens are stored the same way as with \ref lwjson_parse_projected function.
+ * Once the value of the last path is complete, parsing stops and the rest of the data is not checked.
+ * Only the first match of every path is stored, that is the same token as \ref lwjson_find returns.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in]       paths: Array of paths to find. Every path has up to \ref LWJSON_CFG_MAX_PATH_SEGMENTS segments
+ * \param[in]       paths_cnt: Number of paths, up to \ref LWJSON_PROJ_MAX_PATHS
+ * \param[out]      found: Output array of `paths_cnt` tokens, set to the token found for every path
+ *                      or to `NULL` if path is not found. Can be set to `NULL` if not used
+ * \return          \ref lwjsonPARSEPARTIAL when all paths are found before the end of data,
+ *                      \ref lwjsonOK when complete data is parsed, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_until_found(lwjson_t* lwobj, const void* json_data, size_t json_len, const char* const* paths,
+                         size_t paths_cnt, const lwjson_token_t** found) {
+    return prv_parse_projected(lwobj, json_data, json_len, paths, paths_cnt, found, 1);
+}
+
+#if LWJSON_CFG_PARSE_RESUME
+
+/* States of the scanner, looking for the end of complete values */
+#define LWJSON_RESUME_SCAN_VALUE        0 /*!< Outside of string */
+#define LWJSON_RESUME_SCAN_STRING       1 /*!< Inside of string */
+#define LWJSON_RESUME_SCAN_ESCAPE       2 /*!< After backslash inside of string */
+#define LWJSON_RESUME_SCAN_COMMENT_OPEN 3 /*!< After `/` character, outside of string */
+#define LWJSON_RESUME_SCAN_COMMENT      4 /*!< Inside of comment */
+#define LWJSON_RESUME_SCAN_COMMENT_STAR 5 /*!< After `*` character inside of comment */
+
+/**
+ * \brief           Scan newly received data for the last `,`, `]` or `}` character outside of strings
+ *
+ * All values before such character are complete and can be parsed without reading further.
+ * Scanner state is kept between calls, so every character is scanned only once.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       data: JSON data
+ * \param[in]       len: Length of received JSON data
+ */
+static void
+prv_resume_scan(lwjson_t* lwobj, const char* data, size_t len) {
+    uint8_t state = lwobj->resume.scan_state;
+
+    for (size_t i = lwobj->resume.scan_pos; i < len; ++i) {
+        switch (state) {
+            case LWJSON_RESUME_SCAN_VALUE:
+                if (data[i] == '"') {
+                    state = LWJSON_RESUME_SCAN_STRING;
+                } else if (data[i] == ',' || data[i] == ']' || data[i] == '}') {
+                    lwobj->resume.safe_len = i + 1;
+#if LWJSON_CFG_COMMENTS
+                } else if (data[i] == '/') {
+                    state = LWJSON_RESUME_SCAN_COMMENT_OPEN;
+#endif /* LWJSON_CFG_COMMENTS */
+                }
+                break;
+            case LWJSON_RESUME_SCAN_STRING:
+                if (data[i] == '\\') {
+                    state = LWJSON_RESUME_SCAN_ESCAPE;
+                } else if (data[i] == '"') {
+                    state = LWJSON_RESUME_SCAN_VALUE;
+                }
+                break;
+            case LWJSON_RESUME_SCAN_ESCAPE: state = LWJSON_RESUME_SCAN_STRING; break;
+#if LWJSON_CFG_COMMENTS
+            case LWJSON_RESUME_SCAN_COMMENT_OPEN:
+                state = data[i] == '*' ? LWJSON_RESUME_SCAN_COMMENT : LWJSON_RESUME_SCAN_VALUE;
+                break;
+            case LWJSON_RESUME_SCAN_COMMENT:
+                if (data[i] == '*') {
+                    state = LWJSON_RESUME_SCAN_COMMENT_STAR;
+                }
+                break;
+            case LWJSON_RESUME_SCAN_COMMENT_STAR:
+                state = data[i] == '/' ? LWJSON_RESUME_SCAN_VALUE : LWJSON_RESUME_SCAN_COMMENT;
+                break;
+#endif /* LWJSON_CFG_COMMENTS */
+            default: break;
+        }
+    }
+    lwobj->resume.scan_pos = len;
+    lwobj->resume.scan_state = state;
+}
+
+/**
+ * \brief           Start resumable parsing of new JSON data
+ *
+ * Call \ref lwjson_parse_resume afterwards, until it returns anything else than \ref lwjsonPARSEINPROG
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_begin(lwjson_t* lwobj) {
+    if (lwobj == NULL) {
+        return lwjsonERRPAR;
+    }
+    LWJSON_MEMSET(&lwobj->resume, 0x00, sizeof(lwobj->resume));
+    lwobj->flags.parsed = 0;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Continue resumable parsing with data received so far
+ *
+ * Function parses all complete values in the data and stops
+ * at the end of available data or once `max_tokens` new tokens are parsed.
+ * Next call continues from the same position. Tokens are identical to the ones from \ref lwjson_parse_ex.
+ *
+ * Value is complete once `,`, `]` or `}` character follows it,
+ * so last value is only parsed when the following character is received.
+ * Data after closed root object or array is not checked.
+ *
+ * \note            All calls must use the same data buffer, that only grows in length.
+ *                      Tokens point to the data, so it must not be moved or modified while it is received.
+ * \param[in,out]   lwobj: LwJSON instance, prepared with \ref lwjson_parse_begin
+ * \param[in]       json_data: JSON data received so far
+ * \param[in]       json_len: Length of data received so far
+ * \param[in]       max_tokens: Max number of tokens to parse in this call. Set to `0` for no limit
+ * \return          \ref lwjsonOK when JSON is complete, \ref lwjsonPARSEINPROG when more data or calls are needed,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_resume(lwjson_t* lwobj, const void* json_data, size_t json_len, size_t max_tokens) {
+    lwjsonr_t res;
+    lwjson_int_str_t pobj = {.start = json_data};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len < lwobj->resume.scan_pos
+        || (lwobj->resume.json_data != NULL && lwobj->resume.json_data != json_data)) {
+        return lwjsonERRPAR;
+    }
+    if (lwobj->flags.parsed) {
+        return lwjsonOK;
+    }
+    lwobj->resume.json_data = json_data;
+
+    /* Parse only up to the end of the last complete value */
+    prv_resume_scan(lwobj, json_data, json_len);
+    if (lwobj->resume.safe_len <= lwobj->resume.pos) {
+        return lwjsonPARSEINPROG;
+    }
+    pobj.len = lwobj->resume.safe_len;
+    pobj.p = pobj.start + lwobj->resume.pos;
+
+    if (!lwobj->resume.started) {
+        res = prv_parse_root(lwobj, &pobj, &lwobj->resume.to);
+        if (res != lwjsonOK) {
+            return res;
+        }
+        lwobj->resume.started = 1;
+    }
+    res = prv_parse_tokens(lwobj, &pobj, &lwobj->resume.to, &lwobj->resume.tail, max_tokens);
+    lwobj->resume.pos = (size_t)(pobj.p - pobj.start);
+    if (res == lwjsonOK) {
+        lwobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+#endif /* LWJSON_CFG_PARSE_RESUME */
+
+/**
+ * \brief           Parse next document from data with several JSON documents,
+ *                  such as newline delimited JSON or concatenated JSON
+ *
+ * Document ends with closing bracket of its root object or array,
+ * next document may follow after any number of blank characters or immediately.
+ * Every call reuses tokens of the instance, so tokens of previous document are no longer valid.
+ *
+ * Start with `pos` set to `0` and add `doc_len` to it after every parsed document.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: Data with all documents
+ * \param[in]       json_len: Data length
+ * \param[in,out]   pos: Position to search next document from.
+ *                      It is set to the first character of parsed document on success
+ * \param[out]      doc_len: Output variable for document length. Can be set to `NULL` if not used
+ * \return          \ref lwjsonOK on success, \ref lwjsonPARSEEND when only blank characters are left until `json_len`,
+ *                      \ref lwjsonERRJSON when `NULL` character is found before `json_len`,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_many(lwjson_t* lwobj, const void* json_data, size_t json_len, size_t* pos, size_t* doc_len) {
+    lwjsonr_t res;
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .multi = 1};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || pos == NULL || *pos > json_len) {
+        return lwjsonERRPAR;
+    }
+    lwobj->flags.parsed = 0;
+
+    /* Skip blank characters between documents, data ends only at the given length */
+    pobj.p = pobj.start + *pos;
+    if (prv_skip_blank(&pobj) != lwjsonOK) {
+        return (size_t)(pobj.p - pobj.start) >= json_len ? lwjsonPARSEEND : lwjsonERRJSON;
+    }
+    *pos = (size_t)(pobj.p - pobj.start);
+
+    res = prv_parse(lwobj, &pobj);
+    if (res == lwjsonOK && doc_len != NULL) {
+        *doc_len = (size_t)(pobj.p - pobj.start) - *pos;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse members of the root object or array, that are part of larger JSON data
+ *
+ * Function allows to parse parts of large JSON data independently, to be linked together later.
+ * Root token of the given type is created and parsing starts at `begin` offset,
+ * that must be after opening bracket of the root, outside of strings and nested objects or arrays.
+ * Parsing stops at `end` offset, that must be after complete member or after closing bracket of the root.
+ *
+ * Strings of compact tokens are stored as offsets from the beginning of `json_data`, not from `begin` offset.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data with the fragment
+ * \param[in]       begin: Offset of the fragment
+ * \param[in]       end: Offset of the end of the fragment
+ * \param[in]       type: Type of the root, \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY
+ * \return          \ref lwjsonOK when closing bracket of the root is parsed,
+ *                      \ref lwjsonPARSEINPROG when fragment ends after complete member,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_fragment(lwjson_t* lwobj, const void* json_data, size_t begin, size_t end, lwjson_type_t type) {
+    lwjsonr_t res;
+    lwjson_token_t *to, *root, *tail = NULL;
+    lwjson_int_str_t pobj = {.start = json_data, .len = end, .fragment = 1};
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || begin > end
+        || (type != LWJSON_TYPE_OBJECT && type != LWJSON_TYPE_ARRAY)) {
+        return lwjsonERRPAR;
+    }
+    pobj.p = pobj.start + begin;
+
+    res = prv_parse_reset(lwobj, &pobj, &root);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    root->type = type;
+    to = root;
+    res = prv_parse_tokens(lwobj, &pobj, &to, &tail, 0);
+    if (res == lwjsonPARSEINPROG) {
+        if (to != root) {
+            return lwjsonERRJSON;
+        }
+#if LWJSON_CFG_COMPACT_TOKENS
+        root->u.cont.child_tokens = (uint32_t)(lwobj->next_free_token_pos - 1);
+#else
+        root->u.cont.child_tokens = lwobj->next_free_token_pos;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    }
+    if (res == lwjsonOK || res == lwjsonPARSEINPROG) {
+        lwobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse input JSON format
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_str: JSON string to parse
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse(lwjson_t* lwobj, const char* json_str) {
+    return lwjson_parse_ex(lwobj, json_str, strlen(json_str));
+}
+
+/**
+ * \brief           Count tokens needed to parse JSON data, without writing any tokens
+ *
+ * Input is checked with the same rules as in \ref lwjson_parse_ex function,
+ * so application can allocate exact number of tokens before parsing.
+ * Count is an upper bound for \ref lwjson_parse_packed function, as packed arrays take fewer tokens.
+ *
+ * \note           Every string, number and literal is fully validated, same as in the parser,
+ *                  so the scan runs at about the same speed as \ref lwjson_parse_ex.
+ *                  It saves token memory, not time: calling it before the parse roughly doubles
+ *                  the time spent on the input. Use it when tokens are allocated once per message
+ *                  and over-provisioning memory is the bigger cost.
+ *
+ * \param[in]       json_data: JSON data to scan
+ * \param[in]       json_len: JSON data length
+ * \param[out]      count: Output variable for number of tokens required in array passed to \ref lwjson_init.
+ *                      Can be set to `NULL` if not used
+ * \param[out]      max_depth: Output variable for maximal nesting depth of objects and arrays,
+ *                      where root object or array is at depth `1`. Can be set to `NULL` if not used
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRMEM if nesting is deeper than
+ *                      \ref LWJSON_CFG_MAX_DEPTH, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_count_tokens(const void* json_data, size_t json_len, size_t* count, size_t* max_depth) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    lwjsonr_t res;
+
+    /* Check input parameters */
+    if (json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    res = prv_scan(&pobj, count, max_depth);
+#if LWJSON_CFG_COMPACT_TOKENS
+    /* Root token is part of the array */
+    if (res == lwjsonOK && count != NULL) {
+        ++*count;
+    }
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    return res;
+}
+
+/**
+ * \brief           Check if JSON data is well-formed, without writing any tokens
+ *
+ * Input is checked with the same rules as in \ref lwjson_parse_ex function.
+ * Only one bit per nesting level is kept, to know if currently open token is object or array,
+ * so no instance or tokens array is needed.
+ *
+ * \param[in]       json_data: JSON data to check
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK if data is valid JSON, \ref lwjsonERRMEM if nesting is deeper than
+ *                      \ref LWJSON_CFG_MAX_DEPTH, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_validate(const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+
+    /* Check input parameters */
+    if (json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_scan(&pobj, NULL, NULL);
+}
+
+/**
+ * \brief           Free token instances (specially used in case of dynamic memory allocation)
+ *
+ * With \ref LWJSON_CFG_ALLOC enabled, all dynamically allocated token blocks are released.
+ * Instance can be used for parsing again after the call.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_free(lwjson_t* lwobj) {
+    if (lwobj->tokens != NULL) {
+        LWJSON_MEMSET(lwobj->tokens, 0x00, sizeof(*lwobj->tokens) * lwobj->tokens_len);
+    }
+#if LWJSON_CFG_ALLOC
+    while (lwobj->blocks != NULL) {
+        lwjson_token_block_t* next = lwobj->blocks->next;
+        LWJSON_FREE(lwobj->blocks);
+        lwobj->blocks = next;
+    }
+    lwobj->block = NULL;
+    lwobj->block_pos = 0;
+#endif /* LWJSON_CFG_ALLOC */
+    lwobj->next_free_token_pos = 0;
+    lwobj->flags.parsed = 0;
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+    prv_index_reset(lwobj);
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+    return lwjsonOK;
+}
+
+#if LWJSON_CFG_LAZY_NUMBERS
+
+/**
+ * \brief           Convert number token from its text in JSON data
+ * \param[in]       token: Number token
+ * \param[out]      fout: Output variable for real number
+ * \param[out]      iout: Output variable for integer number
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_convert_number(const lwjson_token_t* token, lwjson_real_t* fout, lwjson_int_t* iout) {
+    /* Number is always followed by valid JSON character, that ends conversion */
+    lwjson_int_str_t pobj = {.start = token->u.str.token_value,
+                             .len = token->u.str.token_value_len,
+                             .p = token->u.str.token_value};
+    lwjson_type_t type;
+
+    return prv_parse_number(&pobj, &type, fout, iout);
+}
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_INT type
+ * \note            Number is converted from JSON data on every call
+ * \param[in]       token: token with integer type
+ * \return          Int number if type is integer, `0` otherwise
+ */
+lwjson_int_t
+lwjson_get_val_int(const lwjson_token_t* token) {
+    lwjson_real_t fval;
+    lwjson_int_t ival = 0;
+
+    if (token != NULL && token->type == LWJSON_TYPE_NUM_INT) {
+        prv_convert_number(token, &fval, &ival);
+    }
+    return ival;
+}
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_REAL type
+ * \note            Number is converted from JSON data on every call
+ * \param[in]       token: token with real type
+ * \return          Real number if type is real, `0` otherwise
+ */
+lwjson_real_t
+lwjson_get_val_real(const lwjson_token_t* token) {
+    lwjson_real_t fval = 0;
+    lwjson_int_t ival;
+
+    if (token != NULL && token->type == LWJSON_TYPE_NUM_REAL) {
+        prv_convert_number(token, &fval, &ival);
+    }
+    return fval;
+}
+
+/**
+ * \brief           Get exact text of number token, as it appears in JSON data
+ *
+ * Use it for values, that cannot be represented in \ref lwjson_int_t or \ref lwjson_real_t
+ * without loss, such as large identifiers or decimal currency amounts.
+ *
+ * \note            Available only when \ref LWJSON_CFG_LAZY_NUMBERS is enabled
+ * \param[in]       token: Token with \ref LWJSON_TYPE_NUM_INT or \ref LWJSON_TYPE_NUM_REAL type
+ * \param[out]      len: Pointer to variable holding length of number text. Set to `NULL` if not used
+ * \return          Pointer to number text (not `NULL` terminated), `NULL` if token is not a number
+ */
+const char*
+lwjson_get_val_number_raw(const lwjson_token_t* token, size_t* len) {
+    if (token != NULL && (token->type == LWJSON_TYPE_NUM_INT || token->type == LWJSON_TYPE_NUM_REAL)) {
+        if (len != NULL) {
+            *len = token->u.str.token_value_len;
+        }
+        return token->u.str.token_value;
+    }
+    return NULL;
+}
+
+#endif /* LWJSON_CFG_LAZY_NUMBERS */
+
+/**
+ * \brief           Find first match in the given path for JSON entry
+ * JSON must be valid and parsed with \ref lwjson_parse function
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       path: Path with dot-separated entries to search for the JSON key to return
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find(lwjson_t* lwobj, const char* path) {
+    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+        return NULL;
+    }
+    return prv_find(lwobj, lwjson_get_first_token(lwobj), &(lwjson_find_rest_t){.path = path});
+}
+
+/**
+ * \brief           Find first match in the given path for JSON path
+ * JSON must be valid and parsed with \ref lwjson_parse function
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at.
+ *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       path: path with dot-separated entries to search for JSON key
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path) {
+    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+        return NULL;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+        return NULL;
+    }
+    return prv_find(lwobj, token, &(lwjson_find_rest_t){.path = path});
+}
+
+/**
+ * \brief           Compile path for repeated search with \ref lwjson_find_compiled function
+ *
+ * Path is split to segments and array indexes are parsed only once.
+ * Keys are not copied, path string must stay valid while compiled path is used.
+ *
+ * \param[out]      cpath: Compiled path
+ * \param[in]       path: Path with dot-separated entries, as for \ref lwjson_find function.
+ *                      It has up to \ref LWJSON_CFG_MAX_PATH_SEGMENTS segments
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if path has too many segments
+ *                      or it cannot match any token
+ */
+lwjsonr_t
+lwjson_path_compile(lwjson_path_t* cpath, const char* path) {
+    uint8_t is_last = 0;
+
+    if (cpath == NULL || path == NULL) {
+        return lwjsonERRPAR;
+    }
+    cpath->segments_cnt = 0;
+    while (!is_last) {
+        if (cpath->segments_cnt >= LWJSON_ARRAYSIZE(cpath->segments)
+            || !prv_path_segment(&path, &cpath->segments[cpath->segments_cnt], &is_last)) {
+            cpath->segments_cnt = 0;
+            return lwjsonERRPAR;
+        }
+        ++cpath->segments_cnt;
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Set memory for key hash tables of large objects and element tables of large arrays
+ *
+ * Tables, built so far, are dropped. Arena is used until instance is parsed again.
+ * Besides tables, arena holds lookup table with two pointers per every
+ * \ref LWJSON_CFG_KEY_INDEX_MIN_MEMBERS or \ref LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS used tokens,
+ * so that table of any token is found in constant time.
+ * Set arena to `NULL` to disable the tables,
+ * or to allocate them with \ref LWJSON_MALLOC function when \ref LWJSON_CFG_ALLOC is enabled.
+ *
+ * \note            Used only when \ref LWJSON_CFG_KEY_INDEX or \ref LWJSON_CFG_ARRAY_INDEX is enabled
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       arena: Memory for tables, aligned to pointer size, or `NULL`
+ * \param[in]       arena_len: Length of arena in units of bytes
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_set_index_arena(lwjson_t* lwobj, void* arena, size_t arena_len) {
+    if (lwobj == NULL || (arena == NULL && arena_len > 0)) {
+        return lwjsonERRPAR;
+    }
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+    prv_index_reset(lwobj);
+    lwobj->index.arena = arena;
+    lwobj->index.arena_len = arena_len;
+    return lwjsonOK;
+#else
+    (void)arena;
+    return lwjsonERR;
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+}
+
+/**
+ * \brief           Find first match for compiled path
+ *
+ * Result is the same as with \ref lwjson_find_ex function for the path text
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at.
+ *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       cpath: Path, compiled with \ref lwjson_path_compile function
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find_compiled(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_path_t* cpath) {
+    if (lwobj == NULL || !lwobj->flags.parsed || cpath == NULL || cpath->segments_cnt == 0) {
+        return NULL;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+        return NULL;
+    }
+    return prv_find(lwobj, token, &(lwjson_find_rest_t){.cpath = cpath});
+}
+
+/* Maximal number of segments of paths, that are searched together */
+#define LWJSON_FIND_MANY_NODES (4 * LWJSON_CFG_MAX_PATH_SEGMENTS)
+
+/* Maximal number of paths, that are searched together */
+#define LWJSON_FIND_MANY_PATHS 64
+
+/**
+ * \brief           Node of the trie of paths, that are searched together.
+ * Node is one segment, shared by consecutive paths with the same segments up to it
+ */
+typedef struct {
+    lwjson_path_segment_t seg;   /*!< Segment of the node */
+    const lwjson_token_t* found; /*!< First token, that matches the path ending at this node */
+    uint16_t child;              /*!< Index of the first child node, `0` if none */
+    uint16_t next;               /*!< Index of the next node with the same parent, `0` if none */
+    uint16_t left;               /*!< Number of nodes in the subtree, including this one, where path ends
+                                      and which are not found yet */
+    uint8_t end;                 /*!< Set to `1` when any path ends at this node */
+} lwjson_find_node_t;
+
+/**
+ * \brief           Paths, that are searched together
+ */
+typedef struct {
+    lwjson_find_node_t nodes[LWJSON_FIND_MANY_NODES];  /*!< Trie nodes, first one is the root token */
+    size_t nodes_cnt;                                  /*!< Number of used nodes */
+    uint16_t end[LWJSON_FIND_MANY_PATHS];              /*!< Node where path ends, `0` when path cannot match */
+    const char* prev;                                  /*!< Previously added path, `NULL` if it cannot match */
+    uint16_t prev_nodes[LWJSON_CFG_MAX_PATH_SEGMENTS]; /*!< Nodes of segments of previous path */
+    size_t prev_dots[LWJSON_CFG_MAX_PATH_SEGMENTS];    /*!< Offsets of dots after segments of previous path */
+} lwjson_find_many_t;
+
+static size_t prv_find_many_children(lwjson_t* lwobj, lwjson_find_many_t* fm, const lwjson_token_t* parent,
+                                     lwjson_find_node_t* node);
+
+/**
+ * \brief           Add path to the trie
+ *
+ * Leading segments, that are the same text as in previous path, are not parsed again and share its nodes.
+ * Other segments get new nodes, placed after the node of previous path with the same parent,
+ * so children are in order of paths
+ *
+ * \param[in,out]   fm: Search state with more than \ref LWJSON_CFG_MAX_PATH_SEGMENTS free nodes
+ * \param[in]       path: Path to add
+ * \param[out]      end: Output variable for index of the node, where path ends,
+ *                      `0` if path cannot match any token
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if path has too many segments
+ */
+static lwjsonr_t
+prv_find_many_add(lwjson_find_many_t* fm, const char* path, uint16_t* end) {
+    const char* start = path;
+    size_t segments = 0;
+    uint16_t pos = 0, after = 0;
+    uint8_t is_last = 0;
+
+    *end = 0;
+    if (fm->prev != NULL && path != NULL) {
+        size_t same = 0;
+
+        for (; path[same] != '\0' && path[same] == fm->prev[same]; ++same) {}
+        for (; segments < LWJSON_CFG_MAX_PATH_SEGMENTS && fm->prev_nodes[segments] != 0
+               && fm->prev_dots[segments] < same;
+             ++segments) {}
+        if (segments > 0) {
+            pos = fm->prev_nodes[segments - 1];
+            path += fm->prev_dots[segments - 1] + 1;
+        }
+        if (segments < LWJSON_CFG_MAX_PATH_SEGMENTS) {
+            after = fm->prev_nodes[segments];
+        }
+    }
+    fm->prev = NULL;
+    while (!is_last) {
+        lwjson_find_node_t* node = &fm->nodes[fm->nodes_cnt];
+        uint16_t* link = after != 0 ? &fm->nodes[after].next : &fm->nodes[pos].child;
+
+        if (!prv_path_segment(&path, &node->seg, &is_last)) {
+            return lwjsonOK;
+        }
+        if (segments == LWJSON_CFG_MAX_PATH_SEGMENTS) {
+            return lwjsonERRPAR;
+        }
+
+        /* Any element must be followed by next segment, as with find operation */
+        if (is_last && node->seg.key == NULL && node->seg.index == LWJSON_PATH_INDEX_ANY) {
+            return lwjsonOK;
+        }
+        node->found = NULL;
+        node->child = 0;
+        node->next = *link;
+        node->left = 0;
+        node->end = 0;
+        pos = (uint16_t)fm->nodes_cnt++;
+        *link = pos;
+        fm->prev_nodes[segments] = pos;
+        fm->prev_dots[segments] = is_last ? SIZE_MAX : (size_t)(path - start - 1);
+        ++segments;
+        after = 0;
+    }
+    if (segments < LWJSON_CFG_MAX_PATH_SEGMENTS) {
+        fm->prev_nodes[segments] = 0;
+    }
+    fm->prev = start;
+
+    /* Every node on the way counts the path end once */
+    fm->nodes[pos].end = 1;
+    fm->nodes[pos].left = 1;
+    ++fm->nodes[0].left;
+    for (size_t i = 0; i + 1 < segments; ++i) {
+        ++fm->nodes[fm->prev_nodes[i]].left;
+    }
+    *end = pos;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Process token, that matches segment of the node
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   fm: Search state
+ * \param[in,out]   node: Node with matched segment
+ * \param[in]       t: Matched token
+ * \return          Number of nodes, found in the subtree of the node
+ */
+static size_t
+prv_find_many_match(lwjson_t* lwobj, lwjson_find_many_t* fm, lwjson_find_node_t* node, const lwjson_token_t* t) {
+    size_t cnt = 0;
+
+    /* Only the first match is stored, as with find operation */
+    if (node->end && node->found == NULL) {
+        node->found = t;
+        --node->left;
+        cnt = 1;
+    }
+    if (node->left > 0 && (t->type == LWJSON_TYPE_OBJECT || t->type == LWJSON_TYPE_ARRAY)) {
+        cnt += prv_find_many_children(lwobj, fm, t, node);
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Match child nodes of the node with members of the object, walked once
+ *
+ * Every member is matched with keys of all child nodes, that are not found yet,
+ * so members are in the same order for every key as with find operation.
+ * Child nodes, which have all their paths found, are unlinked from the trie
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   fm: Search state
+ * \param[in]       first: First member of the object
+ * \param[in,out]   node: Node, which segment matches the object
+ * \return          Number of nodes, found in the subtree of the node
+ */
+static size_t
+prv_find_many_members(lwjson_t* lwobj, lwjson_find_many_t* fm, const lwjson_token_t* first,
+                      lwjson_find_node_t* node) {
+    size_t cnt = 0, found;
+
+    for (const lwjson_token_t* t = first; t != NULL && node->left > 0; t = lwjson_get_next(t)) {
+        size_t name_len = 0;
+        const char* name = lwjson_get_token_name(lwobj, t, &name_len);
+
+        if (name == NULL) {
+            continue;
+        }
+        for (uint16_t* link = &node->child; *link != 0;) {
+            lwjson_find_node_t* c = &fm->nodes[*link];
+
+            if (c->left > 0 && c->seg.key != NULL && name_len == c->seg.key_len
+                && !strncmp(name, c->seg.key, name_len)) {
+                found = prv_find_many_match(lwobj, fm, c, t);
+                node->left -= (uint16_t)found;
+                cnt += found;
+            }
+            if (c->left == 0) {
+                *link = c->next;
+            } else {
+                link = &c->next;
+            }
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Match children of the node with children of the token
+ *
+ * Object members are walked once for all keys. Large objects with key table
+ * are scanned for every key instead, starting at its key table entry.
+ * Array elements are walked once for indexes in ascending order, or got from element table.
+ * Child nodes, which have all their paths found, are unlinked from the trie
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   fm: Search state
+ * \param[in]       parent: Object or array token
+ * \param[in,out]   node: Node, which segment matches the parent token
+ * \return          Number of nodes, found in the subtree of the node
+ */
+static size_t
+prv_find_many_children(lwjson_t* lwobj, lwjson_find_many_t* fm, const lwjson_token_t* parent,
+                       lwjson_find_node_t* node) {
+    const lwjson_token_t *first, *cur;
+    size_t cnt = 0, found, index = 0;
+    uint8_t is_obj = parent->type == LWJSON_TYPE_OBJECT, packed = 0;
+#if LWJSON_CFG_KEY_INDEX
+    const lwjson_index_t* idx = NULL;
+#endif /* LWJSON_CFG_KEY_INDEX */
+#if LWJSON_CFG_ARRAY_INDEX
+    int8_t indexed = -1;
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+
+    first = cur = lwjson_get_first_child(parent);
+    if (is_obj) {
+#if LWJSON_CFG_KEY_INDEX
+        idx = prv_index_get(lwobj, parent);
+        if (idx == NULL)
+#endif /* LWJSON_CFG_KEY_INDEX */
+        {
+            return prv_find_many_members(lwobj, fm, first, node);
+        }
+    } else {
+        packed = prv_packed_hdr(parent) != NULL;
+    }
+    for (uint16_t* link = &node->child; *link != 0 && node->left > 0;) {
+        lwjson_find_node_t* c = &fm->nodes[*link];
+        const lwjson_token_t* t = NULL;
+
+        if (c->left == 0) {
+            /* Nothing to find in the subtree */
+        } else if (c->seg.key != NULL) {
+#if LWJSON_CFG_KEY_INDEX
+            /* Large object starts at the first member with the name, next ones are checked linearly */
+            if (is_obj) {
+                for (t = prv_index_slot(lwobj, idx, c->seg.key, c->seg.key_len, c->seg.hash)->t; t != NULL;
+                     t = lwjson_get_next(t)) {
+                    size_t name_len = 0;
+                    const char* name = lwjson_get_token_name(lwobj, t, &name_len);
+
+                    if (name != NULL && name_len == c->seg.key_len && !strncmp(name, c->seg.key, name_len)) {
+                        found = prv_find_many_match(lwobj, fm, c, t);
+                        node->left -= (uint16_t)found;
+                        cnt += found;
+                        if (c->left == 0) {
+                            break;
+                        }
+                    }
+                }
+            }
+#endif /* LWJSON_CFG_KEY_INDEX */
+        } else if (!is_obj) {
+            if (c->seg.index == LWJSON_PATH_INDEX_ANY) {
+                for (t = first; t != NULL; t = lwjson_get_next(t)) {
+                    found = prv_find_many_match(lwobj, fm, c, t);
+                    node->left -= (uint16_t)found;
+                    cnt += found;
+                    if (c->left == 0) {
+                        break;
+                    }
+                }
+
+            /* Values of packed array have no tokens */
+            } else if (!packed) {
+#if LWJSON_CFG_ARRAY_INDEX
+                if (indexed < 0) {
+                    indexed = prv_array_index_get(lwobj, parent) != NULL;
+                }
+                if (indexed) {
+                    cur = prv_array_get(lwobj, parent, c->seg.index);
+                } else
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+                {
+                    /* Walk continues from previous index, when indexes are ascending */
+                    if (index > c->seg.index) {
+                        cur = first;
+                        index = 0;
+                    }
+                    for (; cur != NULL && index < c->seg.index; cur = lwjson_get_next(cur), ++index) {}
+                }
+                if (cur != NULL) {
+                    found = prv_find_many_match(lwobj, fm, c, cur);
+                    node->left -= (uint16_t)found;
+                    cnt += found;
+                }
+            }
+        }
+        if (c->left == 0) {
+            *link = c->next;
+        } else {
+            link = &c->next;
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Find first match for every path in single traversal of tokens
+ *
+ * Result for every path is the same as with \ref lwjson_find function.
+ * Paths are parsed once to a tree of segments, where consecutive paths with the same leading segments,
+ * such as `current.temp` and `current.wind_speed`, share them and their tokens are matched only once.
+ * Members of every object are walked once for all keys of the paths,
+ * only large objects with key table are searched for every key, starting at its key table entry.
+ * Element tables of large arrays are used the same way as with \ref lwjson_find,
+ * and search of the subtree stops once all its paths are found.
+ * List paths with common leading segments next to each other, to share most segments.
+ *
+ * \note            Up to `64` paths and `4 * LWJSON_CFG_MAX_PATH_SEGMENTS` segments are searched together,
+ *                      their state takes about `3` kB of stack memory with default options
+ *                      (`3.4` kB with \ref LWJSON_CFG_KEY_INDEX enabled). More paths are searched in several passes
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       paths: Paths to find, in the same format as for \ref lwjson_find function.
+ *                      Every path has up to \ref LWJSON_CFG_MAX_PATH_SEGMENTS segments
+ * \param[in]       paths_cnt: Number of paths
+ * \param[out]      results: Output array with `paths_cnt` entries for found token of every path,
+ *                      set to `NULL` for paths, that are not found
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if any path has too many segments,
+ *                      member of \ref lwjsonr_t otherwise. Results are not valid on failure
+ */
+lwjsonr_t
+lwjson_find_many(lwjson_t* lwobj, const char* const* paths, size_t paths_cnt, const lwjson_token_t** results) {
+    lwjson_find_many_t fm;
+    const lwjson_token_t* token;
+    size_t first = 0;
+
+    if (lwobj == NULL || paths == NULL || results == NULL) {
+        return lwjsonERRPAR;
+    }
+    for (size_t i = 0; i < paths_cnt; ++i) {
+        results[i] = NULL;
+    }
+    if (!lwobj->flags.parsed) {
+        return lwjsonERR;
+    }
+    token = lwjson_get_first_token(lwobj);
+    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+        return lwjsonOK;
+    }
+    while (first < paths_cnt) {
+        size_t cnt = 0;
+
+        /* Add paths to the trie, while there are nodes for any path */
+        LWJSON_MEMSET(&fm.nodes[0], 0x00, sizeof(fm.nodes[0]));
+        fm.nodes_cnt = 1;
+        fm.prev = NULL;
+        for (; first + cnt < paths_cnt && cnt < LWJSON_FIND_MANY_PATHS
+               && fm.nodes_cnt + LWJSON_CFG_MAX_PATH_SEGMENTS < LWJSON_FIND_MANY_NODES;
+             ++cnt) {
+            if (prv_find_many_add(&fm, paths[first + cnt], &fm.end[cnt]) != lwjsonOK) {
+                return lwjsonERRPAR;
+            }
+        }
+        prv_find_many_children(lwobj, &fm, token, &fm.nodes[0]);
+        for (size_t i = 0; i < cnt; ++i) {
+            results[first + i] = fm.end[i] != 0 ? fm.nodes[fm.end[i]].found : NULL;
+        }
+        first += cnt;
+    }
+    return lwjsonOK;
+}
+
+/* Comparison operators of query predicates */
+#define LWJSON_QUERY_OP_NONE 0 /*!< Segment has no predicate */
+#define LWJSON_QUERY_OP_EQ   1 /*!< Child member is equal to the value */
+#define LWJSON_QUERY_OP_NE   2 /*!< Child member is not equal to the value */
+#define LWJSON_QUERY_OP_LT   3 /*!< Child member is less than the value */
+#define LWJSON_QUERY_OP_LE   4 /*!< Child member is less than or equal to the value */
+#define LWJSON_QUERY_OP_GT   5 /*!< Child member is greater than the value */
+#define LWJSON_QUERY_OP_GE   6 /*!< Child member is greater than or equal to the value */
+
+/**
+ * \brief           Skip blank characters in query string
+ * \param[in]       p: Current position in query string
+ * \return          Position of first not blank character
+ */
+static const char*
+prv_query_skip_blank(const char* p) {
+    while (*p != '\0' && prv_is_blank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * \brief           Parse array index in query string
+ * \param[in,out]   pp: Pointer to current position in query string, advanced after the digits
+ * \param[out]      index: Output variable for the index
+ * \return          `1` on success, `0` if index is too large
+ */
+static uint8_t
+prv_query_index(const char** pp, size_t* index) {
+    const char* p = *pp;
+
+    for (*index = 0; *p >= '0' && *p <= '9'; ++p) {
+        if (*index > (SIZE_MAX - 9) / 10) {
+            return 0;
+        }
+        *index = *index * 10 + (size_t)(*p - '0');
+    }
+    *pp = p;
+    return 1;
+}
+
+/**
+ * \brief           Parse predicate `[key op value]` of query segment
+ * \param[in,out]   pp: Pointer to character after `[`, advanced after `]` on success
+ * \param[out]      seg: Segment to set predicate for
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_query_pred(const char** pp, lwjson_query_segment_t* seg) {
+    static const struct {
+        char str[3];
+        uint8_t op;
+    } ops[] = {
+        {"==", LWJSON_QUERY_OP_EQ}, {"!=", LWJSON_QUERY_OP_NE}, {"<=", LWJSON_QUERY_OP_LE},
+        {">=", LWJSON_QUERY_OP_GE}, {"<", LWJSON_QUERY_OP_LT},  {">", LWJSON_QUERY_OP_GT},
+    };
+    const char* p = prv_query_skip_blank(*pp);
+
+    /* Key of child member */
+    seg->pred_key = p;
+    while (*p != '\0' && !prv_is_blank(*p) && strchr("=!<>]", *p) == NULL) {
+        ++p;
+    }
+    seg->pred_key_len = (size_t)(p - seg->pred_key);
+    if (seg->pred_key_len == 0) {
+        return lwjsonERRPAR;
+    }
+
+    /* Operator */
+    p = prv_query_skip_blank(p);
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(ops); ++i) {
+        size_t len = strlen(ops[i].str);
+
+        if (!strncmp(p, ops[i].str, len)) {
+            seg->op = ops[i].op;
+            p += len;
+            break;
+        }
+    }
+    if (seg->op == LWJSON_QUERY_OP_NONE) {
+        return lwjsonERRPAR;
+    }
+
+    /* Value */
+    p = prv_query_skip_blank(p);
+    if (*p == '"') {
+        seg->type = LWJSON_TYPE_STRING;
+        seg->str = ++p;
+        for (; *p != '"'; ++p) {
+            if (*p == '\0' || (*p == '\\' && *++p == '\0')) {
+                return lwjsonERRPAR;
+            }
+        }
+        seg->str_len = (size_t)(p++ - seg->str);
+    } else if (!strncmp(p, "true", 4)) {
+        seg->type = LWJSON_TYPE_TRUE;
+        p += 4;
+    } else if (!strncmp(p, "false", 5)) {
+        seg->type = LWJSON_TYPE_FALSE;
+        p += 5;
+    } else if (!strncmp(p, "null", 4)) {
+        seg->type = LWJSON_TYPE_NULL;
+        p += 4;
+    } else {
+        lwjson_int_str_t pobj = {.start = p, .len = strlen(p), .p = p};
+
+        if (prv_parse_number(&pobj, &seg->type, &seg->num_real, &seg->num_int) != lwjsonOK) {
+            return lwjsonERRPAR;
+        }
+        p = pobj.p;
+    }
+
+    /* Only numbers are ordered */
+    if (seg->type != LWJSON_TYPE_NUM_INT && seg->type != LWJSON_TYPE_NUM_REAL && seg->op != LWJSON_QUERY_OP_EQ
+        && seg->op != LWJSON_QUERY_OP_NE) {
+        return lwjsonERRPAR;
+    }
+    p = prv_query_skip_blank(p);
+    if (*p != ']') {
+        return lwjsonERRPAR;
+    }
+    *pp = p + 1;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Parse next segment of query string
+ * \param[in,out]   pp: Pointer to current position in query string, advanced after the segment
+ * \param[out]      seg: Segment to set
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_query_segment(const char** pp, lwjson_query_segment_t* seg) {
+    const char* p = *pp;
+
+    LWJSON_MEMSET(seg, 0x00, sizeof(*seg));
+    seg->end = LWJSON_PATH_INDEX_ANY;
+    if (*p == '*' || *p == '#') {
+        seg->is_array = *p++ == '#';
+        if (seg->is_array) {
+            /* Any element `#`, single element `#N` or slice `#N:M`, where both indexes are optional */
+            if (*p >= '0' && *p <= '9') {
+                if (!prv_query_index(&p, &seg->start)) {
+                    return lwjsonERRPAR;
+                }
+                seg->end = seg->start + 1;
+            }
+            if (*p == ':') {
+                ++p;
+                seg->end = LWJSON_PATH_INDEX_ANY;
+                if (*p >= '0' && *p <= '9' && !prv_query_index(&p, &seg->end)) {
+                    return lwjsonERRPAR;
+                }
+            }
+        }
+        if (*p == '[') {
+            ++p;
+            if (prv_query_pred(&p, seg) != lwjsonOK) {
+                return lwjsonERRPAR;
+            }
         }
+    } else {
+        seg->key = p;
+        while (*p != '\0' && *p != '.') {
+            ++p;
+        }
+        seg->key_len = (size_t)(p - seg->key);
+        if (seg->key_len == 0) {
+            return lwjsonERRPAR;
+        }
+    }
 
-        /* Check if end of object or array*/
-        if (*pobj.p == (to->type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
-            lwjson_token_t* parent = to->next;
-            to->next = NULL;
-            ++pobj.p;
-
-            /* End of string if to == NULL (no parent), check if properly terminated */
-            to = parent;
-            if (to == NULL) {
-                prv_skip_blank(&pobj);
-                res = (pobj.p == NULL || *pobj.p == '\0' || (size_t)(pobj.p - pobj.start) == pobj.len) ? lwjsonOK
-                                                                                                       : lwjsonERR;
-                goto ret;
-            }
-            continue;
+    /* Segment is followed by the next one or by the end of query */
+    if (*p == '.') {
+        if (*++p == '\0') {
+            return lwjsonERRPAR;
         }
+    } else if (*p != '\0') {
+        return lwjsonERRPAR;
+    }
+    *pp = p;
+    return lwjsonOK;
+}
 
-        /* Allocate new token */
-        t = prv_alloc_token(lwobj);
-        if (t == NULL) {
-            res = lwjsonERRMEM;
-            goto ret;
+/**
+ * \brief           Check if child member of the token satisfies predicate of the segment
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       seg: Query segment with predicate
+ * \param[in]       token: Token to check
+ * \return          `1` if token matches, `0` otherwise
+ */
+static uint8_t
+prv_query_match(const lwjson_t* lwobj, const lwjson_query_segment_t* seg, const lwjson_token_t* token) {
+    const lwjson_token_t* t;
+    int cmp = 1;
+
+    if (token->type != LWJSON_TYPE_OBJECT) {
+        return 0;
+    }
+    for (t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
+        size_t name_len = 0;
+        const char* name = lwjson_get_token_name(lwobj, t, &name_len);
+
+        if (name != NULL && name_len == seg->pred_key_len && !strncmp(name, seg->pred_key, name_len)) {
+            break;
         }
+    }
+    if (t == NULL) {
+        return 0;
+    }
 
-        /* If object type is not array, first thing is property that starts with quotes */
-        if (to->type != LWJSON_TYPE_ARRAY) {
-            if (*pobj.p != '"') {
-                res = lwjsonERRJSON;
-                goto ret;
-            }
-            res = prv_parse_property_name(&pobj, t);
-            if (res != lwjsonOK) {
-                goto ret;
-            }
+    /* Compare child member with the value */
+    if (seg->type == LWJSON_TYPE_STRING) {
+        if (t->type == LWJSON_TYPE_STRING) {
+            size_t len = 0;
+            const char* str = lwjson_get_val_string_ex(lwobj, t, &len);
+
+            cmp = str == NULL || len != seg->str_len || strncmp(str, seg->str, len);
         }
+    } else if (seg->type == LWJSON_TYPE_NUM_INT || seg->type == LWJSON_TYPE_NUM_REAL) {
+        if (t->type == LWJSON_TYPE_NUM_INT && seg->type == LWJSON_TYPE_NUM_INT) {
+            lwjson_int_t val = lwjson_get_val_int(t);
 
-        /* Add element to linked list */
-        if (to->u.first_child == NULL) {
-            to->u.first_child = t;
+            cmp = (val > seg->num_int) - (val < seg->num_int);
+        } else if (t->type == LWJSON_TYPE_NUM_INT || t->type == LWJSON_TYPE_NUM_REAL) {
+            lwjson_real_t val = t->type == LWJSON_TYPE_NUM_INT ? (lwjson_real_t)lwjson_get_val_int(t)
+                                                               : lwjson_get_val_real(t);
+            lwjson_real_t ref = seg->type == LWJSON_TYPE_NUM_INT ? (lwjson_real_t)seg->num_int : seg->num_real;
+
+            cmp = (val > ref) - (val < ref);
         } else {
-            lwjson_token_t* c;
-            for (c = to->u.first_child; c->next != NULL; c = c->next) {}
-            c->next = t;
+            /* Other types are only different */
+            return seg->op == LWJSON_QUERY_OP_NE;
         }
+    } else {
+        cmp = t->type != seg->type;
+    }
+    switch (seg->op) {
+        case LWJSON_QUERY_OP_EQ: return cmp == 0;
+        case LWJSON_QUERY_OP_NE: return cmp != 0;
+        case LWJSON_QUERY_OP_LT: return cmp < 0;
+        case LWJSON_QUERY_OP_LE: return cmp <= 0;
+        case LWJSON_QUERY_OP_GT: return cmp > 0;
+        case LWJSON_QUERY_OP_GE: return cmp >= 0;
+        default: return 0;
+    }
+}
 
-        /* Check next character to process */
-        switch (*pobj.p) {
-            case '{':
-            case '[':
-                t->type = *pobj.p == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
-                ++pobj.p;
+/**
+ * \brief           Start search of children of the token for query segment
+ * \param[in,out]   query: Query iterator
+ * \param[in]       depth: Index of query segment
+ * \param[in]       parent: Token, which children are searched
+ */
+static void
+prv_query_level(lwjson_query_t* query, size_t depth, const lwjson_token_t* parent) {
+    const lwjson_query_segment_t* seg = &query->segments[depth];
 
-                res = prv_check_valid_char_after_open_bracket(&pobj, t);
-                if (res != lwjsonOK) {
-                    goto ret;
-                }
-                t->next = to; /* Temporary saved as parent object */
-                to = t;
-                break;
-            case '"':
-                res = prv_parse_string(&pobj, &t->u.str.token_value, &t->u.str.token_value_len);
-                if (res == lwjsonOK) {
-                    t->type = LWJSON_TYPE_STRING;
-                } else {
-                    goto ret;
-                }
-                break;
-            case 't':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "true", 4) == 0) {
-                    t->type = LWJSON_TYPE_TRUE;
-                    pobj.p += 4;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            case 'f':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "false", 5) == 0) {
-                    t->type = LWJSON_TYPE_FALSE;
-                    pobj.p += 5;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            case 'n':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "null", 4) == 0) {
-                    t->type = LWJSON_TYPE_NULL;
-                    pobj.p += 4;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            default:
-                if (*pobj.p == '-' || (*pobj.p >= '0' && *pobj.p <= '9')) {
-                    if (prv_parse_number(&pobj, &t->type, &t->u.num_real, &t->u.num_int) != lwjsonOK) {
-                        res = lwjsonERRJSON;
-                        goto ret;
-                    }
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
+    query->level[depth].parent = NULL;
+    query->level[depth].next = NULL;
+    query->level[depth].index = 0;
+    if (parent == NULL || parent->type != (seg->is_array ? LWJSON_TYPE_ARRAY : LWJSON_TYPE_OBJECT)) {
+        return;
+    }
+    query->level[depth].parent = parent;
+    if (seg->is_array) {
+        /* Slice starts at its first element, packed values are accessed by index only */
+        query->level[depth].index = seg->start;
+        if (prv_packed_hdr(parent) == NULL) {
+            query->level[depth].next = prv_array_get(query->lwobj, parent, seg->start);
         }
+    } else {
+        query->level[depth].next = lwjson_get_first_child(parent);
+    }
+}
 
-        /* Below code is used to check characters after valid tokens */
-        if (t->type == LWJSON_TYPE_ARRAY || t->type == LWJSON_TYPE_OBJECT) {
-            continue;
+/**
+ * \brief           Get next child, that matches query segment
+ * \param[in,out]   query: Query iterator
+ * \param[in]       depth: Index of query segment
+ * \return          Matching child or `NULL` if there are no more
+ */
+static const lwjson_token_t*
+prv_query_child(lwjson_query_t* query, size_t depth) {
+    const lwjson_query_segment_t* seg = &query->segments[depth];
+    const lwjson_token_t *parent = query->level[depth].parent, *t;
+
+    if (parent == NULL) {
+        return NULL;
+    }
+    while (1) {
+        if (seg->is_array && query->level[depth].index >= seg->end) {
+            return NULL;
         }
+        if (seg->is_array && prv_packed_hdr(parent) != NULL) {
+            t = prv_packed_get(parent, query->level[depth].index, &query->elem);
+        } else {
+            t = query->level[depth].next;
+            if (t != NULL) {
+                query->level[depth].next = lwjson_get_next(t);
+            }
+        }
+        if (t == NULL) {
+            return NULL;
+        }
+        ++query->level[depth].index;
+        if (seg->key != NULL) {
+            size_t name_len = 0;
+            const char* name = lwjson_get_token_name(query->lwobj, t, &name_len);
 
-        /*
-         * Check what are values after the token value
-         *
-         * As per RFC4627, every token value may have one or more
-         * blank characters, followed by one of below options:
-         *  - Comma separator for next token
-         *  - End of array indication
-         *  - End of object indication
-         */
-        res = prv_skip_blank(&pobj);
-        if (res != lwjsonOK) {
-            goto ret;
+            if (name == NULL || name_len != seg->key_len || strncmp(name, seg->key, name_len)) {
+                continue;
+            }
         }
-        /* Check if valid string is availabe after */
-        if (pobj.p == NULL || *pobj.p == '\0' || (*pobj.p != ',' && *pobj.p != ']' && *pobj.p != '}')) {
-            res = lwjsonERRJSON;
-            goto ret;
-        } else if (*pobj.p == ',') { /* Check to advance to next token immediatey */
-            ++pobj.p;
+        if (seg->op == LWJSON_QUERY_OP_NONE || prv_query_match(query->lwobj, seg, t)) {
+            return t;
         }
     }
-    if (to != &lwobj->first_token || (to != NULL && to->next != NULL)) {
-        res = lwjsonERRJSON;
-        to = NULL;
+}
+
+/**
+ * \brief           Start query, that returns all matching tokens with \ref lwjson_query_next function
+ *
+ * Query uses \ref lwjson_find path syntax with segments, separated by `.`, and extends it with:
+ *  - `*` for any member of object
+ *  - `#` for any element of array, `#N` for element with index `N`
+ *    and `#N:M` for elements from index `N` up to, but not including, `M`. Both indexes of slice are optional
+ *  - Predicate `[key op value]` after `*` or `#` segment, that selects only objects with
+ *    child member `key` compared to `value`. Operators are `==`, `!=`, `<`, `<=`, `>` and `>=`.
+ *    Value is number, string in double quotes, `true`, `false` or `null`. Only numbers are ordered
+ *
+ * Example: `items.#[type == "x"].price` returns `price` member of every `items` element with `type` set to `"x"`.
+ *
+ * Search is iterative and uses only memory of the iterator.
+ * Query string must stay valid until search is finished.
+ *
+ * \param[out]      query: Query iterator to initialize
+ * \param[in]       lwobj: LwJSON instance with parsed data
+ * \param[in]       token: Root token to start search at. Set to `NULL` to search from the root of JSON
+ * \param[in]       str: Query string
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_query_begin(lwjson_query_t* query, lwjson_t* lwobj, const lwjson_token_t* token, const char* str) {
+    if (query == NULL) {
+        return lwjsonERRPAR;
     }
-    if (to != NULL) {
-        if (to->type != LWJSON_TYPE_ARRAY && to->type != LWJSON_TYPE_OBJECT) {
-            res = lwjsonERRJSON;
-        }
-        to->token_name = NULL;
-        to->token_name_len = 0;
+    query->lwobj = lwobj;
+    query->segments_cnt = 0;
+    query->depth = 0;
+    if (lwobj == NULL || !lwobj->flags.parsed || str == NULL || *str == '\0') {
+        return lwjsonERRPAR;
     }
-ret:
-    if (res == lwjsonOK) {
-        lwobj->flags.parsed = 1;
+    while (*str != '\0') {
+        if (query->segments_cnt == LWJSON_ARRAYSIZE(query->segments)
+            || prv_query_segment(&str, &query->segments[query->segments_cnt]) != lwjsonOK) {
+            query->segments_cnt = 0;
+            return lwjsonERRPAR;
+        }
+        ++query->segments_cnt;
     }
-    return res;
+    prv_query_level(query, 0, token != NULL ? token : lwjson_get_first_token(lwobj));
+    query->depth = 1;
+    return lwjsonOK;
 }
 
 /**
- * \brief           Parse input JSON format
- * JSON format must be complete and must comply with RFC4627
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       json_str: JSON string to parse
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Get next token, that matches the query
+ *
+ * Tokens are returned in document order.
+ * Element of packed array is returned in the token inside iterator,
+ * that is valid until next call of the function
+ *
+ * \param[in,out]   query: Query iterator, initialized with \ref lwjson_query_begin
+ * \return          Next matching token, `NULL` when there are no more matches
  */
-lwjsonr_t
-lwjson_parse(lwjson_t* lwobj, const char* json_str) {
-    return lwjson_parse_ex(lwobj, json_str, strlen(json_str));
+const lwjson_token_t*
+lwjson_query_next(lwjson_query_t* query) {
+    if (query == NULL) {
+        return NULL;
+    }
+    while (query->depth > 0) {
+        const lwjson_token_t* t = prv_query_child(query, query->depth - 1);
+
+        if (t == NULL) {
+            --query->depth;
+        } else if (query->depth == query->segments_cnt) {
+            return t;
+        } else {
+            prv_query_level(query, query->depth++, t);
+        }
+    }
+    return NULL;
 }
 
+#if LWJSON_CFG_ALLOC
+
 /**
- * \brief           Free token instances (specially used in case of dynamic memory allocation)
- * \param[in,out]   lwobj: LwJSON instance
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Get position of the token in order of allocation
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Token from tokens array or from dynamically allocated block
+ * \return          Token position, `SIZE_MAX` if token does not belong to the instance
  */
-lwjsonr_t
-lwjson_free(lwjson_t* lwobj) {
-    LWJSON_MEMSET(lwobj->tokens, 0x00, sizeof(*lwobj->tokens) * lwobj->tokens_len);
-    lwobj->flags.parsed = 0;
-    return lwjsonOK;
+static size_t
+prv_token_pos(const lwjson_t* lwobj, const lwjson_token_t* token) {
+    size_t base = lwobj->tokens_len;
+
+    if (lwobj->tokens != NULL && token >= lwobj->tokens && token < &lwobj->tokens[lwobj->tokens_len]) {
+        return (size_t)(token - lwobj->tokens);
+    }
+    for (const lwjson_token_block_t* b = lwobj->blocks; b != NULL; b = b->next) {
+        if (token >= b->tokens && token < &b->tokens[b->tokens_len]) {
+            return base + (size_t)(token - b->tokens);
+        }
+        base += b->tokens_len;
+    }
+    return SIZE_MAX;
 }
 
+#endif /* LWJSON_CFG_ALLOC */
+
 /**
- * \brief           Find first match in the given path for JSON entry
- * JSON must be valid and parsed with \ref lwjson_parse function
- * \param[in]       lwobj: JSON instance with parsed JSON string
- * \param[in]       path: Path with dot-separated entries to search for the JSON key to return
- * \return          Pointer to found token on success, `NULL` if token cannot be found
+ * \brief           Get the first token after the token and all its descendants
+ *
+ * Tokens are stored in document order, and every object or array knows the size of its subtree,
+ * so even large subtree is skipped in constant time.
+ * Returned token is the next sibling of the token, or the next token of its parent,
+ * when the token is the last child.
+ *
+ * \note            When \ref LWJSON_CFG_ALLOC is enabled, time depends on the number of allocated blocks
+ *
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Token to skip
+ * \return          Next token in document order, `NULL` if token is the last one
  */
 const lwjson_token_t*
-lwjson_find(lwjson_t* lwobj, const char* path) {
-    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+lwjson_skip_subtree(const lwjson_t* lwobj, const lwjson_token_t* token) {
+    size_t pos;
+
+    if (lwobj == NULL || token == NULL || !lwobj->flags.parsed) {
+        return NULL;
+    }
+#if LWJSON_CFG_COMPACT_TOKENS
+    pos = (size_t)(token - lwobj->tokens);
+#else
+    if (token == &lwobj->first_token) {
+        return NULL;
+    }
+#if LWJSON_CFG_ALLOC
+    pos = prv_token_pos(lwobj, token);
+    if (pos == SIZE_MAX) {
         return NULL;
     }
-    return prv_find(lwjson_get_first_token(lwobj), path);
+#else
+    pos = (size_t)(token - lwobj->tokens);
+#endif /* LWJSON_CFG_ALLOC */
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    pos += 1 + lwjson_get_subtree_size(token);
+    if (pos >= lwobj->next_free_token_pos) {
+        return NULL;
+    }
+#if LWJSON_CFG_ALLOC
+    if (pos >= lwobj->tokens_len) {
+        pos -= lwobj->tokens_len;
+        for (const lwjson_token_block_t* b = lwobj->blocks; b != NULL; b = b->next) {
+            if (pos < b->tokens_len) {
+                return &b->tokens[pos];
+            }
+            pos -= b->tokens_len;
+        }
+        return NULL;
+    }
+#endif /* LWJSON_CFG_ALLOC */
+    return &lwobj->tokens[pos];
 }
 
 /**
- * \brief           Find first match in the given path for JSON path
- * JSON must be valid and parsed with \ref lwjson_parse function
+ * \brief           Get packed values of array, parsed with \ref LWJSON_CFG_PACKED_ARRAYS enabled
  *
- * \param[in]       lwobj: JSON instance with parsed JSON string
- * \param[in]       token: Root token to start search at.
- *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
- *                      Set to `NULL` to use root token of LwJSON object
- * \param[in]       path: path with dot-separated entries to search for JSON key
- * \return          Pointer to found token on success, `NULL` if token cannot be found
+ * Values are stored as `lwjson_int_t` array for \ref LWJSON_TYPE_NUM_INT type,
+ * `lwjson_real_t` array for \ref LWJSON_TYPE_NUM_REAL type
+ * and `uint8_t` array with `0` or `1` values for \ref LWJSON_TYPE_TRUE type, used for `true` and `false` values
+ *
+ * \param[in]       token: Array token
+ * \param[out]      type: Output variable for type of values. Can be set to `NULL` if not used
+ * \param[out]      len: Output variable for number of values. Can be set to `NULL` if not used
+ * \return          Pointer to the first value, `NULL` if array is not packed
+ */
+const void*
+lwjson_get_packed(const lwjson_token_t* token, lwjson_type_t* type, size_t* len) {
+#if LWJSON_CFG_PACKED_ARRAYS
+    const lwjson_packed_hdr_t* hdr = prv_packed_hdr(token);
+
+    if (hdr == NULL) {
+        return NULL;
+    }
+    if (type != NULL) {
+        *type = (lwjson_type_t)hdr->h.type;
+    }
+    if (len != NULL) {
+        *len = hdr->h.len;
+    }
+    return hdr + 1;
+#else
+    (void)token;
+    (void)type;
+    (void)len;
+    return NULL;
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+}
+
+/**
+ * \brief           Initialize iterator over elements of array
+ * \param[out]      iter: Iterator to initialize
+ * \param[in]       array: Array token, packed or not
+ */
+void
+lwjson_array_iter_init(lwjson_array_iter_t* iter, const lwjson_token_t* array) {
+    LWJSON_MEMSET(iter, 0x00, sizeof(*iter));
+    if (array != NULL && array->type == LWJSON_TYPE_ARRAY) {
+        iter->array = array;
+        iter->next = lwjson_get_first_child(array);
+    }
+}
+
+/**
+ * \brief           Get next element of array
+ *
+ * Elements of packed array are returned in the token inside iterator,
+ * that is valid until next call of the function
+ *
+ * \param[in,out]   iter: Iterator, initialized with \ref lwjson_array_iter_init
+ * \return          Next element token, `NULL` when there are no more elements
  */
 const lwjson_token_t*
-lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path) {
-    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+lwjson_array_iter_next(lwjson_array_iter_t* iter) {
+    const lwjson_token_t* t;
+
+    if (iter->array == NULL) {
         return NULL;
     }
-    if (token == NULL) {
-        token = lwjson_get_first_token(lwobj);
+    if (prv_packed_hdr(iter->array) != NULL) {
+        t = prv_packed_get(iter->array, iter->index, &iter->elem);
+    } else {
+        t = iter->next;
+        if (t != NULL) {
+            iter->next = lwjson_get_next(t);
+        }
     }
-    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+    if (t != NULL) {
+        ++iter->index;
+    }
+    return t;
+}
+
+/**
+ * \brief           Get element of array by index
+ *
+ * With \ref LWJSON_CFG_ARRAY_INDEX enabled, elements of arrays
+ * with at least \ref LWJSON_CFG_ARRAY_INDEX_MIN_ELEMENTS elements are accessed in constant time.
+ * Other arrays are walked from the first element.
+ *
+ * Elements of packed arrays have no tokens, use \ref lwjson_array_get_ex function for them
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       token: Array token
+ * \param[in]       index: Index of the element
+ * \return          Element token, `NULL` if token is not an array, array is packed or index is out of range
+ */
+const lwjson_token_t*
+lwjson_array_get(lwjson_t* lwobj, const lwjson_token_t* token, size_t index) {
+    return lwjson_array_get_ex(lwobj, token, index, NULL);
+}
+
+/**
+ * \brief           Get element of array by index, including elements of packed arrays
+ *
+ * Same as \ref lwjson_array_get, but value of packed array element is copied to `elem` token,
+ * owned by the application. Elements of packed arrays are accessed in constant time.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       token: Array token
+ * \param[in]       index: Index of the element
+ * \param[out]      elem: Token to copy value of packed array element to.
+ *                      Can be set to `NULL` to access only arrays, that are not packed
+ * \return          Element token or `elem` for packed array,
+ *                      `NULL` if token is not an array or index is out of range
+ */
+const lwjson_token_t*
+lwjson_array_get_ex(lwjson_t* lwobj, const lwjson_token_t* token, size_t index, lwjson_token_t* elem) {
+    if (lwobj == NULL || token == NULL || token->type != LWJSON_TYPE_ARRAY || !lwobj->flags.parsed) {
         return NULL;
     }
-    return prv_find(token, path);
+    if (prv_packed_hdr(token) != NULL) {
+        return elem != NULL ? prv_packed_get(token, index, elem) : NULL;
+    }
+    return prv_array_get(lwobj, token, index);
+}
+
+/**
+ * \brief           Get number of elements of array
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       token: Array token
+ * \return          Number of elements, `0` if token is not an array
+ */
+size_t
+lwjson_array_size(lwjson_t* lwobj, const lwjson_token_t* token) {
+    size_t cnt = 0;
+
+    if (lwobj == NULL || token == NULL || token->type != LWJSON_TYPE_ARRAY || !lwobj->flags.parsed) {
+        return 0;
+    }
+    if (prv_packed_hdr(token) != NULL) {
+        lwjson_get_packed(token, NULL, &cnt);
+        return cnt;
+    }
+#if LWJSON_CFG_ARRAY_INDEX
+    {
+        const lwjson_index_t* idx = prv_array_index_get(lwobj, token);
+
+        if (idx != NULL) {
+            return idx->size;
+        }
+    }
+#endif /* LWJSON_CFG_ARRAY_INDEX */
+    for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
+        ++cnt;
+    }
+    return cnt;
 }
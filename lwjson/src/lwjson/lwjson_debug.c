@@ -39,7 +39,9 @@
  * \brief           Token print instance
  */
 typedef struct {
-    size_t indent; /*!< Indent level for token print */
+    const lwjson_t* lwobj; /*!< LwJSON instance tokens belong to. Can be `NULL` */
+    size_t indent;         /*!< Indent level for token print */
+    uint8_t packed_next;   /*!< Set to `1` when printed packed array value is followed by next one */
 } lwjson_token_print_t;
 
 /**
@@ -51,25 +53,46 @@ static void
 prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
 #define print_indent() printf("%.*s", (int)((prt->indent)), "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t");
 
+    const char* str;
+    size_t str_len;
+
     if (token == NULL) {
         return;
     }
 
     /* Check if token has a name */
     print_indent();
-    if (token->token_name != NULL) {
-        printf("\"%.*s\":", (int)token->token_name_len, token->token_name);
+    str = lwjson_get_token_name(prt->lwobj, token, &str_len);
+    if (str != NULL) {
+        printf("\"%.*s\":", (int)str_len, str);
     }
 
     /* Print different types */
     switch (token->type) {
         case LWJSON_TYPE_OBJECT:
         case LWJSON_TYPE_ARRAY: {
+            size_t len;
+
             printf("%c", token->type == LWJSON_TYPE_OBJECT ? '{' : '[');
-            if (token->u.first_child != NULL) {
+            if (lwjson_get_packed(token, NULL, &len) != NULL) {
+                lwjson_array_iter_t iter;
+
+                /* Values of packed array are printed from iterator tokens */
+                printf("\n");
+                ++prt->indent;
+                lwjson_array_iter_init(&iter, token);
+                for (const lwjson_token_t* t = lwjson_array_iter_next(&iter); t != NULL;
+                     t = lwjson_array_iter_next(&iter)) {
+                    prt->packed_next = iter.index < len;
+                    prv_print_token(prt, t);
+                }
+                prt->packed_next = 0;
+                --prt->indent;
+                print_indent();
+            } else if (lwjson_get_first_child(token) != NULL) {
                 printf("\n");
                 ++prt->indent;
-                for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = t->next) {
+                for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
                     prv_print_token(prt, t);
                 }
                 --prt->indent;
@@ -79,7 +102,8 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
             break;
         }
         case LWJSON_TYPE_STRING: {
-            printf("\"%.*s\"", (int)lwjson_get_val_string_length(token), lwjson_get_val_string(token, NULL));
+            str = lwjson_get_val_string_ex(prt->lwobj, token, &str_len);
+            printf("\"%.*s\"", str != NULL ? (int)str_len : 0, str != NULL ? str : "");
             break;
         }
         case LWJSON_TYPE_NUM_INT: {
@@ -104,7 +128,7 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
         }
         default: break;
     }
-    if (token->next != NULL) {
+    if (lwjson_get_next(token) != NULL || prt->packed_next) {
         printf(",");
     }
     printf("\n");
@@ -113,6 +137,8 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
 /**
  * \brief           Prints and outputs token data to the stream output
  * \note            This function is not re-entrant
+ * \note            Strings and names are not printed with \ref LWJSON_CFG_COMPACT_TOKENS enabled,
+ *                      use \ref lwjson_print_json instead
  * \param[in]       token: Token to print
  */
 void
@@ -129,5 +155,6 @@ lwjson_print_token(const lwjson_token_t* token) {
 void
 lwjson_print_json(const lwjson_t* lwobj) {
     lwjson_token_print_t prt = {0};
+    prt.lwobj = lwobj;
     prv_print_token(&prt, lwjson_get_first_token(lwobj));
 }
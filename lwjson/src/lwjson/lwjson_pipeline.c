@@ -0,0 +1,921 @@
+/**
+ * \file            lwjson_pipeline.c
+ * \brief           Multi-threaded parser for newline delimited JSON data
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwJSON - Lightweight JSON format parser.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.7.0
+ */
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "lwjson/lwjson.h"
+
+/* Workers split their fixed array of tokens between records, dynamic allocation is not supported */
+#if !LWJSON_CFG_ALLOC || __DOXYGEN__
+
+/* Default values for configuration parameters set to `0` */
+#define LWJSON_PIPELINE_DEF_WORKERS    4
+#define LWJSON_PIPELINE_DEF_TOKENS     1024
+#define LWJSON_PIPELINE_DEF_CHUNK_LEN  65536
+#define LWJSON_PIPELINE_DEF_BATCH_RECS 256
+
+/* Minimal length of data, parsed by one worker in parallel parsing mode */
+#define LWJSON_PIPELINE_PAR_MIN_LEN 65536
+
+/*
+ * Minimal data length and number of processors to parse in parallel, when number of workers is not set.
+ * Scan and link passes take about as long as single-threaded parse together,
+ * so parallel parsing wins only with at least 3 threads and when thread start is small compared to parsing.
+ */
+#define LWJSON_PIPELINE_PAR_DEF_MIN_LEN     (1024UL * 1024UL)
+#define LWJSON_PIPELINE_PAR_DEF_MIN_WORKERS 3
+
+/**
+ * \brief           Parsed record, waiting to be delivered in input order
+ */
+typedef struct {
+    lwjson_t lwobj;     /*!< Instance with record tokens */
+    const char* record; /*!< Record data */
+    size_t len;         /*!< Record length */
+    lwjsonr_t res;      /*!< Parse result */
+} lwjson_pipeline_rec_t;
+
+/**
+ * \brief           Worker thread with its own range of chunks and tokens
+ */
+typedef struct {
+    struct lwjson_pipeline* pl; /*!< Pipeline the worker belongs to */
+    pthread_t thread;           /*!< Worker thread */
+    pthread_mutex_t lock;       /*!< Protects range of chunks, owner and thieves take chunks from it */
+    size_t begin;               /*!< First chunk in the range, taken by the owner */
+    size_t end;                 /*!< End of the range, thieves take chunks from this side */
+    lwjson_token_t* tokens;     /*!< Tokens of the worker */
+    lwjson_pipeline_rec_t* recs; /*!< Records parsed in current batch, used in ordered mode */
+    size_t recs_cnt;            /*!< Number of records in current batch */
+} lwjson_pipeline_worker_t;
+
+/**
+ * \brief           Pipeline instance
+ */
+typedef struct lwjson_pipeline {
+    const lwjson_pipeline_cfg_t* cfg; /*!< Configuration */
+    const char* data;                 /*!< Data with all records */
+    size_t* chunks;                   /*!< Start positions of chunks, followed by data length */
+    size_t chunks_cnt;                /*!< Number of chunks */
+    lwjson_pipeline_worker_t* workers; /*!< Worker threads */
+    size_t workers_cnt;               /*!< Number of worker threads */
+    size_t tokens_len;                /*!< Number of tokens of every worker */
+    size_t batch_recs;                /*!< Max number of records in a batch, in ordered mode */
+    pthread_mutex_t order_lock;       /*!< Protects chunk delivery order */
+    pthread_cond_t order_cond;        /*!< Signals that next chunk can be delivered or that workers can start */
+    size_t order_next;                /*!< Next chunk to deliver records from */
+    uint8_t running;                  /*!< Set to `1` once chunks are split between started workers */
+} lwjson_pipeline_t;
+
+/**
+ * \brief           Take next chunk from worker's own range or steal half of the range from another worker
+ * \param[in,out]   w: Worker
+ * \param[out]      chunk: Output variable for chunk index
+ * \return          `1` if chunk is available, `0` when all chunks are processed
+ */
+static uint8_t
+prv_next_chunk(lwjson_pipeline_worker_t* w, size_t* chunk) {
+    lwjson_pipeline_t* pl = w->pl;
+    size_t idx = (size_t)(w - pl->workers);
+    uint8_t found = 0;
+
+    pthread_mutex_lock(&w->lock);
+    if (w->begin < w->end) {
+        *chunk = w->begin++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&w->lock);
+    if (found) {
+        return 1;
+    }
+
+    /* Own range is empty, steal back half of other worker's range */
+    for (size_t i = 1; i < pl->workers_cnt && !found; ++i) {
+        lwjson_pipeline_worker_t* v = &pl->workers[(idx + i) % pl->workers_cnt];
+        size_t begin = 0, end = 0;
+
+        pthread_mutex_lock(&v->lock);
+        if (v->begin < v->end) {
+            end = v->end;
+            begin = v->end - (v->end - v->begin + 1) / 2;
+            v->end = begin;
+            found = 1;
+        }
+        pthread_mutex_unlock(&v->lock);
+
+        /* Process first stolen chunk now, keep the rest in own range */
+        if (found) {
+            *chunk = begin;
+            pthread_mutex_lock(&w->lock);
+            w->begin = begin + 1;
+            w->end = end;
+            pthread_mutex_unlock(&w->lock);
+        }
+    }
+    return found;
+}
+
+/**
+ * \brief           Deliver records of current batch to the user, once all previous chunks are delivered
+ * \param[in,out]   w: Worker
+ * \param[in]       chunk: Chunk index the batch belongs to
+ */
+static void
+prv_flush_batch(lwjson_pipeline_worker_t* w, size_t chunk) {
+    lwjson_pipeline_t* pl = w->pl;
+
+    pthread_mutex_lock(&pl->order_lock);
+    while (pl->order_next != chunk) {
+        pthread_cond_wait(&pl->order_cond, &pl->order_lock);
+    }
+    pthread_mutex_unlock(&pl->order_lock);
+
+    for (size_t i = 0; i < w->recs_cnt; ++i) {
+        lwjson_pipeline_rec_t* r = &w->recs[i];
+        pl->cfg->record_fn(pl->cfg->user_data, &r->lwobj, r->record, r->len, r->res);
+    }
+    w->recs_cnt = 0;
+}
+
+/**
+ * \brief           Parse all records of one chunk
+ *
+ * Records are parsed as separate documents of the chunk,
+ * on error parsing continues at the next line.
+ *
+ * \param[in,out]   w: Worker
+ * \param[in]       chunk: Chunk index
+ */
+static void
+prv_process_chunk(lwjson_pipeline_worker_t* w, size_t chunk) {
+    lwjson_pipeline_t* pl = w->pl;
+    const char* data = pl->data + pl->chunks[chunk];
+    size_t data_len = pl->chunks[chunk + 1] - pl->chunks[chunk];
+    size_t pos = 0, len, skip, tokens_used = 0;
+    lwjson_t* lwobj = &w->recs[0].lwobj;
+    lwjsonr_t res;
+
+    lwjson_init(lwobj, w->tokens, pl->tokens_len);
+    for (;;) {
+        if (pl->cfg->ordered) {
+            /* Every record in the batch gets its own part of the tokens */
+            lwobj = &w->recs[w->recs_cnt].lwobj;
+            if (w->recs_cnt > 0) {
+                *lwobj = w->recs[w->recs_cnt - 1].lwobj;
+            }
+            lwobj->tokens = w->tokens + tokens_used;
+            lwobj->tokens_len = pl->tokens_len - tokens_used;
+        }
+        res = lwjson_parse_many(lwobj, data, data_len, &pos, &len);
+        if (res == lwjsonPARSEEND) {
+            break;
+        }
+
+        /* Batch is full, deliver it and parse the record again with all tokens */
+        if (pl->cfg->ordered && res == lwjsonERRMEM && w->recs_cnt > 0) {
+            prv_flush_batch(w, chunk);
+            tokens_used = 0;
+            continue;
+        }
+
+        /*
+         * Invalid record ends with its line, parsing continues after its newline.
+         * Blank characters before it are skipped, as position is not moved when `NULL` character follows them
+         */
+        skip = 0;
+        if (res != lwjsonOK) {
+            const char* nl;
+
+            for (; pos < data_len && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n');
+                 ++pos) {}
+            nl = memchr(data + pos, '\n', data_len - pos);
+            len = nl != NULL ? (size_t)(nl - data - pos) : data_len - pos;
+            skip = nl != NULL ? 1 : 0;
+        }
+        if (pl->cfg->ordered) {
+            lwjson_pipeline_rec_t* r = &w->recs[w->recs_cnt++];
+
+            r->record = data + pos;
+            r->len = len;
+            r->res = res;
+            tokens_used += lwjson_get_tokens_used(lwobj);
+            if (w->recs_cnt == pl->batch_recs || tokens_used >= pl->tokens_len) {
+                prv_flush_batch(w, chunk);
+                tokens_used = 0;
+            }
+        } else {
+            pl->cfg->record_fn(pl->cfg->user_data, lwobj, data + pos, len, res);
+        }
+        pos += len + skip;
+    }
+
+    /* Deliver last records and let next chunk be delivered */
+    if (pl->cfg->ordered) {
+        prv_flush_batch(w, chunk);
+        pthread_mutex_lock(&pl->order_lock);
+        ++pl->order_next;
+        pthread_cond_broadcast(&pl->order_cond);
+        pthread_mutex_unlock(&pl->order_lock);
+    }
+}
+
+/**
+ * \brief           Worker thread entry
+ * \param[in]       arg: Worker
+ * \return          `NULL`
+ */
+static void*
+prv_worker_thread(void* arg) {
+    lwjson_pipeline_worker_t* w = arg;
+    lwjson_pipeline_t* pl = w->pl;
+    size_t chunk;
+
+    /* Wait until it is known, which workers were started */
+    pthread_mutex_lock(&pl->order_lock);
+    while (!pl->running) {
+        pthread_cond_wait(&pl->order_cond, &pl->order_lock);
+    }
+    pthread_mutex_unlock(&pl->order_lock);
+
+    while (prv_next_chunk(w, &chunk)) {
+        prv_process_chunk(w, chunk);
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Split data to chunks of complete lines, each at least `chunk_len` bytes long
+ * \param[in,out]   pl: Pipeline instance
+ * \param[in]       len: Data length
+ * \param[in]       chunk_len: Minimal chunk length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_split_chunks(lwjson_pipeline_t* pl, size_t len, size_t chunk_len) {
+    size_t max_cnt = len / chunk_len + 1, pos = 0;
+
+    pl->chunks = LWJSON_MALLOC((max_cnt + 1) * sizeof(*pl->chunks));
+    if (pl->chunks == NULL) {
+        return lwjsonERRMEM;
+    }
+    pl->chunks_cnt = 0;
+    while (pos < len) {
+        const char* nl = NULL;
+
+        pl->chunks[pl->chunks_cnt++] = pos;
+        if (len - pos > chunk_len) {
+            nl = memchr(pl->data + pos + chunk_len, '\n', len - pos - chunk_len);
+        }
+        pos = nl != NULL ? (size_t)(nl - pl->data) + 1 : len;
+    }
+    pl->chunks[pl->chunks_cnt] = len;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Parse newline delimited JSON data with several worker threads
+ *
+ * Data is split to chunks of complete lines, that are distributed evenly between workers.
+ * If some worker threads cannot be started, chunks are distributed only between started ones.
+ * Worker, that finishes its chunks, steals half of the remaining chunks of another worker.
+ * Every worker parses with its own instance and tokens, and calls `record_fn` for every record.
+ *
+ * In unordered mode, `record_fn` is called from all workers at the same time,
+ * as soon as record is parsed. In ordered mode, calls are serialized and follow input order.
+ * Workers parse records in batches ahead of delivery and wait only when batch is full.
+ *
+ * Function returns once all records are delivered.
+ *
+ * \param[in]       cfg: Pipeline configuration
+ * \param[in]       data: Newline delimited JSON data
+ * \param[in]       len: Data length
+ * \return          \ref lwjsonOK on success, \ref lwjsonERR if no worker thread can be started,
+ *                      member of \ref lwjsonr_t otherwise. Errors of the records are reported to `record_fn`
+ */
+lwjsonr_t
+lwjson_pipeline_run(const lwjson_pipeline_cfg_t* cfg, const void* data, size_t len) {
+    lwjson_pipeline_t pl;
+    lwjsonr_t res = lwjsonOK;
+    size_t workers_cnt, prepared = 0, started = 0, chunk_len;
+
+    /* Check input parameters */
+    if (cfg == NULL || cfg->record_fn == NULL || data == NULL) {
+        return lwjsonERRPAR;
+    }
+    LWJSON_MEMSET(&pl, 0x00, sizeof(pl));
+    pl.cfg = cfg;
+    pl.data = data;
+    workers_cnt = cfg->workers > 0 ? cfg->workers : LWJSON_PIPELINE_DEF_WORKERS;
+    pl.tokens_len = cfg->tokens_len > 0 ? cfg->tokens_len : LWJSON_PIPELINE_DEF_TOKENS;
+    pl.batch_recs = cfg->ordered ? (cfg->batch_recs > 0 ? cfg->batch_recs : LWJSON_PIPELINE_DEF_BATCH_RECS) : 1;
+    chunk_len = cfg->chunk_len > 0 ? cfg->chunk_len : LWJSON_PIPELINE_DEF_CHUNK_LEN;
+
+    /* Reader stage splits data at line boundaries */
+    if ((res = prv_split_chunks(&pl, len, chunk_len)) != lwjsonOK) {
+        return res;
+    }
+    pl.workers = LWJSON_MALLOC(workers_cnt * sizeof(*pl.workers));
+    if (pl.workers == NULL) {
+        LWJSON_FREE(pl.chunks);
+        return lwjsonERRMEM;
+    }
+    LWJSON_MEMSET(pl.workers, 0x00, workers_cnt * sizeof(*pl.workers));
+    pthread_mutex_init(&pl.order_lock, NULL);
+    pthread_cond_init(&pl.order_cond, NULL);
+
+    /* Prepare workers and start them, they wait until chunks are split */
+    for (; prepared < workers_cnt; ++prepared) {
+        lwjson_pipeline_worker_t* w = &pl.workers[prepared];
+
+        w->pl = &pl;
+        pthread_mutex_init(&w->lock, NULL);
+        w->tokens = LWJSON_MALLOC(pl.tokens_len * sizeof(*w->tokens));
+        w->recs = LWJSON_MALLOC(pl.batch_recs * sizeof(*w->recs));
+        if (w->tokens == NULL || w->recs == NULL) {
+            res = lwjsonERRMEM;
+            ++prepared;
+            break;
+        }
+    }
+    for (; res == lwjsonOK && started < workers_cnt; ++started) {
+        if (LWJSON_THREAD_CREATE(&pl.workers[started].thread, NULL, prv_worker_thread, &pl.workers[started]) != 0) {
+            break;
+        }
+    }
+    if (res == lwjsonOK && started == 0) {
+        res = lwjsonERR;
+    }
+
+    /* Split chunks evenly between started workers only, so no chunk waits for a worker that does not exist */
+    pthread_mutex_lock(&pl.order_lock);
+    pl.workers_cnt = started;
+    for (size_t i = 0; i < started; ++i) {
+        pl.workers[i].begin = pl.chunks_cnt * i / started;
+        pl.workers[i].end = pl.chunks_cnt * (i + 1) / started;
+    }
+    pl.running = 1;
+    pthread_cond_broadcast(&pl.order_cond);
+    pthread_mutex_unlock(&pl.order_lock);
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(pl.workers[i].thread, NULL);
+    }
+
+    /* Release all resources */
+    for (size_t i = 0; i < prepared; ++i) {
+        pthread_mutex_destroy(&pl.workers[i].lock);
+        LWJSON_FREE(pl.workers[i].tokens);
+        LWJSON_FREE(pl.workers[i].recs);
+    }
+    pthread_cond_destroy(&pl.order_cond);
+    pthread_mutex_destroy(&pl.order_lock);
+    LWJSON_FREE(pl.workers);
+    LWJSON_FREE(pl.chunks);
+    return res;
+}
+
+/**
+ * \brief           Part of JSON data in parallel parsing mode
+ */
+typedef struct {
+    pthread_t thread;       /*!< Worker thread */
+    uint8_t started;        /*!< Set to `1` when worker thread is started */
+    const char* data;       /*!< JSON data */
+    size_t begin;           /*!< Offset of the part */
+    size_t end;             /*!< Offset of the end of the part */
+    uint8_t quotes;         /*!< Parity of number of quotes in the part */
+    uint8_t has_nul;        /*!< Set to `1` if part contains `NULL` character */
+    uint8_t in_str;         /*!< Set to `1` if part begins inside of a string */
+    long depth_out;         /*!< Change of nesting depth, if part begins outside of a string */
+    long depth_in;          /*!< Change of nesting depth, if part begins inside of a string */
+    long depth;             /*!< Nesting depth at the beginning of the part */
+    size_t split;           /*!< Offset of the first member of the root in the part, `SIZE_MAX` if none */
+    lwjson_type_t type;     /*!< Type of the root */
+    lwjson_t lwobj;         /*!< Instance with tokens of the part */
+    lwjsonr_t res;          /*!< Result of parsing the part */
+    lwjson_token_t* base;   /*!< Tokens, the part was parsed to, links between tokens point there */
+    lwjson_token_t* first;  /*!< First member of the root in the part */
+    lwjson_token_t* last;   /*!< Last member of the root in the part */
+    ptrdiff_t delta;        /*!< Distance, tokens were moved by after parsing */
+} lwjson_par_part_t;
+
+/**
+ * \brief           Check if character is escaped by odd number of backslashes before it
+ * \param[in]       data: JSON data
+ * \param[in]       pos: Position of the character
+ * \return          `1` if character is escaped, `0` otherwise
+ */
+static uint8_t
+prv_par_is_escaped(const char* data, size_t pos) {
+    uint8_t esc = 0;
+
+    for (; pos > 0 && data[pos - 1] == '\\'; --pos) {
+        esc ^= 1;
+    }
+    return esc;
+}
+
+/* Character classes for scanning, brackets change nesting depth */
+#define LWJSON_PAR_QUOTE  2
+#define LWJSON_PAR_ESCAPE 3
+#define LWJSON_PAR_NUL    4
+
+static const int8_t prv_par_class[256] = {
+    ['['] = 1, ['{'] = 1, [']'] = -1, ['}'] = -1, ['"'] = LWJSON_PAR_QUOTE, ['\\'] = LWJSON_PAR_ESCAPE, ['\0'] = LWJSON_PAR_NUL,
+};
+
+/**
+ * \brief           Count quotes and nesting depth changes of the part, for both possible string states at its beginning
+ * \param[in,out]   arg: Part of JSON data
+ * \return          `NULL`
+ */
+static void*
+prv_par_scan(void* arg) {
+    lwjson_par_part_t* part = arg;
+    const char* data = part->data;
+    long depth_all = 0, depth_out = 0;
+    uint8_t in = 0, nul = 0;
+
+    /* Brackets inside of strings are counted once all brackets and brackets outside of strings are known */
+    for (size_t i = part->begin + prv_par_is_escaped(data, part->begin); i < part->end; ++i) {
+        int8_t c = prv_par_class[(uint8_t)data[i]];
+
+        if (c <= 1) {
+            depth_all += c;
+            depth_out += c & ((int8_t)in - 1);
+        } else if (c == LWJSON_PAR_QUOTE) {
+            in ^= 1;
+        } else if (c == LWJSON_PAR_ESCAPE) {
+            ++i;
+        } else {
+            nul = 1;
+        }
+    }
+
+    /* Characters outside of strings, if part begins inside of a string, are inside of strings otherwise */
+    part->quotes = in;
+    part->has_nul = nul;
+    part->depth_out = depth_out;
+    part->depth_in = depth_all - depth_out;
+    return NULL;
+}
+
+/**
+ * \brief           Find first comma separating members of the root in the part
+ * \param[in,out]   arg: Part of JSON data with known string state and depth at the beginning
+ * \return          `NULL`
+ */
+static void*
+prv_par_split(void* arg) {
+    lwjson_par_part_t* part = arg;
+    const char* data = part->data;
+    long depth = part->depth;
+    uint8_t in = part->in_str;
+
+    part->split = SIZE_MAX;
+    for (size_t i = part->begin + prv_par_is_escaped(data, part->begin); i < part->end; ++i) {
+        if (data[i] == '\\') {
+            ++i;
+        } else if (data[i] == '"') {
+            in ^= 1;
+        } else if (!in) {
+            if (data[i] == '[' || data[i] == '{') {
+                ++depth;
+            } else if (data[i] == ']' || data[i] == '}') {
+                --depth;
+            } else if (data[i] == ',' && depth == 1) {
+                part->split = i;
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Parse members of the root in the part and find the first and the last one
+ * \param[in,out]   arg: Part of JSON data with assigned tokens
+ * \return          `NULL`
+ */
+static void*
+prv_par_parse(void* arg) {
+    lwjson_par_part_t* part = arg;
+    lwjson_t* lwobj = &part->lwobj;
+
+    part->base = lwobj->tokens;
+    part->res = lwjson_parse_fragment(lwobj, part->data, part->begin, part->end, part->type);
+    part->first = part->last = NULL;
+    if (part->res == lwjsonOK || part->res == lwjsonPARSEINPROG) {
+        const lwjson_token_t* root = lwjson_get_first_token(lwobj);
+
+        for (const lwjson_token_t* t = lwjson_get_first_child(root); t != NULL; t = lwjson_get_next(t)) {
+            if (part->first == NULL) {
+                part->first = (lwjson_token_t*)t;
+            }
+            part->last = (lwjson_token_t*)t;
+        }
+    }
+    return NULL;
+}
+
+#if !LWJSON_CFG_COMPACT_TOKENS
+
+/**
+ * \brief           Update links between tokens of the part, after tokens were moved
+ * \param[in,out]   arg: Part of JSON data
+ * \return          `NULL`
+ */
+static void*
+prv_par_relocate(void* arg) {
+    lwjson_par_part_t* part = arg;
+    lwjson_token_t* t = part->lwobj.tokens;
+
+    if (part->delta == 0) {
+        return NULL;
+    }
+    for (size_t i = 0; i < part->lwobj.next_free_token_pos; ++i, ++t) {
+        if (t->next != NULL) {
+            t->next += part->delta;
+        }
+        if ((t->type == LWJSON_TYPE_OBJECT || t->type == LWJSON_TYPE_ARRAY) && t->u.cont.first_child != NULL) {
+            t->u.cont.first_child += part->delta;
+        }
+    }
+    return NULL;
+}
+
+#endif /* !LWJSON_CFG_COMPACT_TOKENS */
+
+/**
+ * \brief           Run function for all parts, each in its own thread
+ * \param[in]       fn: Function to run
+ * \param[in,out]   parts: Parts of JSON data
+ * \param[in]       parts_cnt: Number of parts
+ */
+static void
+prv_par_run(void* (*fn)(void*), lwjson_par_part_t* parts, size_t parts_cnt) {
+    /* First part is processed by calling thread, as well as parts, that could not be started */
+    for (size_t i = 1; i < parts_cnt; ++i) {
+        parts[i].started = LWJSON_THREAD_CREATE(&parts[i].thread, NULL, fn, &parts[i]) == 0;
+    }
+    fn(&parts[0]);
+    for (size_t i = 1; i < parts_cnt; ++i) {
+        if (parts[i].started) {
+            pthread_join(parts[i].thread, NULL);
+        } else {
+            fn(&parts[i]);
+        }
+    }
+}
+
+/**
+ * \brief           Split JSON data to parts, that begin with comma between members of the root
+ * \param[in,out]   parts: Parts of JSON data, with range of data to scan set
+ * \param[in]       parts_cnt: Number of parts
+ * \return          Number of parts with members of the root
+ */
+static size_t
+prv_par_split_parts(lwjson_par_part_t* parts, size_t parts_cnt) {
+    size_t cnt = 1;
+    long depth = 1;
+    uint8_t in = 0;
+
+    /* String state and depth at the beginning of every part is known once previous parts are scanned */
+    prv_par_run(prv_par_scan, parts, parts_cnt);
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        if (parts[i].has_nul) {
+            return 0;
+        }
+        parts[i].in_str = in;
+        parts[i].depth = depth;
+        depth += in ? parts[i].depth_in : parts[i].depth_out;
+        in ^= parts[i].quotes;
+    }
+    prv_par_run(prv_par_split, &parts[1], parts_cnt - 1);
+
+    /* Parts without a comma in the root are merged with the previous one */
+    for (size_t i = 1; i < parts_cnt; ++i) {
+        if (parts[i].split != SIZE_MAX) {
+            parts[cnt - 1].end = parts[i].split;
+            parts[cnt].begin = parts[i].split;
+            parts[cnt].end = parts[i].end;
+            ++cnt;
+        } else {
+            parts[cnt - 1].end = parts[i].end;
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Check if part is parsed and only the last part closes the root
+ * \param[in]       part: Parsed part of JSON data
+ * \param[in]       is_last: Set to `1` for the last part
+ * \return          `1` if part is parsed, `0` otherwise
+ */
+static uint8_t
+prv_par_is_parsed(const lwjson_par_part_t* part, uint8_t is_last) {
+    return part->res == lwjsonPARSEINPROG || (is_last && part->res == lwjsonOK);
+}
+
+/**
+ * \brief           Parse parts, that ran out of tokens, again with tokens left unused by other parts
+ *
+ * Tokens are split between parts proportionally to their length, so parts with more tokens per byte
+ * run out of them, even if there are enough tokens in total.
+ * Parsed parts after the first failed one are moved to the end of tokens array,
+ * then parts are placed one after another and failed parts are parsed by calling thread,
+ * each with all tokens up to the next parsed part.
+ *
+ * In compact mode, root token of every part is placed over the last token of the previous part,
+ * as it is not used after parsing, so parts need the same number of tokens as single-threaded parse.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   parts: Parsed parts of JSON data
+ * \param[in]       parts_cnt: Number of parts
+ * \param[in]       tokens_begin: Position of first token of the first part
+ * \return          `1` if all parts are parsed, `0` otherwise
+ */
+static uint8_t
+prv_par_retry(lwjson_t* lwobj, lwjson_par_part_t* parts, size_t parts_cnt, size_t tokens_begin) {
+#if LWJSON_CFG_COMPACT_TOKENS
+    const size_t root = 1;
+#else
+    const size_t root = 0;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    size_t first = 0, pos = lwobj->tokens_len;
+
+    for (; first < parts_cnt && parts[first].res != lwjsonERRMEM; ++first) {}
+    if (first == parts_cnt) {
+        return 1;
+    }
+
+    /* Every part begins at or after its own position, moving right to left never overwrites other parts */
+    for (size_t i = parts_cnt; i-- > first + 1;) {
+        if (parts[i].res != lwjsonERRMEM) {
+            pos -= parts[i].lwobj.next_free_token_pos;
+            LWJSON_MEMMOVE(&lwobj->tokens[pos], parts[i].lwobj.tokens,
+                           parts[i].lwobj.next_free_token_pos * sizeof(*lwobj->tokens));
+            parts[i].lwobj.tokens = &lwobj->tokens[pos];
+            pos += root;
+        }
+    }
+
+    /* Members of the parts are placed one after another, starting at the position of the first one */
+    pos = tokens_begin;
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        if (parts[i].res == lwjsonERRMEM) {
+            size_t end = lwobj->tokens_len;
+#if LWJSON_CFG_COMPACT_TOKENS
+            lwjson_token_t prev = lwobj->tokens[pos - root];
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+
+            for (size_t k = i + 1; k < parts_cnt; ++k) {
+                if (parts[k].res != lwjsonERRMEM) {
+                    end = (size_t)(parts[k].lwobj.tokens - lwobj->tokens) + root;
+                    break;
+                }
+            }
+            parts[i].lwobj.tokens = &lwobj->tokens[pos - root];
+            parts[i].lwobj.tokens_len = end - (pos - root);
+            prv_par_parse(&parts[i]);
+#if LWJSON_CFG_COMPACT_TOKENS
+            lwobj->tokens[pos - root] = prev;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+            if (!prv_par_is_parsed(&parts[i], i + 1 == parts_cnt)) {
+                return 0;
+            }
+        } else if (parts[i].lwobj.tokens != &lwobj->tokens[pos - root]) {
+            LWJSON_MEMMOVE(&lwobj->tokens[pos], &parts[i].lwobj.tokens[root],
+                           (parts[i].lwobj.next_free_token_pos - root) * sizeof(*lwobj->tokens));
+            parts[i].lwobj.tokens = &lwobj->tokens[pos - root];
+        }
+        pos += parts[i].lwobj.next_free_token_pos - root;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Link members of all parts to the root and move tokens to the beginning of tokens array
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   parts: Parsed parts of JSON data
+ * \param[in]       parts_cnt: Number of parts
+ * \param[in]       type: Type of the root
+ */
+static void
+prv_par_link(lwjson_t* lwobj, lwjson_par_part_t* parts, size_t parts_cnt, lwjson_type_t type) {
+    lwjson_token_t* root;
+    lwjson_token_t* last = NULL;
+    size_t pos;
+
+#if LWJSON_CFG_COMPACT_TOKENS
+    /* Root of every part is removed, members are in document order */
+    pos = 1;
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        size_t cnt = parts[i].lwobj.next_free_token_pos - 1;
+        lwjson_token_t* first = &lwobj->tokens[pos];
+
+        LWJSON_MEMMOVE(first, &parts[i].lwobj.tokens[1], cnt * sizeof(*first));
+        if (parts[i].first != NULL) {
+            if (last != NULL) {
+                last->has_next = 1;
+            }
+            last = first + (parts[i].last - parts[i].first);
+        }
+        pos += cnt;
+    }
+    root = &lwobj->tokens[0];
+    LWJSON_MEMSET(root, 0x00, sizeof(*root));
+    root->u.cont.child_tokens = (uint32_t)(pos - 1);
+    lwobj->json_data = parts[0].data;
+#else
+    /* Tokens are moved first, links are updated in parallel after */
+    pos = 0;
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        size_t cnt = parts[i].lwobj.next_free_token_pos;
+
+        if (&lwobj->tokens[pos] != parts[i].lwobj.tokens) {
+            LWJSON_MEMMOVE(&lwobj->tokens[pos], parts[i].lwobj.tokens, cnt * sizeof(*lwobj->tokens));
+        }
+        parts[i].delta = &lwobj->tokens[pos] - parts[i].base;
+        parts[i].lwobj.tokens = &lwobj->tokens[pos];
+        pos += cnt;
+    }
+    prv_par_run(prv_par_relocate, parts, parts_cnt);
+
+    root = &lwobj->first_token;
+    LWJSON_MEMSET(root, 0x00, sizeof(*root));
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        if (parts[i].first != NULL) {
+            if (last != NULL) {
+                last->next = parts[i].first + parts[i].delta;
+            } else {
+                root->u.cont.first_child = parts[i].first + parts[i].delta;
+            }
+            last = parts[i].last + parts[i].delta;
+        }
+    }
+    root->u.cont.child_tokens = pos;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    root->type = type;
+    lwobj->next_free_token_pos = pos;
+    lwobj->flags.parsed = 1;
+    lwobj->flags.insitu = 0;
+    lwobj->flags.packed = 0;
+#if LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX
+    /* Drop index tables of the previous document */
+    lwjson_set_index_arena(lwobj, lwobj->index.arena, lwobj->index.arena_len);
+#endif /* LWJSON_CFG_KEY_INDEX || LWJSON_CFG_ARRAY_INDEX */
+}
+
+/**
+ * \brief           Parse large JSON data with several worker threads
+ *
+ * Data is split to equal parts, that are scanned in parallel for quotes and brackets.
+ * Once string state and nesting depth at the beginning of every part are known,
+ * every part is moved to the next comma between members of the root object or array
+ * and members are parsed in parallel, each part with its own range of tokens.
+ * Parsed tokens are linked to a single tree at the end.
+ *
+ * Tokens array of the instance is split between parts proportionally to their length.
+ * Parts, that run out of tokens, are parsed again by calling thread with tokens left unused by other parts.
+ * This works with exact number of tokens, but takes extra time, so tokens array should be a bit larger.
+ * If there are not enough tokens or any part has an error, data are parsed again with one thread,
+ * so result is always the same as with \ref lwjson_parse_ex function.
+ * Data are also parsed with one thread, when memory for the state of parts cannot be allocated.
+ * Data shorter than `65536` bytes per worker are parsed with less workers.
+ *
+ * When `workers` is set to `0`, number of online processors is used,
+ * and data are parsed with one thread if there are less than `3` processors
+ * or data are shorter than `1` MB, as the extra scan and link passes do not pay off.
+ *
+ * \note            Comments are not supported, data are parsed with one thread
+ *                      when \ref LWJSON_CFG_COMMENTS is enabled
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse
+ * \param[in]       len: JSON data length
+ * \param[in]       workers: Max number of worker threads, including calling thread,
+ *                      `0` to select it automatically
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_parallel(lwjson_t* lwobj, const void* json_data, size_t len, size_t workers) {
+    const char* data = json_data;
+    lwjson_par_part_t* parts;
+    lwjson_type_t type;
+    size_t begin = 0, parts_cnt, tokens_begin, tokens_len;
+    uint8_t ok = 1;
+
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL) {
+        return lwjsonERRPAR;
+    }
+    if (workers == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        workers = cpus >= LWJSON_PIPELINE_PAR_DEF_MIN_WORKERS && len >= LWJSON_PIPELINE_PAR_DEF_MIN_LEN ? (size_t)cpus
+                                                                                                           : 1;
+    }
+    parts_cnt = len / LWJSON_PIPELINE_PAR_MIN_LEN;
+    if (parts_cnt > workers) {
+        parts_cnt = workers;
+    }
+#if LWJSON_CFG_COMMENTS
+    parts_cnt = 0;
+#endif /* LWJSON_CFG_COMMENTS */
+
+    /* Find root and its first member, rest is done by one thread */
+    for (; begin < len && (data[begin] == ' ' || data[begin] == '\t' || data[begin] == '\r' || data[begin] == '\n');
+         ++begin) {}
+    if (parts_cnt < 2 || lwobj->tokens == NULL || begin == len || (data[begin] != '[' && data[begin] != '{')) {
+        return lwjson_parse_ex(lwobj, json_data, len);
+    }
+    type = data[begin] == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
+    for (++begin; begin < len && (data[begin] == ' ' || data[begin] == '\t' || data[begin] == '\r' || data[begin] == '\n');
+         ++begin) {}
+    if (begin == len || (type == LWJSON_TYPE_OBJECT ? data[begin] != '"' : (data[begin] == ',' || data[begin] == ']'))) {
+        return lwjson_parse_ex(lwobj, json_data, len);
+    }
+
+    parts = LWJSON_MALLOC(parts_cnt * sizeof(*parts));
+    if (parts == NULL) {
+        return lwjson_parse_ex(lwobj, json_data, len);
+    }
+    LWJSON_MEMSET(parts, 0x00, parts_cnt * sizeof(*parts));
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        parts[i].data = data;
+        parts[i].type = type;
+        parts[i].begin = begin + (len - begin) * i / parts_cnt;
+        parts[i].end = begin + (len - begin) * (i + 1) / parts_cnt;
+    }
+    parts_cnt = prv_par_split_parts(parts, parts_cnt);
+
+    /* Every part gets tokens proportionally to its length, with own root token in compact mode */
+#if LWJSON_CFG_COMPACT_TOKENS
+    tokens_begin = 1;
+#else
+    tokens_begin = 0;
+#endif /* LWJSON_CFG_COMPACT_TOKENS */
+    tokens_len = lwobj->tokens_len > tokens_begin ? lwobj->tokens_len - tokens_begin : 0;
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        size_t t_begin = tokens_begin + (size_t)((double)tokens_len * (parts[i].begin - begin) / (len - begin));
+        size_t t_end = i + 1 < parts_cnt
+                           ? tokens_begin + (size_t)((double)tokens_len * (parts[i].end - begin) / (len - begin))
+                           : lwobj->tokens_len;
+
+        parts[i].lwobj.tokens = &lwobj->tokens[t_begin];
+        parts[i].lwobj.tokens_len = t_end - t_begin;
+    }
+    if (parts_cnt > 0) {
+        prv_par_run(prv_par_parse, parts, parts_cnt);
+    }
+
+    /* Only the last part may close the root */
+    for (size_t i = 0; i < parts_cnt && ok; ++i) {
+        ok = prv_par_is_parsed(&parts[i], i + 1 == parts_cnt) || parts[i].res == lwjsonERRMEM;
+    }
+    if (parts_cnt > 0 && ok) {
+        ok = prv_par_retry(lwobj, parts, parts_cnt, tokens_begin);
+    }
+    if (parts_cnt > 0 && ok) {
+        prv_par_link(lwobj, parts, parts_cnt, type);
+    }
+    LWJSON_FREE(parts);
+    return parts_cnt > 0 && ok ? lwjsonOK : lwjson_parse_ex(lwobj, json_data, len);
+}
+
+#endif /* !LWJSON_CFG_ALLOC || __DOXYGEN__ */
@@ -80,6 +80,50 @@ const char* const lwjson_type_strings[] = {
  */
 #define prv_is_space_char_ext(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\n' || (c) == '\f')
 
+#if LWJSON_CFG_VALIDATE_UTF8
+
+/**
+ * \brief           Check next string character against UTF-8 encoding rules
+ * \param           jsp: JSON stream parser instance
+ * \param           chr: Next string character
+ * \return          `1` if character is valid at current position, `0` otherwise
+ */
+static uint8_t
+prv_utf8_check_char(lwjson_stream_parser_t* jsp, uint8_t chr) {
+    if (jsp->data.str.utf8_rem > 0) {
+        if (chr < jsp->data.str.utf8_lo || chr > jsp->data.str.utf8_hi) {
+            return 0;
+        }
+        --jsp->data.str.utf8_rem;
+        jsp->data.str.utf8_lo = 0x80;
+        jsp->data.str.utf8_hi = 0xBF;
+        return 1;
+    }
+    if (chr < 0x80) {
+        return 1;
+    }
+
+    /* Lead byte sets length of sequence and valid range of the second byte */
+    jsp->data.str.utf8_lo = 0x80;
+    jsp->data.str.utf8_hi = 0xBF;
+    if (chr >= 0xC2 && chr <= 0xDF) {
+        jsp->data.str.utf8_rem = 1;
+    } else if (chr >= 0xE0 && chr <= 0xEF) {
+        jsp->data.str.utf8_rem = 2;
+        jsp->data.str.utf8_lo = chr == 0xE0 ? 0xA0 : 0x80;
+        jsp->data.str.utf8_hi = chr == 0xED ? 0x9F : 0xBF;
+    } else if (chr >= 0xF0 && chr <= 0xF4) {
+        jsp->data.str.utf8_rem = 3;
+        jsp->data.str.utf8_lo = chr == 0xF0 ? 0x90 : 0x80;
+        jsp->data.str.utf8_hi = chr == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
 /**
  * \brief           Push "parent" state to the artificial stack
  * \param           jsp: JSON stream parser instance
@@ -362,6 +406,12 @@ start_over:
              * TODO: Handle backslash
              */
             if (chr == '"' && jsp->prev_c != '\\') {
+#if LWJSON_CFG_VALIDATE_UTF8
+                if (jsp->data.str.utf8_rem > 0) {
+                    LWJSON_DEBUG(jsp, "ERROR - incomplete UTF-8 sequence at the end of string\r\n");
+                    return lwjsonERRUTF8;
+                }
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
 #if defined(LWJSON_DEV)
                 if (type == LWJSON_STREAM_TYPE_OBJECT) {
                     LWJSON_DEBUG(jsp, "End of string parsing - object key name: \"%s\"\r\n", jsp->data.str.buff);
@@ -406,6 +456,12 @@ start_over:
                     jsp->stack[jsp->stack_pos - 1].meta.index++;
                 }
             } else {
+#if LWJSON_CFG_VALIDATE_UTF8
+                if (!prv_utf8_check_char(jsp, (uint8_t)chr)) {
+                    LWJSON_DEBUG(jsp, "ERROR - invalid UTF-8 sequence in string\r\n");
+                    return lwjsonERRUTF8;
+                }
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
                 /* TODO: Check other backslash elements */
                 jsp->data.str.buff[jsp->data.str.buff_pos++] = chr;
                 jsp->data.str.buff_total_pos++;
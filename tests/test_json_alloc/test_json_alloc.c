@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[4];
+static lwjson_t lwjson;
+
+/* Buffer for generated JSON strings */
+static char json_buff[16384];
+
+/* Allocator statistics */
+static size_t alloc_count, free_count, alloc_fail_after = (size_t)-1;
+
+/**
+ * \brief           Allocator used by the library
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory or `NULL` on failure
+ */
+void*
+test_malloc(size_t size) {
+    if (alloc_count >= alloc_fail_after) {
+        return NULL;
+    }
+    ++alloc_count;
+    return malloc(size);
+}
+
+/**
+ * \brief           Free memory allocated with \ref test_malloc
+ * \param[in]       ptr: Pointer to memory to free
+ */
+void
+test_free(void* ptr) {
+    ++free_count;
+    free(ptr);
+}
+
+/**
+ * \brief           Generate JSON array with integer values
+ * \param[in]       count: Number of values in the array
+ */
+static void
+prv_gen_array(size_t count) {
+    size_t pos = 0;
+
+    json_buff[pos++] = '[';
+    for (size_t i = 0; i < count; ++i) {
+        pos += sprintf(&json_buff[pos], "%s%d", i > 0 ? "," : "", (int)i);
+    }
+    json_buff[pos++] = ']';
+    json_buff[pos] = '\0';
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, cnt;
+    const lwjson_token_t *token, *t;
+
+    printf("---\r\nTest JSON dynamic token allocation..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    /* Small JSON fits static array, no allocation */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"a\":1,\"b\":[true]}") == lwjsonOK);
+    RUN_TEST(alloc_count == 0 && lwjson_get_tokens_used(&lwjson) == 4);
+
+    /* Large array grows in blocks of 8, 12, 24, 48, 96, 192, 384 and 768 tokens */
+    prv_gen_array(1000);
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST(alloc_count == 8 && lwjson_get_tokens_used(&lwjson) == 1001);
+    RUN_TEST((token = lwjson_get_first_child(lwjson_get_first_token(&lwjson))) == &tokens[0]);
+    cnt = 0;
+    for (t = token; t != NULL; t = t->next, ++cnt) {
+        if (t->type != LWJSON_TYPE_NUM_INT || lwjson_get_val_int(t) != (lwjson_int_t)cnt) {
+            break;
+        }
+    }
+    RUN_TEST(cnt == 1000);
+    RUN_TEST((token = lwjson_find(&lwjson, "#999")) != NULL && lwjson_get_val_int(token) == 999);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "#3")) == lwjson_find(&lwjson, "#4"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "#500")) == lwjson_find(&lwjson, "#501"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "#999")) == NULL);
+
+    /* Blocks are reused for next parse */
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST(alloc_count == 8);
+    prv_gen_array(2000);
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST(alloc_count == 9 && lwjson_get_tokens_used(&lwjson) == 2001);
+
+    /* Free releases all blocks */
+    RUN_TEST(lwjson_free(&lwjson) == lwjsonOK);
+    RUN_TEST(free_count == alloc_count);
+    RUN_TEST(lwjson_find(&lwjson, "#0") == NULL);
+
+    /* Allocation failure */
+    alloc_fail_after = alloc_count + 2;
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonERRMEM);
+    alloc_fail_after = (size_t)-1;
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST(lwjson_free(&lwjson) == lwjsonOK && free_count == alloc_count);
+
+    /* Instance without static tokens */
+    RUN_TEST(lwjson_init(&lwjson, NULL, 0) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, "{\"k\":{\"k\":[1,2,3]}}") == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "k.k.#2")) != NULL && lwjson_get_val_int(token) == 3);
+    RUN_TEST(lwjson_free(&lwjson) == lwjsonOK && free_count == alloc_count);
+
+    /* Print results */
+    printf("Dynamic token allocation test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance */
+static lwjson_token_t tokens[1024];
+static lwjson_t lwjson;
+
+/* Generated JSON data and memory for element tables */
+static char json_data[16384];
+static void* arena[640];
+
+/**
+ * \brief           Generate JSON object with large arrays
+ *
+ * Array `items` has 300 objects with index in member `v`,
+ * array `ints` has 100 integer values and array `small` has only 2 elements.
+ */
+static void
+prv_generate(void) {
+    size_t pos = 0;
+
+    pos += sprintf(&json_data[pos], "{\"items\": [");
+    for (size_t i = 0; i < 300; ++i) {
+        pos += sprintf(&json_data[pos], "%s{\"v\": %u}", i > 0 ? ", " : "", (unsigned)i);
+    }
+    pos += sprintf(&json_data[pos], "], \"ints\": [");
+    for (size_t i = 0; i < 100; ++i) {
+        pos += sprintf(&json_data[pos], "%s%u", i > 0 ? ", " : "", (unsigned)i);
+    }
+    sprintf(&json_data[pos], "], \"small\": [1, \"a\"]}");
+}
+
+/**
+ * \brief           Access all elements by index and check their values
+ * \return          Number of failed checks
+ */
+static size_t
+prv_check_values(void) {
+    size_t failed = 0;
+    const lwjson_token_t *arr, *t;
+    char path[24];
+
+    arr = lwjson_find(&lwjson, "items");
+    failed += lwjson_array_size(&lwjson, arr) != 300;
+    for (size_t i = 0; i < 300; ++i) {
+        t = lwjson_find_ex(&lwjson, lwjson_array_get(&lwjson, arr, i), "v");
+        failed += t == NULL || lwjson_get_val_int(t) != (lwjson_int_t)i;
+        sprintf(path, "items.#%u.v", (unsigned)i);
+        failed += lwjson_find(&lwjson, path) != t;
+    }
+    arr = lwjson_find(&lwjson, "ints");
+    failed += lwjson_array_size(&lwjson, arr) != 100;
+    for (size_t i = 0; i < 100; ++i) {
+        t = lwjson_array_get(&lwjson, arr, i);
+        failed += t == NULL || lwjson_get_val_int(t) != (lwjson_int_t)i;
+    }
+    return failed;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, used;
+    const lwjson_token_t *t, *arr;
+
+    printf("---\r\nTest JSON array element index..\r\n");
+    prv_generate();
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+    RUN_TEST(lwjson_set_index_arena(&lwjson, arena, sizeof(arena)) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, json_data) == lwjsonOK);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.arena_used == 0);
+
+    /* Tables are built on first access */
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.count > 0 && lwjson.index.arena_used > 0 && !lwjson.index.full);
+    used = lwjson.index.arena_used;
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* Out of range indexes, small arrays and other types */
+    arr = lwjson_find(&lwjson, "items");
+    RUN_TEST(lwjson_array_get(&lwjson, arr, 300) == NULL);
+    RUN_TEST(lwjson_array_get(&lwjson, arr, (size_t)-2) == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "items.#300") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "items.#299.x") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "ints.#100") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "ints.#1.v") == NULL);
+    arr = lwjson_find(&lwjson, "small");
+    RUN_TEST(lwjson_array_size(&lwjson, arr) == 2);
+    t = lwjson_array_get(&lwjson, arr, 1);
+    RUN_TEST(t != NULL && t->type == LWJSON_TYPE_STRING && t == lwjson_find(&lwjson, "small.#1"));
+    RUN_TEST(lwjson_array_get(&lwjson, arr, 2) == NULL);
+    RUN_TEST(lwjson_array_size(&lwjson, lwjson_get_first_token(&lwjson)) == 0);
+    RUN_TEST(lwjson_array_get(&lwjson, lwjson_get_first_token(&lwjson), 0) == NULL);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* Many paths use the same tables, in any order of indexes */
+    {
+        static const char* paths[] = {
+            "items.#250.v", "items.#7.v", "items.#299", "items.#300", "ints.#99",
+            "ints.#3",      "ints.#",     "small.#1",   "items.#.v",
+        };
+        const lwjson_token_t* results[LWJSON_ARRAYSIZE(paths)];
+
+        RUN_TEST(lwjson_find_many(&lwjson, paths, LWJSON_ARRAYSIZE(paths), results) == lwjsonOK);
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(paths); ++i) {
+            RUN_TEST(results[i] == lwjson_find(&lwjson, paths[i]));
+        }
+        RUN_TEST(results[0] != NULL && lwjson_get_val_int(results[0]) == 250 && results[3] == NULL);
+        RUN_TEST(lwjson.index.arena_used == used);
+    }
+
+    /* Tables are dropped when parsing again */
+    RUN_TEST(lwjson_parse(&lwjson, "[1, 2]") == lwjsonOK);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.arena_used == 0);
+    RUN_TEST(lwjson_array_size(&lwjson, lwjson_get_first_token(&lwjson)) == 2);
+    RUN_TEST(lwjson_parse(&lwjson, json_data) == lwjsonOK);
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* Too small arena, elements are accessed without tables */
+    RUN_TEST(lwjson_set_index_arena(&lwjson, arena, 64) == lwjsonOK);
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.full);
+
+#if LWJSON_CFG_PACKED_ARRAYS
+    /* Packed array needs no table, its values are copied to application token */
+    RUN_TEST(lwjson_set_index_arena(&lwjson, arena, sizeof(arena)) == lwjsonOK);
+    RUN_TEST(lwjson_parse_packed(&lwjson, json_data, strlen(json_data)) == lwjsonOK);
+    arr = lwjson_find(&lwjson, "ints");
+    RUN_TEST(lwjson_get_packed(arr, NULL, NULL) != NULL && lwjson_array_size(&lwjson, arr) == 100);
+    RUN_TEST(lwjson_array_get(&lwjson, arr, 5) == NULL && lwjson_find(&lwjson, "ints.#5") == NULL);
+    {
+        lwjson_token_t elem;
+
+        t = lwjson_array_get_ex(&lwjson, arr, 99, &elem);
+        RUN_TEST(t == &elem && lwjson_get_val_int(t) == 99);
+        RUN_TEST(lwjson_array_get_ex(&lwjson, arr, 100, &elem) == NULL);
+        t = lwjson_array_get_ex(&lwjson, lwjson_find(&lwjson, "items"), 299, &elem);
+        RUN_TEST(t != &elem && t == lwjson_find(&lwjson, "items.#299"));
+    }
+    {
+        static const char* paths[] = {"ints.#5", "ints.#", "ints", "items.#299.v"};
+        const lwjson_token_t* results[LWJSON_ARRAYSIZE(paths)];
+
+        /* Values of packed array have no tokens, as with find */
+        RUN_TEST(lwjson_find_many(&lwjson, paths, LWJSON_ARRAYSIZE(paths), results) == lwjsonOK);
+        RUN_TEST(results[0] == NULL && results[1] == NULL && results[2] == arr);
+        RUN_TEST(results[3] != NULL && results[3] == lwjson_find(&lwjson, "items.#299.v"));
+    }
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+
+    /* Instance without parsed data */
+    lwjson_free(&lwjson);
+    RUN_TEST(lwjson.index.count == 0);
+    RUN_TEST(lwjson_array_get(&lwjson, lwjson_get_first_token(&lwjson), 0) == NULL);
+    RUN_TEST(lwjson_array_size(&lwjson, lwjson_get_first_token(&lwjson)) == 0);
+
+    /* Print results */
+    printf("Array element index test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[4096];
+static lwjson_t lwjson;
+
+/**
+ * \brief           Check if token name matches expected string
+ * \param[in]       token: Token to check
+ * \param[in]       name: Expected name
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_name_is(const lwjson_token_t* token, const char* name) {
+    size_t len;
+    const char* str = lwjson_get_token_name(&lwjson, token, &len);
+    return str != NULL && len == strlen(name) && strncmp(str, name, len) == 0;
+}
+
+/**
+ * \brief           Check if string value matches expected string
+ * \param[in]       token: Token to check
+ * \param[in]       value: Expected value
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_string_is(const lwjson_token_t* token, const char* value) {
+    size_t len;
+    const char* str = lwjson_get_val_string_ex(&lwjson, token, &len);
+    return str != NULL && len == strlen(value) && strncmp(str, value, len) == 0;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, cnt;
+    const lwjson_token_t *token, *t;
+    const char* json_str = "\
+    {\
+        \"my_arr\":[\
+            {\"num\":1,\"str\":\"first_entry\"},\
+            {\"num\":2,\"str\":\"second_entry\"},\
+            [\"abc\", \"def\"],\
+            [],\
+            [123, -123, 1.5]\
+        ],\
+        \"my_obj\": {\
+            \"key_true\": true,\
+            \"arr\": [[1, 2, 3], [{\"my_key\":\"my_text\"}]]\
+        },\
+        \"last\": null\
+    }\
+    ";
+
+    printf("---\r\nTest JSON compact tokens..\r\n");
+    RUN_TEST(sizeof(lwjson_token_t) == 16);
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    RUN_TEST(lwjson_parse(&lwjson, json_str) == lwjsonOK);
+
+    /* Root token is stored in the token array, all tokens are in document order */
+    RUN_TEST((token = lwjson_get_first_token(&lwjson)) == &tokens[0]);
+    RUN_TEST(token->type == LWJSON_TYPE_OBJECT && lwjson_get_token_name(&lwjson, token, NULL) == NULL);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) == 27);
+    RUN_TEST(token->u.cont.child_tokens == 26);
+    RUN_TEST(lwjson_get_next(token) == NULL);
+    RUN_TEST(lwjson_count_tokens(json_str, strlen(json_str), &cnt, NULL) == lwjsonOK && cnt == 27);
+
+    /* Traverse first level */
+    cnt = 0;
+    for (t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
+        ++cnt;
+    }
+    RUN_TEST(cnt == 3);
+    RUN_TEST((t = lwjson_get_first_child(token)) != NULL && prv_name_is(t, "my_arr"));
+    RUN_TEST((t = lwjson_get_next(t)) != NULL && prv_name_is(t, "my_obj") && t->type == LWJSON_TYPE_OBJECT);
+    RUN_TEST((t = lwjson_get_next(t)) != NULL && prv_name_is(t, "last") && t->type == LWJSON_TYPE_NULL);
+
+    /* Find entries */
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#0.num")) != NULL && lwjson_get_val_int(token) == 1);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#1.str")) != NULL && prv_string_is(token, "second_entry"));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#2.#1")) != NULL && prv_string_is(token, "def"));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#3")) != NULL && token->type == LWJSON_TYPE_ARRAY
+             && lwjson_get_first_child(token) == NULL);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#4.#1")) != NULL && lwjson_get_val_int(token) == -123);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#4.#2")) != NULL && lwjson_get_val_real(token) == 1.5);
+    RUN_TEST(lwjson_find(&lwjson, "my_arr.#5") == NULL);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.key_true")) != NULL && token->type == LWJSON_TYPE_TRUE);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#1.#0.my_key")) != NULL && prv_string_is(token, "my_text"));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#.#.my_key")) != NULL && prv_string_is(token, "my_text"));
+    RUN_TEST((token = lwjson_find(&lwjson, "last")) != NULL && token->type == LWJSON_TYPE_NULL);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_obj")) == token);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, token) == NULL);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_arr.#2"))
+             == lwjson_find(&lwjson, "my_arr.#3"));
+    RUN_TEST(lwjson_get_subtree_size(lwjson_get_first_token(&lwjson)) == 26);
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj")) != NULL
+             && (token = lwjson_find_ex(&lwjson, token, "arr.#0.#2")) != NULL && lwjson_get_val_int(token) == 3);
+
+    /* String functions take instance in compact layout */
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#.#.my_key")) != NULL
+             && lwjson_string_compare(&lwjson, token, "my_text"));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#.#.my_key")) != NULL
+             && lwjson_string_compare_n(&lwjson, token, "my_text", 3));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#.#.my_key")) != NULL
+             && !lwjson_string_compare_n(&lwjson, token, "my_stext", 4)); /* Must be a fail */
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#0.str")) != NULL
+             && lwjson_string_compare_ex(&lwjson, token, "first_entry")
+             && !lwjson_string_compare(&lwjson, lwjson_find(&lwjson, "my_arr.#0.num"), "1"));
+    {
+        const char* str;
+        size_t len;
+
+        RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#2.#1")) != NULL
+                 && (str = lwjson_get_val_string(&lwjson, token, &len)) != NULL && len == 3
+                 && strncmp(str, "def", 3) == 0);
+    }
+
+    /* Strings are not accessible without an instance */
+    RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#2.#0")) != NULL
+             && lwjson_get_val_string_ex(NULL, token, NULL) == NULL && lwjson_get_val_string_length(token) == 3);
+
+    /* Invalid and incomplete inputs, out of memory */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"k\":[1,2}") == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse(&lwjson, "[[1],[2") == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse(&lwjson, "[[1],[2]]") == lwjsonOK && lwjson_get_tokens_used(&lwjson) == 5);
+    lwjson_free(&lwjson);
+    RUN_TEST(lwjson_init(&lwjson, tokens, 3) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, "[1,2]") == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, "[1,2,3]") == lwjsonERRMEM);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("Compact tokens test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -122,6 +122,216 @@ test_run(void) {
              && lwjson_string_compare_n(token, "my_text", 3));
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
              && !lwjson_string_compare_n(token, "my_stext", 4)); /* Must be a fail */
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
+             && lwjson_string_compare_ex(&lwjson, token, "my_text")
+             && lwjson_string_compare_n_ex(&lwjson, token, "my_text", 3)
+             && !lwjson_string_compare_n_ex(&lwjson, token, "my_stext", 4));
+
+    /* Subtree sizes and skipping of subtrees in document order */
+    RUN_TEST(lwjson_get_subtree_size(lwjson_get_first_token(&lwjson)) == lwjson_get_tokens_used(&lwjson) - 1);
+    RUN_TEST(lwjson_get_subtree_size(lwjson_find(&lwjson, "my_arr")) == 20);
+    RUN_TEST(lwjson_get_subtree_size(lwjson_find(&lwjson, "my_arr.#3")) == 2);
+    RUN_TEST(lwjson_get_subtree_size(lwjson_find(&lwjson, "my_arr.#3.#0")) == 0);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_arr")) == lwjson_find(&lwjson, "my_obj"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_arr.#2")) == lwjson_find(&lwjson, "my_arr.#3"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_arr.#0.num"))
+             == lwjson_find(&lwjson, "my_arr.#0.str"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_arr.#5")) == lwjson_find(&lwjson, "my_obj"));
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_obj")) == NULL);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_find(&lwjson, "my_obj.ustr")) == NULL);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, lwjson_get_first_token(&lwjson)) == NULL);
+    {
+        size_t cnt = 0;
+
+        /* Walk all tokens in document order */
+        for (token = lwjson_get_first_child(lwjson_get_first_token(&lwjson)); token != NULL; ++cnt) {
+            const lwjson_token_t* child = lwjson_get_first_child(token);
+            token = child != NULL ? child : lwjson_skip_subtree(&lwjson, token);
+        }
+        RUN_TEST(cnt == lwjson_get_tokens_used(&lwjson) - 1);
+    }
+
+    /* Compiled paths find the same tokens as path text */
+    {
+        static const char* paths[] = {
+            "my_arr",
+            "my_arr.#0",
+            "my_arr.#2.str",
+            "my_arr.#3.#1",
+            "my_arr.#9",
+            "my_arr.#.str",
+            "my_arr.#.#2",
+            "my_arr.num",
+            "my_obj.key_true",
+            "my_obj.ustr",
+            "my_obj.none",
+            "my_obj.#0",
+            "my_obj..x",
+            "",
+            "my_obj.arr.#.#.my_key",
+            "my_obj.arr.#2.#1.my_key",
+        };
+        lwjson_path_t cpath;
+
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(paths); ++i) {
+            if (lwjson_path_compile(&cpath, paths[i]) == lwjsonOK) {
+                RUN_TEST(lwjson_find_compiled(&lwjson, NULL, &cpath) == lwjson_find(&lwjson, paths[i]));
+            } else {
+                RUN_TEST(lwjson_find(&lwjson, paths[i]) == NULL);
+            }
+        }
+        RUN_TEST(lwjson_path_compile(&cpath, "my_obj.arr.#2.#0.my_key") == lwjsonOK && cpath.segments_cnt == 5
+                 && cpath.segments[2].key == NULL && cpath.segments[2].index == 2 && cpath.segments[4].key_len == 6);
+        RUN_TEST(lwjson_path_compile(&cpath, "my_arr.#.str") == lwjsonOK
+                 && cpath.segments[1].index == LWJSON_PATH_INDEX_ANY);
+        RUN_TEST((token = lwjson_find_compiled(&lwjson, NULL, &cpath)) != NULL && token->type == LWJSON_TYPE_STRING
+                 && lwjson_string_compare(token, "first_entry"));
+
+        /* Start search at given token */
+        RUN_TEST(lwjson_path_compile(&cpath, "#1.str") == lwjsonOK);
+        RUN_TEST((token = lwjson_find_compiled(&lwjson, lwjson_find(&lwjson, "my_arr"), &cpath)) != NULL
+                 && lwjson_string_compare(token, "second_entry"));
+        RUN_TEST(lwjson_find_compiled(&lwjson, lwjson_find(&lwjson, "my_arr.#0.num"), &cpath) == NULL);
+
+        /* Paths, that cannot match any token */
+        RUN_TEST(lwjson_path_compile(&cpath, "my_arr.#") == lwjsonERRPAR);
+        RUN_TEST(lwjson_path_compile(&cpath, "my_arr.") == lwjsonERRPAR);
+        RUN_TEST(lwjson_path_compile(&cpath, "my_arr.#1x") == lwjsonERRPAR);
+        RUN_TEST(lwjson_path_compile(&cpath, "a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q") == lwjsonERRPAR);
+        RUN_TEST(lwjson_path_compile(&cpath, NULL) == lwjsonERRPAR);
+        RUN_TEST(lwjson_find_compiled(&lwjson, NULL, &cpath) == NULL);
+    }
+
+    /* Many paths find the same tokens as separate searches */
+    {
+        static const char* paths[] = {
+            "my_obj.arr.#.#.my_key",
+            "my_arr.#2.str",
+            "my_arr",
+            "my_arr.#.#2",
+            "my_obj.key_true",
+            "my_arr.#0",
+            "my_obj.arr.#2.#0.my_key",
+            "my_arr.#3.#1",
+            "my_arr.#9",
+            "my_arr.#.str",
+            "my_arr.num",
+            "my_obj.ustr",
+            "my_obj.none",
+            "my_obj.#0",
+            "my_obj..x",
+            "",
+            "my_arr.#",
+            "my_obj.arr.#2.#1.my_key",
+            "my_obj.arr.#1.#2",
+            "my_arr.#5.#2",
+            "my_arr.#.",
+            "my_arr.#0.",
+            "my_obj.",
+            NULL,
+        };
+        const char* many[80];
+        const lwjson_token_t* results[80];
+
+        RUN_TEST(lwjson_find_many(&lwjson, paths, LWJSON_ARRAYSIZE(paths), results) == lwjsonOK);
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(paths); ++i) {
+            RUN_TEST(results[i] == (paths[i] != NULL ? lwjson_find(&lwjson, paths[i]) : NULL));
+        }
+
+        /* More paths than fit into single traversal */
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(many); ++i) {
+            many[i] = paths[(i * 7) % (LWJSON_ARRAYSIZE(paths) - 1)];
+        }
+        RUN_TEST(lwjson_find_many(&lwjson, many, LWJSON_ARRAYSIZE(many), results) == lwjsonOK);
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(many); ++i) {
+            RUN_TEST(results[i] == lwjson_find(&lwjson, many[i]));
+        }
+
+        /* Consecutive paths share leading segments, in any order of indexes */
+        {
+            static const char* shared[] = {
+                "my_arr.#3.#1", "my_arr.#3",   "my_arr.#3.#1",  "my_arr.#1",  "my_arr.#0",   "my_arr.#3.#0",
+                "my_arr.#",     "my_arr.#.#1", "my_obj.arr.#2", "my_obj.arr", "my_obj.ustr", "my_arr.#2.str",
+            };
+
+            RUN_TEST(lwjson_find_many(&lwjson, shared, LWJSON_ARRAYSIZE(shared), results) == lwjsonOK);
+            for (size_t i = 0; i < LWJSON_ARRAYSIZE(shared); ++i) {
+                RUN_TEST(results[i] == lwjson_find(&lwjson, shared[i]));
+            }
+        }
+
+        /* Path with more segments than supported */
+        many[0] = "my_arr";
+        many[1] = "a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q";
+        RUN_TEST(lwjson_find_many(&lwjson, many, 2, results) == lwjsonERRPAR);
+        many[1] = "my_arr.a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p";
+        RUN_TEST(lwjson_find_many(&lwjson, many, 2, results) == lwjsonERRPAR);
+        many[1] = "a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p";
+        RUN_TEST(lwjson_find_many(&lwjson, many, 2, results) == lwjsonOK);
+        RUN_TEST(results[0] == lwjson_find(&lwjson, "my_arr") && results[1] == NULL);
+
+        /* Random batches of paths, with empty and trailing segments, give the same results as separate searches */
+        {
+            static const char* segs[] = {
+                "my_arr", "my_obj", "arr", "num", "str", "my_key", "ustr", "#", "#0", "#1", "#2", "#7", "", "x",
+            };
+            static char texts[LWJSON_ARRAYSIZE(many)][64];
+            uint32_t rnd = 1;
+            size_t mismatch = 0;
+
+            for (size_t batch = 0; batch < 500; ++batch) {
+                for (size_t i = 0; i < LWJSON_ARRAYSIZE(many); ++i) {
+                    size_t len = 0, cnt;
+
+                    rnd = rnd * 1103515245 + 12345;
+                    cnt = 1 + (rnd >> 16) % 5;
+                    for (size_t k = 0; k < cnt; ++k) {
+                        rnd = rnd * 1103515245 + 12345;
+                        len += sprintf(&texts[i][len], "%s%s", k > 0 ? "." : "",
+                                       segs[(rnd >> 16) % LWJSON_ARRAYSIZE(segs)]);
+                    }
+                    if ((rnd >> 8) % 4 == 0) {
+                        texts[i][len++] = '.';
+                        texts[i][len] = '\0';
+                    }
+                    many[i] = texts[i];
+                }
+                if (lwjson_find_many(&lwjson, many, LWJSON_ARRAYSIZE(many), results) != lwjsonOK) {
+                    ++mismatch;
+                    continue;
+                }
+                for (size_t i = 0; i < LWJSON_ARRAYSIZE(many); ++i) {
+                    if (results[i] != lwjson_find(&lwjson, many[i])) {
+                        printf("find_many differs from find for path \"%s\"\r\n", many[i]);
+                        ++mismatch;
+                    }
+                }
+            }
+            RUN_TEST(mismatch == 0);
+        }
+
+        RUN_TEST(lwjson_find_many(&lwjson, paths, 0, results) == lwjsonOK);
+        RUN_TEST(lwjson_find_many(&lwjson, NULL, 1, results) == lwjsonERRPAR);
+        RUN_TEST(lwjson_find_many(&lwjson, paths, 1, NULL) == lwjsonERRPAR);
+    }
+
+    /* Access array elements by index */
+    {
+        const lwjson_token_t* arr = lwjson_find(&lwjson, "my_arr");
+        char path[16];
+        size_t size = lwjson_array_size(&lwjson, arr);
+
+        RUN_TEST(size > 5 && lwjson_find_ex(&lwjson, arr, "#0") == lwjson_get_first_child(arr));
+        for (size_t i = 0; i <= size; ++i) {
+            sprintf(path, "#%u", (unsigned)i);
+            RUN_TEST(lwjson_array_get(&lwjson, arr, i) == lwjson_find_ex(&lwjson, arr, path));
+        }
+        RUN_TEST(lwjson_array_get(&lwjson, arr, size) == NULL);
+        RUN_TEST(lwjson_array_size(&lwjson, lwjson_find(&lwjson, "my_arr.#3")) == 2);
+        RUN_TEST(lwjson_array_size(&lwjson, lwjson_find(&lwjson, "my_obj")) == 0);
+        RUN_TEST(lwjson_array_get(&lwjson, lwjson_find(&lwjson, "my_obj"), 0) == NULL);
+        RUN_TEST(lwjson_array_get(&lwjson, NULL, 0) == NULL);
+    }
 
     /* Call this once JSON usage is finished */
     lwjson_free(&lwjson);
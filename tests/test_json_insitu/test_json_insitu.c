@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[128];
+static lwjson_t lwjson;
+
+/* Writable buffer for JSON data */
+static char json_buff[512];
+
+/**
+ * \brief           Parse JSON string in place, after it is copied to writable buffer
+ * \param[in]       json: JSON string to parse
+ * \return          Parse result
+ */
+static lwjsonr_t
+prv_parse(const char* json) {
+    strcpy(json_buff, json);
+    return lwjson_parse_insitu(&lwjson, json_buff, strlen(json_buff));
+}
+
+/**
+ * \brief           Check if string value of token at path matches expected text
+ * \param[in]       path: Path to find token
+ * \param[in]       value: Expected value
+ * \param[in]       value_len: Expected value length, can contain `NULL` characters
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_string_is(const char* path, const char* value, size_t value_len) {
+    size_t len;
+    const lwjson_token_t* token;
+    const char* str;
+
+    if ((token = lwjson_find(&lwjson, path)) == NULL || token->type != LWJSON_TYPE_STRING) {
+        return 0;
+    }
+    str = lwjson_get_val_string(token, &len);
+    return str != NULL && len == value_len && memcmp(str, value, len) == 0;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0;
+    const lwjson_token_t* token;
+    const char* long_str = "[\"0123456789012345678901234567890123456789012345678901234567890123456789\\n"
+                           "0123456789012345678901234567890123456789012345678901234567890123456789\\t\\\"end\"]";
+
+    printf("---\r\nTest JSON in-situ string decoding..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    /* Simple escape sequences */
+    RUN_TEST(prv_parse("{\"a\":\"plain\",\"b\":\"x\\ny\\tz\",\"c\":\"\\\"\\\\\\/\\b\\f\\r\"}") == lwjsonOK);
+    RUN_TEST(prv_string_is("a", "plain", 5));
+    RUN_TEST(prv_string_is("b", "x\ny\tz", 5));
+    RUN_TEST(prv_string_is("c", "\"\\/\b\f\r", 6));
+    RUN_TEST((token = lwjson_find(&lwjson, "c")) != NULL && lwjson_get_val_string_length(token) == 6);
+
+    /* Unicode escape sequences to UTF-8, 1 to 3 bytes long */
+    RUN_TEST(prv_parse("{\"u\":\"\\u0041\\u00e9\\u20AC!\"}") == lwjsonOK);
+    RUN_TEST(prv_string_is("u", "A\xC3\xA9\xE2\x82\xAC!", 7));
+    RUN_TEST(prv_parse("{\"n\":\"a\\u0000b\"}") == lwjsonOK);
+    RUN_TEST(prv_string_is("n", "a\0b", 3));
+
+    /* Surrogate pair to 4-byte UTF-8 */
+    RUN_TEST(prv_parse("[\"\\uD83D\\uDE00\", \"x\\ud834\\udd1ey\"]") == lwjsonOK);
+    RUN_TEST(prv_string_is("#0", "\xF0\x9F\x98\x80", 4));
+    RUN_TEST(prv_string_is("#1", "x\xF0\x9D\x84\x9Ey", 6));
+
+    /* Keys are decoded too and can be found with decoded name */
+    RUN_TEST(prv_parse("{\"k\\u0065y\":1,\"line\\nkey\":{\"in\\\"ner\":\"v\"}}") == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "key")) != NULL && lwjson_get_val_int(token) == 1);
+    RUN_TEST(prv_string_is("line\nkey.in\"ner", "v", 1));
+
+    /* Strings longer than SIMD block, with escapes */
+    RUN_TEST(prv_parse(long_str) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "#0")) != NULL && lwjson_get_val_string_length(token) == 146);
+    RUN_TEST(prv_string_is("#0",
+                           "0123456789012345678901234567890123456789012345678901234567890123456789\n"
+                           "0123456789012345678901234567890123456789012345678901234567890123456789\t\"end",
+                           146));
+
+    /* Unpaired surrogates and invalid escapes */
+    RUN_TEST(prv_parse("[\"\\uD83D\"]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse("[\"\\uD83Dx\"]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse("[\"\\uD83D\\u0041\"]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse("[\"\\uDE00\"]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse("[\"\\u12G4\"]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse("[\"\\x\"]") == lwjsonERRJSON);
+
+    /* Regular parse keeps strings escaped and accepts unpaired surrogates */
+    RUN_TEST(lwjson_parse(&lwjson, "[\"a\\nb\", \"\\uDE00\"]") == lwjsonOK);
+    RUN_TEST(prv_string_is("#0", "a\\nb", 4));
+    RUN_TEST(lwjson_parse_insitu(&lwjson, NULL, 0) == lwjsonERRPAR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("In-situ string decoding test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance */
+static lwjson_token_t tokens[512];
+static lwjson_t lwjson;
+
+/* Generated JSON data and memory for key hash tables */
+static char json_data[8192];
+static void* arena[1536];
+
+/**
+ * \brief           Generate JSON object with many members
+ *
+ * Members `k0` to `k199` have their index as value, `k5` is repeated at the end with value `-1`.
+ * Member `big` has 20 object members `o0` to `o19`, with index in member `v`.
+ * Member `small` has only 2 members.
+ */
+static void
+prv_generate(void) {
+    size_t pos = 0;
+
+    pos += sprintf(&json_data[pos], "{\"small\": {\"a\": 1, \"b\": 2}, \"big\": {");
+    for (size_t i = 0; i < 20; ++i) {
+        pos += sprintf(&json_data[pos], "%s\"o%u\": {\"v\": %u}", i > 0 ? ", " : "", (unsigned)i, (unsigned)i);
+    }
+    pos += sprintf(&json_data[pos], "}");
+    for (size_t i = 0; i < 200; ++i) {
+        pos += sprintf(&json_data[pos], ", \"k%u\": %u", (unsigned)i, (unsigned)i);
+    }
+    sprintf(&json_data[pos], ", \"dup\": {\"x\": 1}, \"dup\": {\"y\": 2}, \"k5\": -1}");
+}
+
+/**
+ * \brief           Find all members and check their values
+ * \return          Number of failed checks
+ */
+static size_t
+prv_check_values(void) {
+    size_t failed = 0;
+    const lwjson_token_t* t;
+    char path[16];
+
+    for (size_t i = 0; i < 200; ++i) {
+        sprintf(path, "k%u", (unsigned)i);
+        t = lwjson_find(&lwjson, path);
+        failed += t == NULL || t->type != LWJSON_TYPE_NUM_INT || lwjson_get_val_int(t) != (lwjson_int_t)i;
+    }
+    for (size_t i = 0; i < 20; ++i) {
+        sprintf(path, "big.o%u.v", (unsigned)i);
+        t = lwjson_find(&lwjson, path);
+        failed += t == NULL || lwjson_get_val_int(t) != (lwjson_int_t)i;
+    }
+    return failed;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, used;
+    const lwjson_token_t* t;
+    lwjson_path_t cpath;
+
+    printf("---\r\nTest JSON key hash index..\r\n");
+    prv_generate();
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+    RUN_TEST(lwjson_set_index_arena(&lwjson, arena, sizeof(arena)) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, json_data) == lwjsonOK);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.arena_used == 0);
+
+    /* Tables are built on first search */
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.count > 0 && lwjson.index.arena_used > 0 && !lwjson.index.full);
+    RUN_TEST(lwjson.index.count == 2 && lwjson.index.dir_size >= 2 * lwjson.index.count);
+    used = lwjson.index.arena_used;
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* Missing members, small objects and deeper paths */
+    RUN_TEST(lwjson_find(&lwjson, "k200") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "k") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "big.o20") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "big.o1.x") == NULL);
+    t = lwjson_find(&lwjson, "small.b");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 2);
+    RUN_TEST(lwjson_find(&lwjson, "small.c") == NULL);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* First member with the name is found, deeper path continues with next members */
+    t = lwjson_find(&lwjson, "k5");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 5);
+    t = lwjson_find(&lwjson, "dup.x");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 1);
+    t = lwjson_find(&lwjson, "dup.y");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 2);
+
+    /* Many paths use the same tables */
+    {
+        static const char* paths[] = {"k150", "big.o17.v", "big.o3.v", "dup.y", "dup.x", "k5", "k200", "k0"};
+        const lwjson_token_t* results[LWJSON_ARRAYSIZE(paths)];
+
+        RUN_TEST(lwjson_find_many(&lwjson, paths, LWJSON_ARRAYSIZE(paths), results) == lwjsonOK);
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(paths); ++i) {
+            RUN_TEST(results[i] == lwjson_find(&lwjson, paths[i]));
+        }
+        RUN_TEST(results[0] != NULL && lwjson_get_val_int(results[0]) == 150 && results[6] == NULL);
+        RUN_TEST(lwjson.index.arena_used == used);
+    }
+
+    /* Compiled paths use hash of the key */
+    RUN_TEST(lwjson_path_compile(&cpath, "big.o17.v") == lwjsonOK);
+    t = lwjson_find_compiled(&lwjson, NULL, &cpath);
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 17);
+    RUN_TEST(lwjson_path_compile(&cpath, "k123") == lwjsonOK);
+    t = lwjson_find_compiled(&lwjson, NULL, &cpath);
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 123);
+
+    /* Tables are dropped when parsing again */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"k1\": 1}") == lwjsonOK);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.arena_used == 0);
+    RUN_TEST(lwjson_parse(&lwjson, json_data) == lwjsonOK);
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.arena_used == used);
+
+    /* Too small arena, searches continue without tables */
+    RUN_TEST(lwjson_set_index_arena(&lwjson, arena, 64) == lwjsonOK);
+    RUN_TEST(prv_check_values() == 0);
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.full);
+    RUN_TEST(lwjson_find(&lwjson, "k300") == NULL);
+
+    /* Without arena, tables are allocated when allocation is enabled */
+    RUN_TEST(lwjson_set_index_arena(&lwjson, NULL, 0) == lwjsonOK);
+    RUN_TEST(prv_check_values() == 0);
+#if LWJSON_CFG_ALLOC
+    RUN_TEST(lwjson.index.count > 0 && !lwjson.index.full);
+#else
+    RUN_TEST(lwjson.index.count == 0 && lwjson.index.full);
+#endif /* LWJSON_CFG_ALLOC */
+
+    /* Invalid parameters */
+    RUN_TEST(lwjson_set_index_arena(NULL, arena, sizeof(arena)) == lwjsonERRPAR);
+    RUN_TEST(lwjson_set_index_arena(&lwjson, NULL, 1) == lwjsonERRPAR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+    RUN_TEST(lwjson.index.count == 0);
+
+    /* Print results */
+    printf("Key hash index test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
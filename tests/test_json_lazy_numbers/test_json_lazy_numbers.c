@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[4096];
+static lwjson_t lwjson;
+
+/**
+ * \brief           Check if raw number text matches expected string
+ * \param[in]       token: Token to check
+ * \param[in]       text: Expected text
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_raw_is(const lwjson_token_t* token, const char* text) {
+    size_t len;
+    const char* str = lwjson_get_val_number_raw(token, &len);
+    return str != NULL && len == strlen(text) && strncmp(str, text, len) == 0;
+}
+
+/**
+ * \brief           Check if real number is close to expected value
+ * \param[in]       token: Token to check
+ * \param[in]       value: Expected value
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_real_is(const lwjson_token_t* token, double value) {
+    double diff;
+
+    if (token == NULL || token->type != LWJSON_TYPE_NUM_REAL) {
+        return 0;
+    }
+    diff = (double)lwjson_get_val_real(token) - value;
+    return (diff < 0 ? -diff : diff) <= (value < 0 ? -value : value) * 1e-12;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, count;
+    const lwjson_token_t* token;
+    const char* json_str = "\
+    {\
+        \"int\": 1234,\
+        \"neg\": -1234,\
+        \"zero\": 0,\
+        \"id\": 18446744073709551615,\
+        \"price\": 19.99,\
+        \"exp\": -123.5e-2,\
+        \"exp2\": 12E+3,\
+        \"arr\": [1,2.5,-3]\
+    }\
+    ";
+
+    printf("---\r\nTest JSON lazy numbers..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+    RUN_TEST(lwjson_parse(&lwjson, json_str) == lwjsonOK);
+
+    /* Types are known after parsing, values are converted on request */
+    RUN_TEST((token = lwjson_find(&lwjson, "int")) != NULL && token->type == LWJSON_TYPE_NUM_INT
+             && lwjson_get_val_int(token) == 1234 && prv_raw_is(token, "1234"));
+    RUN_TEST((token = lwjson_find(&lwjson, "neg")) != NULL && lwjson_get_val_int(token) == -1234
+             && prv_raw_is(token, "-1234"));
+    RUN_TEST((token = lwjson_find(&lwjson, "zero")) != NULL && lwjson_get_val_int(token) == 0
+             && prv_raw_is(token, "0"));
+    RUN_TEST((token = lwjson_find(&lwjson, "id")) != NULL && prv_real_is(token, 18446744073709551615.0)
+             && prv_raw_is(token, "18446744073709551615"));
+    RUN_TEST((token = lwjson_find(&lwjson, "price")) != NULL && prv_real_is(token, 19.99)
+             && prv_raw_is(token, "19.99"));
+    RUN_TEST((token = lwjson_find(&lwjson, "exp")) != NULL && prv_real_is(token, -1.235)
+             && prv_raw_is(token, "-123.5e-2"));
+    RUN_TEST((token = lwjson_find(&lwjson, "exp2")) != NULL && prv_real_is(token, 12000.0)
+             && prv_raw_is(token, "12E+3"));
+    RUN_TEST((token = lwjson_find(&lwjson, "arr.#0")) != NULL && lwjson_get_val_int(token) == 1);
+    RUN_TEST((token = lwjson_find(&lwjson, "arr.#1")) != NULL && prv_real_is(token, 2.5));
+    RUN_TEST((token = lwjson_find(&lwjson, "arr.#2")) != NULL && lwjson_get_val_int(token) == -3
+             && prv_raw_is(token, "-3"));
+
+    /* Values of other types */
+    RUN_TEST((token = lwjson_find(&lwjson, "price")) != NULL && lwjson_get_val_int(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "int")) != NULL && lwjson_get_val_real(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "arr")) != NULL && lwjson_get_val_number_raw(token, NULL) == NULL);
+    RUN_TEST(lwjson_get_val_int(NULL) == 0 && lwjson_get_val_real(NULL) == 0);
+
+    /* Number format is still checked during parsing */
+    RUN_TEST(lwjson_parse(&lwjson, "[1.]") == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse(&lwjson, "[1e]") == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse(&lwjson, "[-]") == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse(&lwjson, "[1.5x]") == lwjsonERRJSON);
+    RUN_TEST(lwjson_count_tokens("[1.]", 4, &count, NULL) == lwjsonERRJSON);
+    RUN_TEST(lwjson_count_tokens("[1.5e-3,2]", 10, &count, NULL) == lwjsonOK && count == 2);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("Lazy numbers test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[8];
+static lwjson_t lwjson;
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, pos, len, cnt;
+    const lwjson_token_t* token;
+    const char* ndjson = "{\"id\":1,\"name\":\"first\"}\n"
+                         "{\"id\":2,\"name\":\"second\"}\r\n"
+                         "\n"
+                         "  [3, \"}{\"]  \n";
+    const char* concat = "{\"a\":1}{\"a\":2}[3][]";
+
+    printf("---\r\nTest JSON multi-document parsing..\r\n");
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+
+    /* Newline delimited documents */
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, ndjson, strlen(ndjson), &pos, &len) == lwjsonOK);
+    RUN_TEST(pos == 0 && len == 23);
+    RUN_TEST((token = lwjson_find(&lwjson, "id")) != NULL && lwjson_get_val_int(token) == 1);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, ndjson, strlen(ndjson), &pos, &len) == lwjsonOK);
+    RUN_TEST(pos == 24 && len == 24 && ndjson[pos] == '{' && ndjson[pos + len - 1] == '}');
+    RUN_TEST((token = lwjson_find(&lwjson, "name")) != NULL && strncmp(token->u.str.token_value, "second", 6) == 0);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, ndjson, strlen(ndjson), &pos, &len) == lwjsonOK);
+    RUN_TEST(pos == 53 && len == 9 && lwjson_get_tokens_used(&lwjson) == 3);
+    RUN_TEST((token = lwjson_find(&lwjson, "#1")) != NULL && token->u.str.token_value_len == 2);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, ndjson, strlen(ndjson), &pos, &len) == lwjsonPARSEEND);
+    RUN_TEST(lwjson_find(&lwjson, "#0") == NULL);
+
+    /* Concatenated documents without separator */
+    cnt = 0;
+    for (pos = 0; lwjson_parse_many(&lwjson, concat, strlen(concat), &pos, &len) == lwjsonOK; pos += len) {
+        ++cnt;
+    }
+    RUN_TEST(cnt == 4 && pos == strlen(concat));
+
+    /* Invalid and incomplete documents */
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n[1 2]\n", 10, &pos, &len) == lwjsonOK);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n[1 2]\n", 10, &pos, &len) == lwjsonERRJSON);
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n[1,", 7, &pos, &len) == lwjsonOK);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n[1,", 7, &pos, &len) == lwjsonERRJSON);
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1] x", 5, &pos, &len) == lwjsonOK);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1] x", 5, &pos, &len) == lwjsonERRJSON);
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, " \n ", 3, &pos, &len) == lwjsonPARSEEND);
+    pos = 4;
+    RUN_TEST(lwjson_parse_many(&lwjson, " \n ", 3, &pos, &len) == lwjsonERRPAR);
+
+    /* NULL character before the end of data does not hide next documents */
+    pos = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n\0\n[2]", 9, &pos, &len) == lwjsonOK);
+    pos += len;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\n\0\n[2]", 9, &pos, &len) == lwjsonERRJSON);
+    pos = 3;
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\0", 4, &pos, &len) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_many(&lwjson, "[1]\0", 3, &pos, &len) == lwjsonPARSEEND);
+
+    /* Single document parse still rejects trailing data */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"a\":1}{\"a\":2}") == lwjsonERR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("Multi-document parsing test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
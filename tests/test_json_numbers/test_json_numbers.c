@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[4096];
+static lwjson_t lwjson;
+
+/* Buffer for generated JSON strings */
+static char json_buff[8192];
+
+/* Real numbers, that are difficult to round correctly */
+static const char* real_numbers[] = {
+    "0.1",
+    "0.3",
+    "1e23",
+    "9007199254740993.0",
+    "2.2250738585072011e-308",
+    "2.2250738585072012e-308",
+    "4.9406564584124654e-324",
+    "2.4703282292062328e-324",
+    "1.7976931348623157e308",
+    "1.7976931348623158e308",
+    "7.038531e-26",
+    "8.589973e9",
+    "3.14159265358979323846264338327950288419716939937510",
+    "2.71828182845904523536028747135266249775724709369995e-100",
+    "0.000000000000000000000000000000123456789012345678901234567890",
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.00000000000000011102230246251565404236316680908203124",
+    "1.00000000000000011102230246251565404236316680908203126",
+    "45.5709",
+    "15.193",
+    "-0.0",
+    "1e-400",
+    "12345678.87654321e-5",
+    "1E+2",
+};
+
+/**
+ * \brief           Check if number text is parsed to the same value as with `strtod` or `strtof`
+ * \param[in]       str: Number text
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_check_real(const char* str) {
+    const lwjson_token_t* token;
+    lwjson_real_t expected, value;
+
+    if (sizeof(lwjson_real_t) == sizeof(float)) {
+        expected = (lwjson_real_t)strtof(str, NULL);
+    } else {
+        expected = (lwjson_real_t)strtod(str, NULL);
+    }
+
+    snprintf(json_buff, sizeof(json_buff), "[%s]", str);
+    if (lwjson_parse(&lwjson, json_buff) != lwjsonOK || (token = lwjson_find(&lwjson, "#0")) == NULL
+        || token->type != LWJSON_TYPE_NUM_REAL) {
+        return 0;
+    }
+    value = lwjson_get_val_real(token);
+    return memcmp(&value, &expected, sizeof(value)) == 0;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, mismatches = 0;
+    const lwjson_token_t* token;
+
+    printf("---\r\nTest JSON numbers..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    /* Integer limits */
+    RUN_TEST(lwjson_parse(&lwjson, "[9223372036854775807,-9223372036854775808,0,-0,12345678,123456789012]")
+             == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "#0")) != NULL && lwjson_get_val_int(token) == 9223372036854775807LL);
+    RUN_TEST((token = lwjson_find(&lwjson, "#1")) != NULL
+             && lwjson_get_val_int(token) == -9223372036854775807LL - 1);
+    RUN_TEST((token = lwjson_find(&lwjson, "#2")) != NULL && lwjson_get_val_int(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "#3")) != NULL && lwjson_get_val_int(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "#4")) != NULL && lwjson_get_val_int(token) == 12345678);
+    RUN_TEST((token = lwjson_find(&lwjson, "#5")) != NULL && lwjson_get_val_int(token) == 123456789012LL);
+
+    /* Integer overflow is an error */
+    RUN_TEST(lwjson_parse(&lwjson, "[9223372036854775808]") == lwjsonERRRANGE);
+    RUN_TEST(lwjson_parse(&lwjson, "[-9223372036854775809]") == lwjsonERRRANGE);
+    RUN_TEST(lwjson_parse(&lwjson, "{\"id\":123456789012345678901234567890}") == lwjsonERRRANGE);
+    RUN_TEST(lwjson_count_tokens("[9223372036854775808]", 21, NULL, NULL) == lwjsonERRRANGE);
+    RUN_TEST(lwjson_count_tokens("[9223372036854775807]", 21, NULL, NULL) == lwjsonOK);
+
+    /* Real numbers must be correctly rounded */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(real_numbers); ++i) {
+        if (!prv_check_real(real_numbers[i])) {
+            printf("Real number mismatch: %s\r\n", real_numbers[i]);
+            ++mismatches;
+        }
+    }
+    RUN_TEST(mismatches == 0);
+
+    /* Random doubles with different number of digits */
+    srand(1);
+    mismatches = 0;
+    for (size_t i = 0; i < 20000; ++i) {
+        char str[64];
+        uint64_t bits = 0;
+        double val;
+
+        for (size_t b = 0; b < 4; ++b) {
+            bits = (bits << 16) | (uint64_t)(rand() & 0xFFFF);
+        }
+        memcpy(&val, &bits, sizeof(val));
+        if (val != val || val - val != 0) { /* Skip NaN and infinity */
+            continue;
+        }
+        snprintf(str, sizeof(str), "%.*e", (int)(i % 20), val);
+        if (!prv_check_real(str)) {
+            if (++mismatches < 5) {
+                printf("Real number mismatch: %s\r\n", str);
+            }
+        }
+    }
+    RUN_TEST(mismatches == 0);
+
+    /* Numbers exactly half-way between two floats and slightly above, double value is the same for both */
+    mismatches = 0;
+    for (size_t i = 0; i < 2000; ++i) {
+        char str[80], *e;
+        double val = (1.0 + (double)((rand() & 0x7FFFFF) * 2 + 1) / 16777216.0) * (double)(1 << (i % 16)) / 256.0;
+
+        snprintf(str, sizeof(str), "%.40e", val);
+        mismatches += !prv_check_real(str);
+        e = strchr(str, 'e');
+        memmove(e + 1, e, strlen(e) + 1);
+        *e = '1';
+        if (!prv_check_real(str)) {
+            if (++mismatches < 5) {
+                printf("Real number mismatch: %s\r\n", str);
+            }
+        }
+    }
+    RUN_TEST(mismatches == 0);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("Numbers test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
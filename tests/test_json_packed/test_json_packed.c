@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance */
+static lwjson_token_t tokens[64];
+static lwjson_t lwjson;
+
+/* JSON data used for all tests */
+static const char json_data[] = "\
+{\n\
+    \"ints\": [1, -2, 3, 40, 500, 6000, 70000, -8],\n\
+    \"reals\": [1.5, -2.25, 3e2],\n\
+    \"bools\": [true, false, false, true],\n\
+    \"mixed\": [1, 2.5, 3],\n\
+    \"strs\": [\"a\", \"b\"],\n\
+    \"one\": [7],\n\
+    \"empty\": [],\n\
+    \"nested\": [[1, 2, 3], [4, 5, 6]],\n\
+    \"last\": 9\n\
+}";
+
+/**
+ * \brief           Parse NULL terminated string with packed arrays
+ * \param[in]       str: JSON string
+ * \return          Result of parsing
+ */
+static lwjsonr_t
+prv_parse_packed(const char* str) {
+    return lwjson_parse_packed(&lwjson, str, strlen(str));
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, len;
+    const lwjson_token_t *t, *arr;
+    const lwjson_int_t* ints;
+    const lwjson_real_t* reals;
+    const uint8_t* bools;
+    lwjson_token_t elem, elem2;
+    lwjson_array_iter_t iter;
+    lwjson_type_t type;
+    size_t count, used;
+
+    printf("---\r\nTest JSON packed arrays..\r\n");
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+
+    /* Arrays are packed only on request, other parse functions keep children tokens */
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_data, strlen(json_data)) == lwjsonOK);
+    arr = lwjson_find(&lwjson, "ints");
+    RUN_TEST(arr != NULL && lwjson_get_packed(arr, NULL, NULL) == NULL && lwjson_get_first_child(arr) != NULL);
+    t = lwjson_find(&lwjson, "ints.#5");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 6000);
+    used = lwjson_get_tokens_used(&lwjson);
+
+    RUN_TEST(lwjson_parse_packed(&lwjson, json_data, strlen(json_data)) == lwjsonOK);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) < used);
+
+    /* Integers */
+    arr = lwjson_find(&lwjson, "ints");
+    ints = lwjson_get_packed(arr, &type, &len);
+    RUN_TEST(arr != NULL && arr->type == LWJSON_TYPE_ARRAY && lwjson_get_first_child(arr) == NULL);
+    RUN_TEST(ints != NULL && type == LWJSON_TYPE_NUM_INT && len == 8);
+    RUN_TEST(ints != NULL && ints[0] == 1 && ints[1] == -2 && ints[6] == 70000 && ints[7] == -8);
+    RUN_TEST(lwjson_get_subtree_size(arr) > 0 && lwjson_get_subtree_size(arr) < 8);
+
+    /* Reals */
+    arr = lwjson_find(&lwjson, "reals");
+    reals = lwjson_get_packed(arr, &type, &len);
+    RUN_TEST(reals != NULL && type == LWJSON_TYPE_NUM_REAL && len == 3);
+    RUN_TEST(reals != NULL && reals[0] == 1.5 && reals[1] == -2.25 && reals[2] == 300.0);
+
+    /* Booleans */
+    arr = lwjson_find(&lwjson, "bools");
+    bools = lwjson_get_packed(arr, &type, &len);
+    RUN_TEST(bools != NULL && type == LWJSON_TYPE_TRUE && len == 4);
+    RUN_TEST(bools != NULL && bools[0] == 1 && bools[1] == 0 && bools[2] == 0 && bools[3] == 1);
+
+    /* Arrays, that are not packed, have children tokens */
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "mixed"), NULL, NULL) == NULL);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "strs"), NULL, NULL) == NULL);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "empty"), NULL, NULL) == NULL);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "nested"), NULL, NULL) == NULL);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "nested.#1"), NULL, NULL) != NULL);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "last"), NULL, NULL) == NULL);
+    t = lwjson_array_get_ex(&lwjson, lwjson_find(&lwjson, "one"), 0, &elem);
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 7);
+    t = lwjson_find(&lwjson, "mixed.#1");
+    RUN_TEST(t != NULL && t->type == LWJSON_TYPE_NUM_REAL && lwjson_get_val_real(t) == 2.5);
+
+    /* Values of packed arrays have no tokens and are not found */
+    RUN_TEST(lwjson_find(&lwjson, "ints.#5") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "bools.#0") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "nested.#1.#2") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "ints.#0.x") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "ints.#.x") == NULL);
+    t = lwjson_find(&lwjson, "last");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 9);
+
+    /* Values are copied to application tokens by index */
+    arr = lwjson_find(&lwjson, "reals");
+    RUN_TEST(lwjson_array_get(&lwjson, arr, 2) == NULL);
+    t = lwjson_array_get_ex(&lwjson, arr, 2, &elem);
+    RUN_TEST(t == &elem && t->type == LWJSON_TYPE_NUM_REAL && lwjson_get_val_real(t) == 300.0);
+    RUN_TEST(lwjson_array_get_ex(&lwjson, arr, 3, &elem) == NULL);
+    RUN_TEST(lwjson_array_size(&lwjson, arr) == 3);
+    RUN_TEST(lwjson_array_size(&lwjson, lwjson_find(&lwjson, "ints")) == 8);
+    arr = lwjson_find(&lwjson, "bools");
+    RUN_TEST(lwjson_array_get_ex(&lwjson, arr, 0, &elem) == &elem && lwjson_array_get_ex(&lwjson, arr, 2, &elem2) == &elem2
+             && elem.type == LWJSON_TYPE_TRUE && elem2.type == LWJSON_TYPE_FALSE);
+    arr = lwjson_find(&lwjson, "ints");
+    RUN_TEST(lwjson_array_get_ex(&lwjson, arr, 0, &elem) == &elem && lwjson_array_get_ex(&lwjson, arr, 1, &elem2) == &elem2
+             && lwjson_get_val_int(&elem) == 1 && lwjson_get_val_int(&elem2) == -2);
+    arr = lwjson_find(&lwjson, "mixed");
+    t = lwjson_array_get_ex(&lwjson, arr, 1, &elem);
+    RUN_TEST(t != NULL && t != &elem && t == lwjson_array_get(&lwjson, arr, 1) && lwjson_get_val_real(t) == 2.5);
+
+    /* Siblings after packed arrays */
+    t = lwjson_find(&lwjson, "ints");
+    t = lwjson_get_next(t);
+    RUN_TEST(t != NULL && lwjson_get_packed(t, NULL, NULL) == reals);
+    RUN_TEST(lwjson_skip_subtree(&lwjson, t) == lwjson_get_next(t));
+
+    /* Iterator over packed and not packed arrays */
+    count = 0;
+    lwjson_array_iter_init(&iter, lwjson_find(&lwjson, "ints"));
+    for (t = lwjson_array_iter_next(&iter); t != NULL; t = lwjson_array_iter_next(&iter)) {
+        count += t->type == LWJSON_TYPE_NUM_INT && lwjson_get_val_int(t) == ints[iter.index - 1];
+    }
+    RUN_TEST(count == 8 && iter.index == 8);
+    count = 0;
+    lwjson_array_iter_init(&iter, lwjson_find(&lwjson, "bools"));
+    for (t = lwjson_array_iter_next(&iter); t != NULL; t = lwjson_array_iter_next(&iter)) {
+        count += t->type == (count == 0 || count == 3 ? LWJSON_TYPE_TRUE : LWJSON_TYPE_FALSE);
+    }
+    RUN_TEST(count == 4);
+    count = 0;
+    lwjson_array_iter_init(&iter, lwjson_find(&lwjson, "mixed"));
+    for (t = lwjson_array_iter_next(&iter); t != NULL; t = lwjson_array_iter_next(&iter)) {
+        ++count;
+    }
+    RUN_TEST(count == 3);
+    lwjson_array_iter_init(&iter, lwjson_find(&lwjson, "empty"));
+    RUN_TEST(lwjson_array_iter_next(&iter) == NULL);
+    lwjson_array_iter_init(&iter, lwjson_find(&lwjson, "last"));
+    RUN_TEST(lwjson_array_iter_next(&iter) == NULL);
+
+    /* Packed arrays take fewer tokens than counted */
+    RUN_TEST(lwjson_count_tokens(json_data, strlen(json_data), &count, NULL) == lwjsonOK);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) < count);
+
+    /* Invalid arrays are reported the same way as without packing */
+    RUN_TEST(prv_parse_packed("[1, 2 3]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse_packed("[1, 2, 3") != lwjsonOK);
+    RUN_TEST(prv_parse_packed("[1, 2, 1.]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse_packed("[true, false, nul]") == lwjsonERRJSON);
+    RUN_TEST(prv_parse_packed("{\"a\": [true, false], \"b\": [1, 2.5]}") == lwjsonOK);
+    RUN_TEST(prv_parse_packed("[[1, 2, 3], [4, 5, 6]]") == lwjsonOK);
+    RUN_TEST(prv_parse_packed("[[1, 2, 3] ,[4, 5, 6] ] ") == lwjsonOK);
+
+    /* Counted number of tokens is enough, when packing needs more tokens than values */
+    {
+        static const char* data[] = {"[1]", "[true]", "[[1], [2.5], 3]", "{\"a\": [1, 2, 3]}", "[false, true, 1]"};
+        lwjson_token_t few[8];
+        lwjson_t lw;
+
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(data); ++i) {
+            RUN_TEST(lwjson_count_tokens(data[i], strlen(data[i]), &count, NULL) == lwjsonOK);
+            lwjson_init(&lw, few, count);
+            RUN_TEST(lwjson_parse_packed(&lw, data[i], strlen(data[i])) == lwjsonOK);
+            lwjson_free(&lw);
+        }
+        lwjson_init(&lw, few, LWJSON_ARRAYSIZE(few));
+        RUN_TEST(lwjson_parse_packed(&lw, "[false, true, 1]", 16) == lwjsonOK);
+        t = lwjson_find(&lw, "#2");
+        RUN_TEST(t != NULL && t->type == LWJSON_TYPE_NUM_INT && lwjson_get_val_int(t) == 1);
+        lwjson_free(&lw);
+    }
+
+    /* Resumed and projected parsing create the same tokens as parsing at once, without packing */
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_data, strlen(json_data)) == lwjsonOK);
+    used = lwjson_get_tokens_used(&lwjson);
+    RUN_TEST(lwjson_parse_begin(&lwjson) == lwjsonOK);
+    RUN_TEST(lwjson_parse_resume(&lwjson, json_data, strlen(json_data) / 2, 0) == lwjsonPARSEINPROG);
+    RUN_TEST(lwjson_parse_resume(&lwjson, json_data, strlen(json_data), 3) == lwjsonPARSEINPROG);
+    RUN_TEST(lwjson_parse_resume(&lwjson, json_data, strlen(json_data), 0) == lwjsonOK);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) == used);
+    t = lwjson_find(&lwjson, "ints.#5");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 6000 && lwjson_get_packed(lwjson_find(&lwjson, "ints"), NULL, NULL) == NULL);
+    {
+        static const char* paths[] = {"ints"};
+
+        RUN_TEST(lwjson_parse_projected(&lwjson, json_data, strlen(json_data), paths, 1) == lwjsonOK);
+        t = lwjson_find(&lwjson, "ints.#7");
+        RUN_TEST(t != NULL && lwjson_get_val_int(t) == -8);
+    }
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("Packed arrays test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,12 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_json_parallel.c
+)
+
+# Options file
+set(LWJSON_OPTS_FILE ${CMAKE_CURRENT_LIST_DIR}/lwjson_opts.h)
+
+# Pipeline module
+target_link_libraries(${CMAKE_PROJECT_NAME} PUBLIC lwjson_pipeline)
@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+#define TOKENS_CNT 200000
+
+/* LwJSON instances and tokens for single and multi-threaded parsing */
+static lwjson_token_t tokens_ser[TOKENS_CNT], tokens_par[TOKENS_CNT];
+static lwjson_t lwjson_ser, lwjson_par;
+static uint32_t rnd_state = 1;
+static uint8_t malloc_fail;
+
+/**
+ * \brief           Allocate memory, used by parallel parser
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Allocated memory, `NULL` when allocation is set to fail
+ */
+void*
+test_malloc(size_t size) {
+    return malloc_fail ? NULL : malloc(size);
+}
+
+/**
+ * \brief           Get pseudo random number
+ * \param[in]       max: Max value, excluded
+ * \return          Random number
+ */
+static size_t
+prv_rand(size_t max) {
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (size_t)(rnd_state >> 8) % max;
+}
+
+/**
+ * \brief           Generate large JSON document with strings, that contain quotes, brackets and commas
+ * \param[in]       data: Output buffer
+ * \param[in]       obj: Set to `1` to generate root object, `0` for root array
+ * \param[in]       cnt: Number of members of the root
+ * \return          Length of the document
+ */
+static size_t
+prv_generate(char* data, int obj, size_t cnt) {
+    static const char* strings[] = {
+        "plain",     "with, comma", "[brackets]", "{braces}", "quote \\\" inside", "back\\\\slash", "\\\\\\\\\\\\",
+        "\\\\\\\"],", "\\u0041\\n",  "",
+    };
+    size_t len = 0;
+
+    len += sprintf(&data[len], obj ? " {\n" : " [\n");
+    for (size_t i = 0; i < cnt; ++i) {
+        if (i > 0) {
+            len += sprintf(&data[len], ",%s", prv_rand(4) == 0 ? "\n  " : "");
+        }
+        if (obj) {
+            len += sprintf(&data[len], "\"key%u\":", (unsigned)i);
+        }
+        switch (prv_rand(5)) {
+            case 0: len += sprintf(&data[len], "%u", (unsigned)i); break;
+            case 1: len += sprintf(&data[len], "\"%s\"", strings[prv_rand(LWJSON_ARRAYSIZE(strings))]); break;
+            case 2: len += sprintf(&data[len], "[]"); break;
+            case 3:
+                len += sprintf(&data[len], "[\"%s\", {\"a\": [1, -2.5, null]}, true, {}]",
+                               strings[prv_rand(LWJSON_ARRAYSIZE(strings))]);
+                break;
+            default:
+                len += sprintf(&data[len], "{\"id\":%u,\"n\":{\"s\":\"%s\",\"x\":[[false],[\"%s\"]]}}", (unsigned)i,
+                               strings[prv_rand(LWJSON_ARRAYSIZE(strings))],
+                               strings[prv_rand(LWJSON_ARRAYSIZE(strings))]);
+                break;
+        }
+    }
+    len += sprintf(&data[len], obj ? "\n}\n" : "\n]\n");
+    return len;
+}
+
+/**
+ * \brief           Compare tokens and all their siblings and children
+ * \param[in]       ta: First token of the list in single-threaded instance
+ * \param[in]       tb: First token of the list in multi-threaded instance
+ * \return          `1` if lists are equal, `0` otherwise
+ */
+static int
+prv_equal(const lwjson_token_t* ta, const lwjson_token_t* tb) {
+    for (; ta != NULL && tb != NULL; ta = lwjson_get_next(ta), tb = lwjson_get_next(tb)) {
+        const char *sa, *sb;
+        size_t la = 0, lb = 0;
+
+        if (ta->type != tb->type) {
+            return 0;
+        }
+        sa = lwjson_get_token_name(&lwjson_ser, ta, &la);
+        sb = lwjson_get_token_name(&lwjson_par, tb, &lb);
+        if (sa != sb || la != lb) {
+            return 0;
+        }
+        switch (ta->type) {
+            case LWJSON_TYPE_STRING:
+                sa = lwjson_get_val_string_ex(&lwjson_ser, ta, &la);
+                sb = lwjson_get_val_string_ex(&lwjson_par, tb, &lb);
+                if (sa != sb || la != lb) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_INT:
+                if (lwjson_get_val_int(ta) != lwjson_get_val_int(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_REAL:
+                if (lwjson_get_val_real(ta) != lwjson_get_val_real(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_OBJECT:
+            case LWJSON_TYPE_ARRAY:
+                if (!prv_equal(lwjson_get_first_child(ta), lwjson_get_first_child(tb))) {
+                    return 0;
+                }
+                break;
+            default: break;
+        }
+    }
+    return ta == NULL && tb == NULL;
+}
+
+/**
+ * \brief           Parse data with one and with several threads and compare results
+ * \param[in]       data: JSON data
+ * \param[in]       len: JSON data length
+ * \param[in]       workers: Number of worker threads
+ * \return          `1` if results are equal, `0` otherwise
+ */
+static int
+prv_parse_compare(const char* data, size_t len, size_t workers) {
+    lwjsonr_t res_ser, res_par;
+
+    res_ser = lwjson_parse_ex(&lwjson_ser, data, len);
+    res_par = lwjson_parse_parallel(&lwjson_par, data, len, workers);
+    if (res_ser != res_par) {
+        return 0;
+    }
+    return res_ser != lwjsonOK
+           || (lwjson_get_tokens_used(&lwjson_ser) == lwjson_get_tokens_used(&lwjson_par)
+               && prv_equal(lwjson_get_first_token(&lwjson_ser), lwjson_get_first_token(&lwjson_par)));
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, len, count;
+    char* data = malloc(4 * 1024 * 1024);
+
+    printf("---\r\nTest JSON parallel parsing..\r\n");
+    lwjson_init(&lwjson_ser, tokens_ser, LWJSON_ARRAYSIZE(tokens_ser));
+    lwjson_init(&lwjson_par, tokens_par, LWJSON_ARRAYSIZE(tokens_par));
+
+    /* Root array, split to different number of parts */
+    len = prv_generate(data, 0, 30000);
+    RUN_TEST(len > 8 * 65536);
+    for (size_t workers = 1; workers <= 12; ++workers) {
+        RUN_TEST(prv_parse_compare(data, len, workers));
+    }
+
+    RUN_TEST(prv_parse_compare(data, len, 0));
+
+    /* Data are parsed with one thread when there is no memory for parts */
+    malloc_fail = 1;
+    RUN_TEST(prv_parse_compare(data, len, 4));
+    malloc_fail = 0;
+
+    /* Exact number of tokens, parts with more tokens per byte run out of them and are parsed again */
+    RUN_TEST(lwjson_count_tokens(data, len, &count, NULL) == lwjsonOK);
+    lwjson_init(&lwjson_par, tokens_par, count);
+    for (size_t workers = 2; workers <= 8; ++workers) {
+        RUN_TEST(prv_parse_compare(data, len, workers));
+    }
+
+    /* Root object */
+    len = prv_generate(data, 1, 30000);
+    lwjson_init(&lwjson_par, tokens_par, LWJSON_ARRAYSIZE(tokens_par));
+    RUN_TEST(prv_parse_compare(data, len, 4));
+    RUN_TEST(prv_parse_compare(data, len, 7));
+
+    /* Exact number of tokens, parts may run out of tokens */
+    RUN_TEST(lwjson_parse_ex(&lwjson_ser, data, len) == lwjsonOK);
+    lwjson_init(&lwjson_par, tokens_par, lwjson_get_tokens_used(&lwjson_ser) + 1);
+    RUN_TEST(prv_parse_compare(data, len, 4));
+    RUN_TEST(prv_parse_compare(data, len, 7));
+    lwjson_init(&lwjson_par, tokens_par, lwjson_get_tokens_used(&lwjson_ser) / 2);
+    RUN_TEST(lwjson_parse_parallel(&lwjson_par, data, len, 4) == lwjsonERRMEM);
+    lwjson_init(&lwjson_par, tokens_par, LWJSON_ARRAYSIZE(tokens_par));
+
+    /* Invalid data gives the same result as single-threaded parsing */
+    strstr(&data[len / 2], "[]")[1] = '}';
+    RUN_TEST(prv_parse_compare(data, len, 4) && lwjson_parse_ex(&lwjson_ser, data, len) != lwjsonOK);
+    len = prv_generate(data, 0, 30000);
+    memcpy(&data[len - 2], "}\n", 2);
+    RUN_TEST(prv_parse_compare(data, len, 4) && lwjson_parse_ex(&lwjson_ser, data, len) != lwjsonOK);
+    len = prv_generate(data, 0, 30000);
+    strstr(&data[len / 3], "[]")[0] = '"';
+    RUN_TEST(prv_parse_compare(data, len, 4) && lwjson_parse_ex(&lwjson_ser, data, len) != lwjsonOK);
+    len = prv_generate(data, 0, 30000);
+    data[len / 3] = '\0';
+    RUN_TEST(prv_parse_compare(data, len, 4));
+
+    /* Short and empty data are parsed with one thread */
+    RUN_TEST(prv_parse_compare("[1, 2, [3]]", 11, 4));
+    RUN_TEST(prv_parse_compare("[]", 2, 4));
+    RUN_TEST(prv_parse_compare("", 0, 4));
+    RUN_TEST(lwjson_parse_parallel(NULL, data, len, 4) == lwjsonERRPAR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson_ser);
+    lwjson_free(&lwjson_par);
+    free(data);
+
+    /* Print results */
+    printf("Parallel parsing test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -2,19 +2,28 @@
 #include "lwjson/lwjson.h"
 
 #define RUN_TEST(exp_res, json_str)                                                                                    \
-    if (lwjson_parse(&lwjson, (json_str)) == (exp_res)) {                                                              \
+    if (lwjson_parse(&lwjson, (json_str)) == (exp_res)                                                                 \
+        && lwjson_validate((json_str), strlen(json_str)) == (exp_res)) {                                               \
         ++test_passed;                                                                                                 \
     } else {                                                                                                           \
         ++test_failed;                                                                                                 \
         printf("Test failed for input %s on line %d\r\n", json_str, __LINE__);                                         \
     }
 #define RUN_TEST_EX(exp_res, json_str, len)                                                                            \
-    if (lwjson_parse_ex(&lwjson, (json_str), (len)) == (exp_res)) {                                                    \
+    if (lwjson_parse_ex(&lwjson, (json_str), (len)) == (exp_res)                                                       \
+        && lwjson_validate((json_str), (len)) == (exp_res)) {                                                          \
         ++test_passed;                                                                                                 \
     } else {                                                                                                           \
         ++test_failed;                                                                                                 \
         printf("Test failed for input %s on line %d\r\n", json_str, __LINE__);                                         \
     }
+#define RUN_TEST_PADDED(exp_res, json_str)                                                                             \
+    if (prv_parse_padded((json_str)) == (exp_res)) {                                                                   \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed for padded input %s on line %d\r\n", json_str, __LINE__);                                  \
+    }
 
 /**
  * \brief           Path and type parse check
@@ -28,6 +37,23 @@ typedef struct {
 static lwjson_token_t tokens[4096];
 static lwjson_t lwjson;
 
+/* Input buffer with padding for padded parse */
+static char padded_buff[256 + LWJSON_CFG_PADDING_LEN];
+
+/**
+ * \brief           Copy JSON string to padded buffer and parse it
+ * \param[in]       json_str: JSON string to parse
+ * \return          Parse result
+ */
+static lwjsonr_t
+prv_parse_padded(const char* json_str) {
+    size_t len = strlen(json_str);
+
+    memset(padded_buff, 0x00, sizeof(padded_buff));
+    memcpy(padded_buff, json_str, len);
+    return lwjson_parse_padded(&lwjson, padded_buff, len);
+}
+
 /**
  * \brief           Run all tests entry point
  */
@@ -115,6 +141,26 @@ test_run(void) {
     RUN_TEST_EX(lwjsonOK, "[1,2,3,4]",
                 15); /* String ends earlier than what is input data len indicating = OK if JSON is valid */
 
+    /* Tests with padded input */
+    RUN_TEST_PADDED(lwjsonOK, "{}");
+    RUN_TEST_PADDED(lwjsonOK, "{ \"k\" : [1, 2.5, true, false, null, \"s\\\"tr\"] }\r\n");
+    RUN_TEST_PADDED(lwjsonOK, "[[],[],{}]");
+    RUN_TEST_PADDED(lwjsonERRJSON, "{\"k\":\"abc");
+    RUN_TEST_PADDED(lwjsonERRJSON, "{\"k\":\"abc\\");
+    RUN_TEST_PADDED(lwjsonERRJSON, "{\"k\":\"\\u12");
+    RUN_TEST_PADDED(lwjsonERRJSON, "{\"k\":tru");
+    RUN_TEST_PADDED(lwjsonERRJSON, "{\"k\":1   ");
+    RUN_TEST_PADDED(lwjsonERRJSON, "[");
+    RUN_TEST_PADDED(lwjsonERRPAR, "");
+    /* First padding byte must be set to 0 */
+    memcpy(padded_buff, "[]x", 4);
+    if (lwjson_parse_padded(&lwjson, padded_buff, 2) == lwjsonERRPAR) {
+        ++test_passed;
+    } else {
+        ++test_failed;
+        printf("Test failed for padded input without NULL termination on line %d\r\n", __LINE__);
+    }
+
     /* Print results */
     printf("JSON parse test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
     return test_failed > 0 ? -1 : 0;
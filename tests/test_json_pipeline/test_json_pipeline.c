@@ -0,0 +1,280 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+#define RECORDS_CNT 5000
+
+/* Generated data and expected results */
+static char* data;
+static size_t data_len, exp_valid, exp_invalid, exp_id_sum;
+
+/* Results collected by callback */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static const char* last_record;
+static size_t valid, invalid, id_sum, next_id, order_errors;
+
+/* Number of threads, that can be created before thread creation starts failing */
+static size_t threads_allowed = SIZE_MAX;
+
+/**
+ * \brief           Create thread, or fail once \ref threads_allowed threads are created
+ */
+int
+test_thread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*fn)(void*), void* arg) {
+    if (threads_allowed == 0) {
+        return -1;
+    }
+    --threads_allowed;
+    return pthread_create(thread, attr, fn, arg);
+}
+
+/**
+ * \brief           Generate newline delimited JSON data with valid, invalid, too large and blank records
+ */
+static void
+prv_generate(void) {
+    size_t size = 0;
+
+    data = malloc(RECORDS_CNT * 700);
+    for (size_t i = 0; i < RECORDS_CNT; ++i) {
+        if (i % 37 == 5) {
+            size += sprintf(&data[size], "{\"id\":%u,\"broken\":[1,2\n", (unsigned)i);
+            ++exp_invalid;
+        } else if (i % 501 == 7) {
+            /* Record needs more tokens than worker has */
+            size += sprintf(&data[size], "{\"id\":%u,\"big\":[", (unsigned)i);
+            for (size_t k = 0; k < 300; ++k) {
+                size += sprintf(&data[size], "%s%u", k > 0 ? "," : "", (unsigned)k);
+            }
+            size += sprintf(&data[size], "]}\n");
+            ++exp_invalid;
+        } else {
+            size += sprintf(&data[size], "{\"id\":%u,\"s\":\"rec\\n%u\",\"v\":[", (unsigned)i, (unsigned)(i * 7));
+            for (size_t k = 0; k < i % 9; ++k) {
+                size += sprintf(&data[size], "%s{\"k\":%u}", k > 0 ? "," : "", (unsigned)k);
+            }
+            size += sprintf(&data[size], "]}%s\n", i % 3 == 0 ? "\r" : "");
+            ++exp_valid;
+            exp_id_sum += i;
+        }
+        if (i % 11 == 0) {
+            size += sprintf(&data[size], "  \n");
+        }
+    }
+    data_len = size;
+}
+
+/**
+ * \brief           Get record ID
+ * \param[in]       lwobj: Instance with parsed record
+ * \return          Record ID
+ */
+static size_t
+prv_get_id(const lwjson_t* lwobj) {
+    const lwjson_token_t* t = lwjson_find((lwjson_t*)lwobj, "id");
+    return t != NULL ? (size_t)lwjson_get_val_int(t) : (size_t)-1;
+}
+
+/**
+ * \brief           Record callback for ordered mode
+ */
+static void
+prv_ordered_fn(void* user_data, const lwjson_t* lwobj, const char* record, size_t len, lwjsonr_t res) {
+    size_t id;
+
+    (void)user_data;
+    (void)len;
+    if (last_record != NULL && record <= last_record) {
+        ++order_errors;
+    }
+    last_record = record;
+    if (res == lwjsonOK) {
+        /* Skip IDs of invalid records */
+        id = prv_get_id(lwobj);
+        while (next_id < id && (next_id % 37 == 5 || next_id % 501 == 7)) {
+            ++next_id;
+        }
+        if (id != next_id) {
+            ++order_errors;
+        }
+        next_id = id + 1;
+        ++valid;
+        id_sum += id;
+    } else {
+        ++invalid;
+    }
+}
+
+/**
+ * \brief           Record callback for unordered mode
+ */
+static void
+prv_unordered_fn(void* user_data, const lwjson_t* lwobj, const char* record, size_t len, lwjsonr_t res) {
+    size_t id = res == lwjsonOK ? prv_get_id(lwobj) : 0;
+
+    (void)user_data;
+    pthread_mutex_lock(&lock);
+    if (res == lwjsonOK) {
+        ++valid;
+        id_sum += id;
+        if (record[0] != '{' || record[len - 1] != '}') {
+            ++order_errors;
+        }
+    } else {
+        ++invalid;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * \brief           Record callback, that only counts valid and invalid records
+ */
+static void
+prv_count_fn(void* user_data, const lwjson_t* lwobj, const char* record, size_t len, lwjsonr_t res) {
+    (void)user_data;
+    (void)lwobj;
+    (void)record;
+    pthread_mutex_lock(&lock);
+    if (res == lwjsonOK) {
+        ++valid;
+    } else if (len > 0) {
+        ++invalid;
+    } else {
+        ++order_errors;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * \brief           Run pipeline on short data in both delivery modes, with one and several workers
+ * \param[in]       json: Newline delimited JSON data
+ * \param[in]       len: Data length
+ * \param[in]       exp_valid: Expected number of valid records
+ * \param[in]       exp_inv: Expected number of invalid records
+ * \return          `1` if all records are delivered as expected, `0` otherwise
+ */
+static int
+prv_run_short(const char* json, size_t len, size_t exp_valid_cnt, size_t exp_inv_cnt) {
+    lwjson_pipeline_cfg_t cfg;
+
+    memset(&cfg, 0x00, sizeof(cfg));
+    cfg.tokens_len = 64;
+    cfg.chunk_len = 4;
+    cfg.record_fn = prv_count_fn;
+    for (size_t i = 0; i < 4; ++i) {
+        cfg.ordered = i & 0x01;
+        cfg.workers = i < 2 ? 1 : 3;
+        valid = invalid = order_errors = 0;
+        if (lwjson_pipeline_run(&cfg, json, len) != lwjsonOK || valid != exp_valid_cnt || invalid != exp_inv_cnt
+            || order_errors != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Run pipeline and check collected results
+ * \param[in]       cfg: Pipeline configuration
+ * \return          `1` if all records are delivered as expected, `0` otherwise
+ */
+static int
+prv_run(const lwjson_pipeline_cfg_t* cfg) {
+    last_record = NULL;
+    valid = invalid = id_sum = next_id = order_errors = 0;
+    return lwjson_pipeline_run(cfg, data, data_len) == lwjsonOK && valid == exp_valid && invalid == exp_invalid
+           && id_sum == exp_id_sum && order_errors == 0;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0;
+    lwjson_pipeline_cfg_t cfg;
+
+    printf("---\r\nTest JSON pipeline..\r\n");
+    prv_generate();
+
+    /* Ordered delivery, with different number of workers, chunks and batches */
+    memset(&cfg, 0x00, sizeof(cfg));
+    cfg.tokens_len = 64;
+    cfg.ordered = 1;
+    cfg.record_fn = prv_ordered_fn;
+    RUN_TEST(prv_run(&cfg));
+    cfg.workers = 4;
+    cfg.chunk_len = 512;
+    RUN_TEST(prv_run(&cfg));
+    cfg.batch_recs = 1;
+    RUN_TEST(prv_run(&cfg));
+    cfg.workers = 1;
+    cfg.batch_recs = 3;
+    RUN_TEST(prv_run(&cfg));
+    cfg.workers = 16;
+    cfg.chunk_len = 1;
+    cfg.tokens_len = 256;
+    RUN_TEST(prv_run(&cfg));
+
+    /* Unordered delivery */
+    cfg.ordered = 0;
+    cfg.tokens_len = 64;
+    cfg.record_fn = prv_unordered_fn;
+    RUN_TEST(prv_run(&cfg));
+    cfg.workers = 3;
+    cfg.chunk_len = 4096;
+    RUN_TEST(prv_run(&cfg));
+
+    /* Only some workers can be started, their chunks go to the started ones */
+    cfg.ordered = 1;
+    cfg.record_fn = prv_ordered_fn;
+    cfg.workers = 4;
+    cfg.chunk_len = 512;
+    threads_allowed = 2;
+    RUN_TEST(prv_run(&cfg));
+    threads_allowed = 1;
+    RUN_TEST(prv_run(&cfg));
+    cfg.ordered = 0;
+    cfg.record_fn = prv_unordered_fn;
+    threads_allowed = 3;
+    RUN_TEST(prv_run(&cfg));
+    threads_allowed = 0;
+    RUN_TEST(lwjson_pipeline_run(&cfg, data, data_len) == lwjsonERR);
+    threads_allowed = SIZE_MAX;
+
+    /* Empty input and invalid parameters */
+    valid = invalid = 0;
+    RUN_TEST(lwjson_pipeline_run(&cfg, "\n \n", 3) == lwjsonOK && valid == 0 && invalid == 0);
+    RUN_TEST(lwjson_pipeline_run(&cfg, "", 0) == lwjsonOK);
+
+    /* `NULL` characters after blanks and at the end of data are invalid records, parsing continues after them */
+    {
+        static const char nul_line[] = "{\"a\":1}\n\n\0\n{\"b\":2}\n";
+        static const char nul_end[] = "{\"a\":1}\n";
+        static const char nul_only[] = " \n";
+
+        RUN_TEST(prv_run_short(nul_line, sizeof(nul_line), 2, 2));
+        RUN_TEST(prv_run_short(nul_line, sizeof(nul_line) - 1, 2, 1));
+        RUN_TEST(prv_run_short(nul_end, sizeof(nul_end), 1, 1));
+        RUN_TEST(prv_run_short(nul_end, sizeof(nul_end) - 1, 1, 0));
+        RUN_TEST(prv_run_short(nul_only, sizeof(nul_only), 0, 1));
+    }
+    RUN_TEST(lwjson_pipeline_run(NULL, data, data_len) == lwjsonERRPAR);
+    cfg.record_fn = NULL;
+    RUN_TEST(lwjson_pipeline_run(&cfg, data, data_len) == lwjsonERRPAR);
+    free(data);
+
+    /* Print results */
+    printf("Pipeline test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
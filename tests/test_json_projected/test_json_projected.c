@@ -0,0 +1,263 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instances for complete and projected parsing */
+static lwjson_token_t tokens_all[256], tokens_proj[256];
+static lwjson_t lwjson_all, lwjson_proj;
+
+/* JSON data used for all tests */
+static const char json_data[] = "\
+{\n\
+    \"id\": 15,\n\
+    \"name\": \"device\",\n\
+    \"skip\": {\"a\": [1, 2, {\"b\": \"}]\"}], \"c\": null},\n\
+    \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, \"tags\": [\"x\", \"y\"]},\n\
+    \"items\": [\n\
+        {\"id\": 1, \"val\": true, \"sub\": [10, 11]},\n\
+        7,\n\
+        {\"id\": 3, \"val\": false, \"sub\": []},\n\
+        {\"val\": null, \"sub\": [30, {\"deep\": 31}]}\n\
+    ],\n\
+    \"matrix\": [[1, 2], [3, 4], [5, 6]]\n\
+}";
+
+/**
+ * \brief           Compare tokens and all their siblings and children
+ * \param[in]       ta: First token of the list in complete instance
+ * \param[in]       tb: First token of the list in projected instance
+ * \return          `1` if lists are equal, `0` otherwise
+ */
+static int
+prv_equal(const lwjson_token_t* ta, const lwjson_token_t* tb) {
+    for (; ta != NULL && tb != NULL; ta = lwjson_get_next(ta), tb = lwjson_get_next(tb)) {
+        const char *sa, *sb;
+        size_t la = 0, lb = 0;
+
+        if (ta->type != tb->type) {
+            return 0;
+        }
+        sa = lwjson_get_token_name(&lwjson_all, ta, &la);
+        sb = lwjson_get_token_name(&lwjson_proj, tb, &lb);
+        if (sa != sb || la != lb) {
+            return 0;
+        }
+        switch (ta->type) {
+            case LWJSON_TYPE_STRING:
+                sa = lwjson_get_val_string_ex(&lwjson_all, ta, &la);
+                sb = lwjson_get_val_string_ex(&lwjson_proj, tb, &lb);
+                if (sa != sb || la != lb) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_INT:
+                if (lwjson_get_val_int(ta) != lwjson_get_val_int(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_REAL:
+                if (lwjson_get_val_real(ta) != lwjson_get_val_real(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_OBJECT:
+            case LWJSON_TYPE_ARRAY:
+                if (!prv_equal(lwjson_get_first_child(ta), lwjson_get_first_child(tb))) {
+                    return 0;
+                }
+                break;
+            default: break;
+        }
+    }
+    return ta == NULL && tb == NULL;
+}
+
+/**
+ * \brief           Parse data with projection and check that every path finds the same subtree
+ *                  as in complete parsing
+ * \param[in]       paths: Paths to select
+ * \param[in]       paths_cnt: Number of paths
+ * \param[in]       tokens: Expected number of used tokens
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+prv_check(const char* const* paths, size_t paths_cnt, size_t tokens) {
+    if (lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), paths, paths_cnt) != lwjsonOK
+        || lwjson_get_tokens_used(&lwjson_proj) != tokens) {
+        return 0;
+    }
+    for (size_t i = 0; i < paths_cnt; ++i) {
+        const lwjson_token_t *ta, *tb;
+
+        ta = lwjson_find(&lwjson_all, paths[i]);
+        tb = lwjson_find(&lwjson_proj, paths[i]);
+        if (ta == NULL || tb == NULL || ta->type != tb->type) {
+            return 0;
+        }
+        if ((ta->type == LWJSON_TYPE_OBJECT || ta->type == LWJSON_TYPE_ARRAY)
+            && !prv_equal(lwjson_get_first_child(ta), lwjson_get_first_child(tb))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0;
+    const lwjson_token_t* t;
+    char data[128];
+
+    printf("---\r\nTest JSON projected parsing..\r\n");
+    lwjson_init(&lwjson_all, tokens_all, LWJSON_ARRAYSIZE(tokens_all));
+    lwjson_init(&lwjson_proj, tokens_proj, LWJSON_ARRAYSIZE(tokens_proj));
+    RUN_TEST(lwjson_parse(&lwjson_all, json_data) == lwjsonOK);
+
+    /* Single members of the root and nested objects */
+    RUN_TEST(prv_check((const char*[]){"id"}, 1, 2));
+    RUN_TEST(prv_check((const char*[]){"name", "id"}, 2, 3));
+    RUN_TEST(prv_check((const char*[]){"cfg.limits.max"}, 1, 4));
+    RUN_TEST(prv_check((const char*[]){"cfg.limits"}, 1, 5));
+    RUN_TEST(prv_check((const char*[]){"cfg"}, 1, 9));
+    RUN_TEST(prv_check((const char*[]){"cfg.limits", "cfg"}, 2, 9));
+    RUN_TEST(prv_check((const char*[]){"cfg.tags", "cfg.mode"}, 2, 6));
+
+    /* Array members with index keep the same index, previous members have no children */
+    RUN_TEST(prv_check((const char*[]){"items.#2.id"}, 1, 6));
+    RUN_TEST(prv_check((const char*[]){"items.#3.sub.#1.deep"}, 1, 10));
+    RUN_TEST(prv_check((const char*[]){"matrix.#1.#0", "items.#0"}, 2, 12));
+    t = lwjson_find(&lwjson_proj, "matrix.#0");
+    RUN_TEST(t != NULL && t->type == LWJSON_TYPE_ARRAY && lwjson_get_first_child(t) == NULL);
+
+    /* Any array member */
+    RUN_TEST(prv_check((const char*[]){"items.#.id"}, 1, 8));
+    RUN_TEST(prv_check((const char*[]){"matrix.#.#1"}, 1, 11));
+
+    /* Paths, that select nothing, keep only root and matching parents */
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), (const char*[]){"missing"}, 1)
+                 == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson_proj) == 1);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), (const char*[]){"id.x", "cfg.x"}, 2)
+                 == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson_proj) == 2);
+
+    /* Invalid paths and too large indexes are not found, the same as with find, and keep no parents */
+    RUN_TEST(lwjson_parse(&lwjson_all, json_data) == lwjsonOK
+             && lwjson_find(&lwjson_all, "matrix.#18446744073709551617") == NULL);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data),
+                                    (const char*[]){"matrix.#18446744073709551617", "matrix.#4294967297", "items.#x"},
+                                    3)
+                 == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson_proj) == 1);
+
+    /* Exact number of tokens is enough, root token is not in the array of non-compact tokens */
+    lwjson_init(&lwjson_proj, tokens_proj, LWJSON_CFG_COMPACT_TOKENS ? 4 : 3);
+    RUN_TEST(prv_check((const char*[]){"cfg.limits.max"}, 1, 4));
+    lwjson_init(&lwjson_proj, tokens_proj, LWJSON_CFG_COMPACT_TOKENS ? 3 : 2);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), (const char*[]){"cfg.limits.max"}, 1)
+             == lwjsonERRMEM);
+    lwjson_init(&lwjson_proj, tokens_proj, LWJSON_ARRAYSIZE(tokens_proj));
+
+    /* Skipped members are still checked */
+    strcpy(data, "{\"a\": 1, \"b\": {\"c\": [1, 2 3]}}");
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, data, strlen(data), (const char*[]){"a"}, 1) == lwjsonERRJSON);
+    strcpy(data, "{\"a\": 1, \"b\": {\"c\": [1, 2]]}");
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, data, strlen(data), (const char*[]){"a"}, 1)
+             == lwjson_parse(&lwjson_all, data));
+    strcpy(data, "{\"a\": 1, \"b\": tru}");
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, data, strlen(data), (const char*[]){"a"}, 1) == lwjsonERRJSON);
+    strcpy(data, "{\"a\": 1, \"b\": {\"c\": [1, 2]");
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, data, strlen(data), (const char*[]){"a"}, 1) == lwjsonERRJSON);
+    strcpy(data, "[{\"a\": 1}, [2, 3], 4, \"5\"]");
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, data, strlen(data), (const char*[]){"#3"}, 1) == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson_proj) == 5);
+
+    /* Parsing stops once all paths are found, rest of data is not checked */
+    {
+        const lwjson_token_t* found[3] = {NULL};
+
+        strcpy(data, "{\"type\": \"msg\", \"hdr\": {\"id\": 7, \"ts\": [1, 2]}, \"body\": {\"x\": ]]]");
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, data, strlen(data), (const char*[]){"hdr.ts", "type"}, 2,
+                                          found)
+                     == lwjsonPARSEPARTIAL
+                 && lwjson_get_tokens_used(&lwjson_proj) == 6);
+        t = found[0] != NULL ? lwjson_get_first_child(found[0]) : NULL;
+        RUN_TEST(found[0] == lwjson_find(&lwjson_proj, "hdr.ts") && lwjson_get_val_int(t) == 1
+                 && lwjson_get_val_int(lwjson_get_next(t)) == 2);
+        RUN_TEST(found[1] == lwjson_find(&lwjson_proj, "type") && found[1] != NULL
+                 && found[1]->type == LWJSON_TYPE_STRING);
+        t = lwjson_find(&lwjson_proj, "hdr");
+        RUN_TEST(lwjson_find(&lwjson_proj, "hdr.id") == NULL && t != NULL && lwjson_get_next(t) == NULL);
+
+        /* Only the first match of any array member is stored */
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, json_data, strlen(json_data),
+                                          (const char*[]){"items.#.sub.#0", "id"}, 2, found)
+                     == lwjsonPARSEPARTIAL
+                 && lwjson_get_tokens_used(&lwjson_proj) == 6 && found[1] == lwjson_find(&lwjson_proj, "id")
+                 && found[0] != NULL && lwjson_get_val_int(found[0]) == 10);
+
+        /* Missing path needs complete data */
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, json_data, strlen(json_data),
+                                          (const char*[]){"cfg.mode", "missing", "matrix.#2"}, 3, found)
+                     == lwjsonOK
+                 && found[0] != NULL && found[1] == NULL && found[2] == lwjson_find(&lwjson_proj, "matrix.#2"));
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, data, strlen(data), (const char*[]){"body.y"}, 1, found)
+                 == lwjsonERRJSON);
+
+        /* Closing bracket of the root is not checked either */
+        strcpy(data, "[1, [2, 3]]");
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, data, strlen(data), (const char*[]){"#1"}, 1, NULL)
+                     == lwjsonPARSEPARTIAL
+                 && lwjson_get_tokens_used(&lwjson_proj) == 5);
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, data, strlen(data), (const char*[]){"#1.#2"}, 1, NULL)
+                 == lwjsonOK);
+    }
+
+    /* Maximal number of paths, only the last one is not found until the end */
+    {
+        const lwjson_token_t* found[LWJSON_PROJ_MAX_PATHS];
+        const char* paths[LWJSON_PROJ_MAX_PATHS + 1];
+
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(paths); ++i) {
+            paths[i] = "id";
+        }
+        paths[LWJSON_PROJ_MAX_PATHS - 1] = "matrix.#1";
+        RUN_TEST(lwjson_parse_until_found(&lwjson_proj, json_data, strlen(json_data), paths, LWJSON_PROJ_MAX_PATHS,
+                                          found)
+                     == lwjsonPARSEPARTIAL
+                 && found[0] == lwjson_find(&lwjson_proj, "id") && found[0] != NULL
+                 && found[LWJSON_PROJ_MAX_PATHS - 1] == lwjson_find(&lwjson_proj, "matrix.#1")
+                 && found[LWJSON_PROJ_MAX_PATHS - 1] != NULL);
+        RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), paths, LWJSON_PROJ_MAX_PATHS + 1)
+                 == lwjsonERRPAR);
+    }
+
+    /* Invalid parameters */
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), NULL, 1) == lwjsonERRPAR);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), (const char*[]){"id"}, 0)
+             == lwjsonERRPAR);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data), (const char*[]){NULL}, 1)
+             == lwjsonERRPAR);
+    RUN_TEST(lwjson_parse_projected(&lwjson_proj, json_data, strlen(json_data),
+                                    (const char*[]){"a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q"}, 1)
+             == lwjsonERRPAR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson_all);
+    lwjson_free(&lwjson_proj);
+
+    /* Print results */
+    printf("Projected parsing test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
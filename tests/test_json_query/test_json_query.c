@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance */
+static lwjson_token_t tokens[128];
+static lwjson_t lwjson;
+
+/* JSON data used for all tests */
+static const char json_data[] = "\
+{\n\
+    \"items\": [\n\
+        {\"type\": \"x\", \"price\": 10, \"qty\": 1},\n\
+        {\"type\": \"y\", \"price\": 2.5, \"qty\": 4},\n\
+        {\"type\": \"x\", \"price\": 7, \"sold\": true},\n\
+        {\"type\": 1, \"price\": -3},\n\
+        {\"type\": \"x\", \"price\": null},\n\
+        [1, 2]\n\
+    ],\n\
+    \"stores\": {\n\
+        \"north\": {\"open\": true, \"items\": [{\"price\": 1}, {\"price\": 2}]},\n\
+        \"south\": {\"open\": false, \"items\": [{\"price\": 3}]},\n\
+        \"west\": 5\n\
+    },\n\
+    \"ints\": [0, 1, 2, 3, 4, 5, 6, 7]\n\
+}";
+
+/**
+ * \brief           Run query and collect numeric values of all matches
+ * \param[in]       str: Query string
+ * \param[in]       token: Root token to start search at or `NULL`
+ * \param[out]      vals: Output array for values. Non-numeric tokens are stored as `-100`
+ * \param[in]       vals_len: Length of output array
+ * \return          Number of matches, `-1` if query is invalid
+ */
+static int
+prv_query(const char* str, const lwjson_token_t* token, double* vals, size_t vals_len) {
+    lwjson_query_t query;
+    const lwjson_token_t* t;
+    int cnt = 0;
+
+    if (lwjson_query_begin(&query, &lwjson, token, str) != lwjsonOK) {
+        return -1;
+    }
+    while ((t = lwjson_query_next(&query)) != NULL) {
+        if ((size_t)cnt < vals_len) {
+            vals[cnt] = t->type == LWJSON_TYPE_NUM_INT    ? (double)lwjson_get_val_int(t)
+                        : t->type == LWJSON_TYPE_NUM_REAL ? (double)lwjson_get_val_real(t)
+                                                          : -100;
+        }
+        ++cnt;
+    }
+    return lwjson_query_next(&query) == NULL ? cnt : -2;
+}
+
+/**
+ * \brief           Check values of query matches
+ * \param[in]       str: Query string
+ * \param[in]       exp: Expected values
+ * \param[in]       exp_len: Number of expected values
+ * \return          `1` if query returns expected values, `0` otherwise
+ */
+static int
+prv_check(const char* str, const double* exp, size_t exp_len) {
+    double vals[16];
+    int cnt = prv_query(str, NULL, vals, LWJSON_ARRAYSIZE(vals));
+
+    if (cnt < 0 || (size_t)cnt != exp_len) {
+        printf("Query \"%s\" returned %d matches\r\n", str, cnt);
+        return 0;
+    }
+    for (size_t i = 0; i < exp_len; ++i) {
+        if (vals[i] != exp[i]) {
+            printf("Query \"%s\" returned %g at index %u\r\n", str, vals[i], (unsigned)i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#define CHECK(str, ...)                                                                                                \
+    prv_check((str), (const double[]){__VA_ARGS__}, sizeof((const double[]){__VA_ARGS__}) / sizeof(double))
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0;
+    lwjson_query_t query;
+    const lwjson_token_t* t;
+
+    printf("---\r\nTest JSON query..\r\n");
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+    RUN_TEST(lwjson_parse(&lwjson, json_data) == lwjsonOK);
+
+    /* All matches, not only the first one */
+    RUN_TEST(CHECK("items.#.price", 10, 2.5, 7, -3, -100));
+    RUN_TEST(CHECK("items.#.qty", 1, 4));
+    RUN_TEST(CHECK("stores.*.items.#.price", 1, 2, 3));
+    RUN_TEST(CHECK("*.*.open", -100, -100));
+    RUN_TEST(CHECK("stores.west", 5));
+    RUN_TEST(CHECK("items.#5.#", 1, 2));
+    RUN_TEST(prv_query("items.#.missing", NULL, NULL, 0) == 0);
+    RUN_TEST(prv_query("stores.#", NULL, NULL, 0) == 0);
+    RUN_TEST(prv_query("items.*", NULL, NULL, 0) == 0);
+    RUN_TEST(prv_query("*", NULL, NULL, 0) == 3);
+
+    /* Indexes and slices */
+    RUN_TEST(CHECK("ints.#3", 3));
+    RUN_TEST(CHECK("ints.#2:5", 2, 3, 4));
+    RUN_TEST(CHECK("ints.#6:", 6, 7));
+    RUN_TEST(CHECK("ints.#:2", 0, 1));
+    RUN_TEST(CHECK("ints.#:", 0, 1, 2, 3, 4, 5, 6, 7));
+    RUN_TEST(CHECK("items.#1:3.price", 2.5, 7));
+    RUN_TEST(prv_query("ints.#8", NULL, NULL, 0) == 0);
+    RUN_TEST(prv_query("ints.#5:5", NULL, NULL, 0) == 0);
+    RUN_TEST(prv_query("ints.#7:100", NULL, NULL, 0) == 1);
+
+    /* Predicates */
+    RUN_TEST(CHECK("items.#[type==\"x\"].price", 10, 7, -100));
+    RUN_TEST(CHECK("items.#[type != \"x\"].price", 2.5, -3));
+    RUN_TEST(CHECK("items.#[price > 5].price", 10, 7));
+    RUN_TEST(CHECK("items.#[price >= 7].price", 10, 7));
+    RUN_TEST(CHECK("items.#[price < 2.5].price", -3));
+    RUN_TEST(CHECK("items.#[price <= 2.5].price", 2.5, -3));
+    RUN_TEST(CHECK("items.#[price == 2.5].qty", 4));
+    RUN_TEST(CHECK("items.#[price != 10].price", 2.5, 7, -3, -100));
+    RUN_TEST(CHECK("items.#[price==null].type", -100));
+    RUN_TEST(CHECK("items.#[sold == true].price", 7));
+    RUN_TEST(CHECK("items.#[type == 1].price", -3));
+    RUN_TEST(CHECK("items.#1:[type==\"x\"].price", 7, -100));
+    RUN_TEST(CHECK("stores.*[open==true].items.#.price", 1, 2));
+    RUN_TEST(CHECK("stores.*[open==false].items.#[price>=3].price", 3));
+    RUN_TEST(prv_query("items.#[type==\"z\"]", NULL, NULL, 0) == 0);
+
+    /* Search from given token */
+    {
+        double vals[4];
+
+        RUN_TEST(prv_query("#[type == \"x\"].price", lwjson_find(&lwjson, "items"), vals, 4) == 3 && vals[1] == 7);
+        RUN_TEST(prv_query("#", lwjson_find(&lwjson, "ints.#2"), vals, 4) == 0);
+    }
+
+    /* Query is compatible with find for first match */
+    RUN_TEST(lwjson_query_begin(&query, &lwjson, NULL, "items.#.price") == lwjsonOK);
+    RUN_TEST(lwjson_query_next(&query) == lwjson_find(&lwjson, "items.#.price"));
+    t = lwjson_query_next(&query);
+    RUN_TEST(t != NULL && t == lwjson_find(&lwjson, "items.#1.price"));
+
+    /* Invalid queries */
+    {
+        static const char* invalid[] = {
+            "",
+            "items.",
+            ".items",
+            "items..price",
+            "items.#x",
+            "items.#1x",
+            "items.#[type]",
+            "items.#[==1]",
+            "items.#[type=1]",
+            "items.#[type==\"x\"",
+            "items.#[type==\"x]",
+            "items.#[type==x]",
+            "items.#[type<\"x\"]",
+            "items.#[sold>true]",
+            "items.#[price==1.]",
+            "items.#[price==1 2]",
+            "items.#99999999999999999999999",
+            "a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q",
+        };
+
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(invalid); ++i) {
+            RUN_TEST(prv_query(invalid[i], NULL, NULL, 0) == -1);
+        }
+        RUN_TEST(lwjson_query_begin(&query, &lwjson, NULL, "a..b") == lwjsonERRPAR);
+        RUN_TEST(lwjson_query_next(&query) == NULL);
+        RUN_TEST(lwjson_query_begin(&query, &lwjson, NULL, NULL) == lwjsonERRPAR);
+        RUN_TEST(lwjson_query_begin(&query, NULL, NULL, "items") == lwjsonERRPAR);
+        RUN_TEST(lwjson_query_begin(NULL, &lwjson, NULL, "items") == lwjsonERRPAR);
+        RUN_TEST(lwjson_query_next(NULL) == NULL);
+    }
+
+#if LWJSON_CFG_PACKED_ARRAYS
+    /* Values of packed arrays are returned in the token inside query */
+    RUN_TEST(lwjson_parse_packed(&lwjson, json_data, strlen(json_data)) == lwjsonOK);
+    RUN_TEST(lwjson_get_packed(lwjson_find(&lwjson, "ints"), NULL, NULL) != NULL);
+    RUN_TEST(CHECK("ints.#3", 3));
+    RUN_TEST(CHECK("ints.#2:5", 2, 3, 4));
+    RUN_TEST(CHECK("ints.#6:", 6, 7));
+    RUN_TEST(CHECK("items.#5.#", 1, 2));
+    RUN_TEST(CHECK("items.#.price", 10, 2.5, 7, -3, -100));
+    RUN_TEST(prv_query("ints.#8", NULL, NULL, 0) == 0);
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+    RUN_TEST(lwjson_query_begin(&query, &lwjson, NULL, "items") == lwjsonERRPAR);
+
+    /* Print results */
+    printf("Query test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
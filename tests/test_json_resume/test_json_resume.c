@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* Reference instance for one-shot parsing and instance for resumable parsing */
+static lwjson_token_t tokens_ref[128], tokens[128];
+static lwjson_t lwjson_ref, lwjson;
+
+/* Receive buffer */
+static char rx_buff[1024];
+
+/**
+ * \brief           Compare token trees recursively
+ * \param[in]       a: First tree
+ * \param[in]       b: Second tree
+ * \return          `1` if trees are identical, `0` otherwise
+ */
+static int
+prv_tree_equal(const lwjson_token_t* a, const lwjson_token_t* b) {
+    for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+        if (a->type != b->type || a->token_name_len != b->token_name_len
+            || (a->token_name_len > 0 && strncmp(a->token_name, b->token_name, a->token_name_len) != 0)) {
+            return 0;
+        }
+        switch (a->type) {
+            case LWJSON_TYPE_STRING:
+                if (a->u.str.token_value_len != b->u.str.token_value_len
+                    || strncmp(a->u.str.token_value, b->u.str.token_value, a->u.str.token_value_len) != 0) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_INT:
+                if (a->u.num_int != b->u.num_int) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_REAL:
+                if (a->u.num_real != b->u.num_real) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_ARRAY:
+            case LWJSON_TYPE_OBJECT:
+                if (!prv_tree_equal(a->u.cont.first_child, b->u.cont.first_child)) {
+                    return 0;
+                }
+                break;
+            default: break;
+        }
+    }
+    return a == NULL && b == NULL;
+}
+
+/**
+ * \brief           Parse JSON data, that is received in chunks, with resumable parser
+ * \param[in]       json: Complete JSON data
+ * \param[in]       chunk_len: Number of bytes received at once
+ * \param[in]       max_tokens: Max number of tokens to parse in single call
+ * \param[out]      calls: Output variable for number of parse calls
+ * \return          Result of the last parse call
+ */
+static lwjsonr_t
+prv_parse_chunks(const char* json, size_t chunk_len, size_t max_tokens, size_t* calls) {
+    size_t len = strlen(json), rx_len = 0;
+    lwjsonr_t res;
+
+    *calls = 0;
+    memset(rx_buff, 0xFF, sizeof(rx_buff));
+    lwjson_parse_begin(&lwjson);
+    do {
+        /* Receive next chunk, once all complete values are parsed */
+        if (rx_len < len) {
+            size_t n = len - rx_len < chunk_len ? len - rx_len : chunk_len;
+            memcpy(&rx_buff[rx_len], &json[rx_len], n);
+            rx_len += n;
+        }
+        res = lwjson_parse_resume(&lwjson, rx_buff, rx_len, max_tokens);
+        ++*calls;
+    } while (res == lwjsonPARSEINPROG && *calls < 10000);
+    return res;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, calls, mismatch = 0;
+    const lwjson_token_t* token;
+    const char* json_str = "\
+    {\
+        \"my_arr\":[\
+            {\"num\":1,\"str\":\"first, entry]\"},\
+            {\"num\":-2.5e3,\"str\":\"second \\\"}, entry\"},\
+            [\"abc\", \"def\", [], {}],\
+            [123, -123, 1.5, true, false, null]\
+        ], /* comment, with ] characters */\
+        \"my_obj\": {\
+            \"key_true\": true,\
+            \"arr\": [[1, 2, 3], [{\"my_key\":\"my_text\"}]]\
+        },\
+        \"last\": 12345678\
+    }\
+    ";
+
+    printf("---\r\nTest JSON resumable parsing..\r\n");
+    lwjson_init(&lwjson_ref, tokens_ref, LWJSON_ARRAYSIZE(tokens_ref));
+    lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+    RUN_TEST(lwjson_parse(&lwjson_ref, json_str) == lwjsonOK);
+
+    /* All data available at once */
+    RUN_TEST(prv_parse_chunks(json_str, 1024, 0, &calls) == lwjsonOK && calls == 1);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) == lwjson_get_tokens_used(&lwjson_ref));
+    RUN_TEST(prv_tree_equal(lwjson_get_first_token(&lwjson_ref), lwjson_get_first_token(&lwjson)));
+    RUN_TEST((token = lwjson_find(&lwjson, "my_obj.arr.#1.#0.my_key")) != NULL
+             && strncmp(lwjson_get_val_string(token, NULL), "my_text", 7) == 0);
+
+    /* Data received in chunks of every size, with and without token limit */
+    for (size_t chunk_len = 1; chunk_len < 64; ++chunk_len) {
+        for (size_t max_tokens = 0; max_tokens < 4; ++max_tokens) {
+            if (prv_parse_chunks(json_str, chunk_len, max_tokens, &calls) != lwjsonOK
+                || !prv_tree_equal(lwjson_get_first_token(&lwjson_ref), lwjson_get_first_token(&lwjson))
+                || lwjson_find(&lwjson, "last") == NULL) {
+                ++mismatch;
+            }
+        }
+    }
+    RUN_TEST(mismatch == 0);
+
+    /* Token limit splits parsing to several calls, root token is not counted */
+    RUN_TEST(prv_parse_chunks(json_str, 1024, 1, &calls) == lwjsonOK
+             && calls == lwjson_get_tokens_used(&lwjson_ref) - 1);
+    RUN_TEST(prv_parse_chunks(json_str, 1024, 10, &calls) == lwjsonOK && calls == 3);
+    RUN_TEST(prv_tree_equal(lwjson_get_first_token(&lwjson_ref), lwjson_get_first_token(&lwjson)));
+
+    /* Last value is parsed only after the following character */
+    lwjson_parse_begin(&lwjson);
+    RUN_TEST(lwjson_parse_resume(&lwjson, "[1, 23", 6, 0) == lwjsonPARSEINPROG);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) == 2);
+    RUN_TEST(lwjson_find(&lwjson, "#0") == NULL);
+    strcpy(rx_buff, "[1, 23");
+    lwjson_parse_begin(&lwjson);
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, strlen(rx_buff), 0) == lwjsonPARSEINPROG);
+    strcpy(rx_buff, "[1, 234]");
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, strlen(rx_buff), 0) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "#1")) != NULL && lwjson_get_val_int(token) == 234);
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, strlen(rx_buff), 0) == lwjsonOK);
+
+    /* Invalid data and parameters */
+    lwjson_parse_begin(&lwjson);
+    RUN_TEST(lwjson_parse_resume(&lwjson, "[1, 2", 5, 0) == lwjsonPARSEINPROG);
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, 5, 0) == lwjsonERRPAR);
+    strcpy(rx_buff, "[1 2, 3]");
+    lwjson_parse_begin(&lwjson);
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, strlen(rx_buff), 0) == lwjsonERRJSON);
+    strcpy(rx_buff, "{\"a\":[1,}");
+    lwjson_parse_begin(&lwjson);
+    RUN_TEST(lwjson_parse_resume(&lwjson, rx_buff, strlen(rx_buff), 0) == lwjsonERRJSON);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+    lwjson_free(&lwjson_ref);
+
+    /* Print results */
+    printf("Resumable parsing test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,257 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instances for shaped and complete parsing */
+static lwjson_token_t tokens_shaped[128], tokens_full[128];
+static lwjson_t lwjson_shaped, lwjson_full;
+
+/* Template document and documents with the same structure */
+static const char json_template[] = "\
+{\n\
+    \"id\": 15,\n\
+    \"name\": \"device\",\n\
+    \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, \"tags\": [\"x\", \"y\"]},\n\
+    \"samples\": [1, 2, 3, 4, 5, 6],\n\
+    \"flags\": [true, false, true],\n\
+    \"empty\": {},\n\
+    \"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": null}]\n\
+}";
+static const char* json_same[] = {
+    "{\"id\":16,\"name\":\"dev\\\"2\",\"cfg\":{\"mode\":\"manual\",\"limits\":{\"min\":-3,\"max\":41.5},\"tags\":[\"a\","
+    "\"bb\"]},\"samples\":[7,8,9,10,11,12],\"flags\":[false,false,true],\"empty\":{},\"items\":[{\"id\":3,\"ok\":false},"
+    "{\"id\":4,\"ok\":1}]}",
+    " { \"ID\" : null , \"other\" : 1, \"cfg\": {\"x\": 1, \"y\": {\"a\": \"\", \"b\": \"\"}, \"z\": [1.5, false]}, "
+    "\"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [1, 2, 3], \"empty\": { }, \"items\": [{\"a\": 1, \"b\": 2}, "
+    "{\"c\": 3, \"d\": 4}] } ",
+    "{\"id\": 1, \"name\": \"n\", \"cfg\": {\"mode\": 1, \"limits\": {\"min\": 1, \"max\": 2,}, \"tags\": [1, 2,],}, "
+    "\"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [true, true, true], \"empty\": {}, \"items\": [{\"id\": 1, \"ok\": 2}, "
+    "{\"id\": 2, \"ok\": 3},],}",
+};
+
+/* Documents with different structure or invalid data */
+static const char* json_other[] = {
+    "{\"id\": 15}",
+    "{\"id\": 15, \"name\": \"device\", \"cfg\": {}, \"samples\": [], \"flags\": [], \"empty\": {}, \"items\": []}",
+    "{\"id\": [15], \"name\": \"device\", \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, "
+    "\"tags\": [\"x\", \"y\"]}, \"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [true, false, true], \"empty\": {}, "
+    "\"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": null}]}",
+    "{\"id\": 15, \"name\": \"device\", \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, "
+    "\"tags\": [\"x\", \"y\"]}, \"samples\": [1, 2, 3, 4, 5, 6, 7], \"flags\": [true, false, true], \"empty\": {}, "
+    "\"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": null}]}",
+    "{\"id\": 15, \"name\": \"device\", \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, "
+    "\"tags\": [\"x\", \"y\"]}, \"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [true, false, true], \"empty\": {}, "
+    "\"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": null}], \"more\": 1}",
+    "[1, 2, 3]",
+};
+static const char* json_invalid[] = {
+    "{\"id\": 16, \"name\": \"device\", \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, "
+    "\"tags\": [\"x\", \"y\"]}, \"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [true, false, true], \"empty\": {}, "
+    "\"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": nul}]}",
+    "{\"id\": 16, \"name\": \"device\", \"cfg\": {\"mode\": \"auto\", \"limits\": {\"min\": -2.5, \"max\": 40}, "
+    "\"tags\": [\"x\", \"y\"]}, \"samples\": [1, 2, 3, 4, 5, 6], \"flags\": [true, false, true], \"empty\": {}, "
+    "\"items\": [{\"id\": 1, \"ok\": true}, {\"id\": 2, \"ok\": null}]} x",
+};
+
+/**
+ * \brief           Compare tokens and all their siblings and children
+ * \param[in]       ta: First token of the list in shaped instance
+ * \param[in]       tb: First token of the list in complete instance
+ * \return          `1` if lists are equal, `0` otherwise
+ */
+static int
+prv_equal(const lwjson_token_t* ta, const lwjson_token_t* tb) {
+    for (; ta != NULL && tb != NULL; ta = lwjson_get_next(ta), tb = lwjson_get_next(tb)) {
+        const char *sa, *sb;
+        size_t la = 0, lb = 0;
+
+        if (ta->type != tb->type) {
+            return 0;
+        }
+        sa = lwjson_get_token_name(&lwjson_shaped, ta, &la);
+        sb = lwjson_get_token_name(&lwjson_full, tb, &lb);
+        if (sa != sb || la != lb) {
+            return 0;
+        }
+        switch (ta->type) {
+            case LWJSON_TYPE_STRING:
+                sa = lwjson_get_val_string_ex(&lwjson_shaped, ta, &la);
+                sb = lwjson_get_val_string_ex(&lwjson_full, tb, &lb);
+                if (sa != sb || la != lb) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_INT:
+                if (lwjson_get_val_int(ta) != lwjson_get_val_int(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_NUM_REAL:
+                if (lwjson_get_val_real(ta) != lwjson_get_val_real(tb)) {
+                    return 0;
+                }
+                break;
+            case LWJSON_TYPE_ARRAY: {
+                lwjson_array_iter_t ia, ib;
+                const lwjson_token_t *ea, *eb;
+
+                /* Packed arrays have no children tokens */
+                lwjson_array_iter_init(&ia, ta);
+                lwjson_array_iter_init(&ib, tb);
+                do {
+                    ea = lwjson_array_iter_next(&ia);
+                    eb = lwjson_array_iter_next(&ib);
+                    if ((ea == NULL) != (eb == NULL) || (ea != NULL && ea->type != eb->type)) {
+                        return 0;
+                    }
+                    if (ea != NULL && (ea->type == LWJSON_TYPE_ARRAY || ea->type == LWJSON_TYPE_OBJECT)
+                        && !prv_equal(lwjson_get_first_child(ea), lwjson_get_first_child(eb))) {
+                        return 0;
+                    }
+                } while (ea != NULL);
+                break;
+            }
+            case LWJSON_TYPE_OBJECT:
+                if (!prv_equal(lwjson_get_first_child(ta), lwjson_get_first_child(tb))) {
+                    return 0;
+                }
+                break;
+            default: break;
+        }
+    }
+    return ta == NULL && tb == NULL;
+}
+
+/**
+ * \brief           Parse data with shaped and complete parsing and compare the results
+ * \param[in]       data: JSON data to parse
+ * \param[in]       parse_fn: Function for complete parsing
+ * \return          `1` if both parsed successfully to the same tokens, `0` otherwise
+ */
+static int
+prv_parse_both_fn(const char* data, lwjsonr_t (*parse_fn)(lwjson_t*, const void*, size_t)) {
+    return lwjson_parse_shaped(&lwjson_shaped, data, strlen(data)) == lwjsonOK
+           && parse_fn(&lwjson_full, data, strlen(data)) == lwjsonOK
+           && lwjson_get_tokens_used(&lwjson_shaped) == lwjson_get_tokens_used(&lwjson_full)
+           && lwjson_get_first_token(&lwjson_shaped)->type == lwjson_get_first_token(&lwjson_full)->type
+           && prv_equal(lwjson_get_first_child(lwjson_get_first_token(&lwjson_shaped)),
+                        lwjson_get_first_child(lwjson_get_first_token(&lwjson_full)));
+}
+
+/**
+ * \brief           Parse data with shaped and complete parsing and compare the results
+ * \param[in]       data: JSON data to parse
+ * \return          `1` if both parsed successfully to the same tokens, `0` otherwise
+ */
+static int
+prv_parse_both(const char* data) {
+    return prv_parse_both_fn(data, lwjson_parse_ex);
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0;
+    const lwjson_token_t* t;
+
+    printf("---\r\nTest JSON shaped parsing..\r\n");
+    lwjson_init(&lwjson_shaped, tokens_shaped, LWJSON_ARRAYSIZE(tokens_shaped));
+    lwjson_init(&lwjson_full, tokens_full, LWJSON_ARRAYSIZE(tokens_full));
+
+    /* First document is parsed completely */
+    RUN_TEST(prv_parse_both(json_template));
+
+    /* Documents with the same structure reuse the tokens */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(json_same); ++i) {
+        RUN_TEST(prv_parse_both(json_same[i]));
+        RUN_TEST(prv_parse_both(json_template));
+    }
+    RUN_TEST(lwjson_parse_shaped(&lwjson_shaped, json_same[0], strlen(json_same[0])) == lwjsonOK);
+    t = lwjson_find(&lwjson_shaped, "cfg.limits.max");
+    RUN_TEST(t != NULL && t->type == LWJSON_TYPE_NUM_REAL && lwjson_get_val_real(t) == 41.5);
+    t = lwjson_find(&lwjson_shaped, "items.#1.ok");
+    RUN_TEST(t != NULL && t->type == LWJSON_TYPE_NUM_INT && lwjson_get_val_int(t) == 1);
+    t = lwjson_find(&lwjson_shaped, "samples.#5");
+    RUN_TEST(t != NULL && lwjson_get_val_int(t) == 12);
+
+    /* Documents with different structure are parsed completely */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(json_other); ++i) {
+        RUN_TEST(prv_parse_both(json_template));
+        RUN_TEST(prv_parse_both(json_other[i]));
+    }
+
+    /* Invalid data is reported as with complete parsing */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(json_invalid); ++i) {
+        RUN_TEST(prv_parse_both(json_template));
+        RUN_TEST(lwjson_parse_shaped(&lwjson_shaped, json_invalid[i], strlen(json_invalid[i]))
+                 == lwjson_parse_ex(&lwjson_full, json_invalid[i], strlen(json_invalid[i])));
+        RUN_TEST(lwjson_find(&lwjson_shaped, "id") == NULL);
+    }
+
+    /* Instance without parsed document after invalid data */
+    RUN_TEST(prv_parse_both(json_same[0]));
+
+    /* Keys are compared with keys of previous data, also in the same buffer, where they are overwritten */
+    {
+        char data[64];
+
+        strcpy(data, "{\"k\\\"1\": 1, \"k2\": {\"k3\": 2}}");
+        RUN_TEST(prv_parse_both(data));
+        RUN_TEST(prv_parse_both("{\"k\\\"1\": 3, \"k2\": {\"k3\": 4}}"));
+        t = lwjson_find(&lwjson_shaped, "k2.k3");
+        RUN_TEST(t != NULL && lwjson_get_val_int(t) == 4);
+        RUN_TEST(prv_parse_both(data));
+        strcpy(data, "{\"k\\\"1\": 5, \"k2\": {\"k4\": 6}}");
+        RUN_TEST(prv_parse_both(data));
+        t = lwjson_find(&lwjson_shaped, "k2.k4");
+        RUN_TEST(t != NULL && lwjson_get_val_int(t) == 6 && lwjson_find(&lwjson_shaped, "k2.k3") == NULL);
+
+        /* Keys, decoded in place, are not compared with raw keys of new data */
+        strcpy(data, "{\"a\\\"b\": 1}");
+        RUN_TEST(lwjson_parse_insitu(&lwjson_shaped, data, strlen(data)) == lwjsonOK
+                 && lwjson_find(&lwjson_shaped, "a\"b") != NULL);
+        RUN_TEST(lwjson_parse_shaped(&lwjson_shaped, "{\"a\"b\": 1}", strlen("{\"a\"b\": 1}")) == lwjsonERRJSON);
+    }
+
+#if LWJSON_CFG_PACKED_ARRAYS
+    /* Arrays are packed the same way as with complete parsing of new data */
+    RUN_TEST(lwjson_parse_packed(&lwjson_shaped, "{\"a\": [1, \"x\", 3], \"b\": [1, 2, 3]}",
+                                 strlen("{\"a\": [1, \"x\", 3], \"b\": [1, 2, 3]}"))
+             == lwjsonOK);
+    RUN_TEST(prv_parse_both_fn("{\"a\": [1, \"y\", 3], \"b\": [4, 5, 6]}", lwjson_parse_packed));
+    RUN_TEST(prv_parse_both_fn("{\"a\": [1, 2, 3], \"b\": [4, 5, 6]}", lwjson_parse_packed));
+    t = lwjson_find(&lwjson_shaped, "a");
+    RUN_TEST(t != NULL && lwjson_get_first_child(t) == NULL && lwjson_array_size(&lwjson_shaped, t) == 3);
+    RUN_TEST(prv_parse_both_fn("{\"a\": [1, 2, 3], \"b\": [true, 5, 6]}", lwjson_parse_packed));
+    t = lwjson_find(&lwjson_shaped, "b");
+    RUN_TEST(t != NULL && lwjson_get_first_child(t) != NULL && lwjson_array_size(&lwjson_shaped, t) == 3);
+
+    /* Document parsed without packing stays unpacked */
+    RUN_TEST(lwjson_parse(&lwjson_shaped, "{\"a\": [1, \"x\", 3]}") == lwjsonOK
+             && prv_parse_both("{\"a\": [1, 2, 3]}"));
+    t = lwjson_find(&lwjson_shaped, "a");
+    RUN_TEST(t != NULL && lwjson_get_first_child(t) != NULL);
+#endif /* LWJSON_CFG_PACKED_ARRAYS */
+
+    /* Invalid parameters */
+    RUN_TEST(lwjson_parse_shaped(&lwjson_shaped, NULL, 1) == lwjsonERRPAR);
+    RUN_TEST(lwjson_parse_shaped(&lwjson_shaped, json_template, 0) == lwjsonERRPAR);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson_shaped);
+    lwjson_free(&lwjson_full);
+
+    /* Print results */
+    printf("Shaped parsing test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,13 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_json_simd.c
+    ${CMAKE_CURRENT_LIST_DIR}/lwjson_scalar.c
+)
+
+# Shared JSON files to compare SIMD and scalar builds on
+target_compile_definitions(${CMAKE_PROJECT_NAME} PRIVATE LWJSON_TEST_JSON_DIR="${CMAKE_CURRENT_LIST_DIR}/../json")
+
+# Options file
+set(LWJSON_OPTS_FILE ${CMAKE_CURRENT_LIST_DIR}/lwjson_opts.h)
\ No newline at end of file
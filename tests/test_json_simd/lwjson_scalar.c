@@ -0,0 +1,42 @@
+/**
+ * \file            lwjson_scalar.c
+ * \brief           Scalar build of the library, to compare token trees with SIMD build
+ *
+ * Library is built second time in the test application with SIMD scanning disabled.
+ * Public functions are renamed with `scalar_` prefix, to not collide with SIMD build.
+ */
+#define LWJSON_CFG_SIMD 0
+
+#define lwjson_init               scalar_lwjson_init
+#define lwjson_parse_ex           scalar_lwjson_parse_ex
+#define lwjson_parse_padded       scalar_lwjson_parse_padded
+#define lwjson_parse_insitu       scalar_lwjson_parse_insitu
+#define lwjson_parse_packed       scalar_lwjson_parse_packed
+#define lwjson_parse_shaped       scalar_lwjson_parse_shaped
+#define lwjson_parse_projected    scalar_lwjson_parse_projected
+#define lwjson_parse_until_found  scalar_lwjson_parse_until_found
+#define lwjson_parse_begin        scalar_lwjson_parse_begin
+#define lwjson_parse_resume       scalar_lwjson_parse_resume
+#define lwjson_parse_many         scalar_lwjson_parse_many
+#define lwjson_parse_fragment     scalar_lwjson_parse_fragment
+#define lwjson_parse              scalar_lwjson_parse
+#define lwjson_count_tokens       scalar_lwjson_count_tokens
+#define lwjson_validate           scalar_lwjson_validate
+#define lwjson_free               scalar_lwjson_free
+#define lwjson_find               scalar_lwjson_find
+#define lwjson_find_ex            scalar_lwjson_find_ex
+#define lwjson_path_compile       scalar_lwjson_path_compile
+#define lwjson_set_index_arena    scalar_lwjson_set_index_arena
+#define lwjson_find_compiled      scalar_lwjson_find_compiled
+#define lwjson_find_many          scalar_lwjson_find_many
+#define lwjson_query_begin        scalar_lwjson_query_begin
+#define lwjson_query_next         scalar_lwjson_query_next
+#define lwjson_skip_subtree       scalar_lwjson_skip_subtree
+#define lwjson_get_packed         scalar_lwjson_get_packed
+#define lwjson_array_iter_init    scalar_lwjson_array_iter_init
+#define lwjson_array_iter_next    scalar_lwjson_array_iter_next
+#define lwjson_array_get          scalar_lwjson_array_get
+#define lwjson_array_get_ex       scalar_lwjson_array_get_ex
+#define lwjson_array_size         scalar_lwjson_array_size
+
+#include "../../lwjson/src/lwjson/lwjson.c"
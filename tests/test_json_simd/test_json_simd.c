@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[4096];
+static lwjson_t lwjson;
+
+/* Buffer for generated JSON strings */
+static char json_buff[4096];
+
+/* Scalar build of the library, see lwjson_scalar.c */
+lwjsonr_t scalar_lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len);
+lwjsonr_t scalar_lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t len);
+lwjsonr_t scalar_lwjson_free(lwjson_t* lwobj);
+
+/* Instances and tokens to compare SIMD and scalar builds */
+static lwjson_token_t simd_tokens[8192], scalar_tokens[8192];
+static lwjson_t simd_lwjson, scalar_lwjson;
+
+/* Buffer for JSON files */
+static char file_buff[65536];
+
+/**
+ * \brief           Append string to JSON buffer
+ * \param[in]       pos: Current position in the buffer
+ * \param[in]       str: String to append
+ * \return          New position in the buffer
+ */
+static size_t
+prv_append(size_t pos, const char* str) {
+    size_t len = strlen(str);
+    memcpy(&json_buff[pos], str, len);
+    json_buff[pos + len] = '\0';
+    return pos + len;
+}
+
+/**
+ * \brief           Append character several times to JSON buffer
+ * \param[in]       pos: Current position in the buffer
+ * \param[in]       c: Character to append
+ * \param[in]       count: Number of times to append the character
+ * \return          New position in the buffer
+ */
+static size_t
+prv_append_n(size_t pos, char c, size_t count) {
+    memset(&json_buff[pos], c, count);
+    json_buff[pos + count] = '\0';
+    return pos + count;
+}
+
+/**
+ * \brief           Check if two token trees, parsed by SIMD and scalar builds, are identical
+ * \param[in]       a: Token of SIMD build
+ * \param[in]       b: Token of scalar build
+ * \return          `1` if equal, `0` otherwise
+ */
+static uint8_t
+prv_tree_equal(const lwjson_token_t* a, const lwjson_token_t* b) {
+    const char *a_str, *b_str;
+    size_t a_len = 0, b_len = 0;
+
+    if (a->type != b->type || lwjson_get_subtree_size(a) != lwjson_get_subtree_size(b)) {
+        return 0;
+    }
+    a_str = lwjson_get_token_name(&simd_lwjson, a, &a_len);
+    b_str = lwjson_get_token_name(&scalar_lwjson, b, &b_len);
+    if ((a_str == NULL) != (b_str == NULL) || a_len != b_len || (a_len > 0 && memcmp(a_str, b_str, a_len) != 0)) {
+        return 0;
+    }
+    switch (a->type) {
+        case LWJSON_TYPE_STRING:
+            a_str = lwjson_get_val_string_ex(&simd_lwjson, a, &a_len);
+            b_str = lwjson_get_val_string_ex(&scalar_lwjson, b, &b_len);
+            return a_len == b_len && memcmp(a_str, b_str, a_len) == 0;
+        case LWJSON_TYPE_NUM_INT: return lwjson_get_val_int(a) == lwjson_get_val_int(b);
+        case LWJSON_TYPE_NUM_REAL: return lwjson_get_val_real(a) == lwjson_get_val_real(b);
+        case LWJSON_TYPE_OBJECT:
+        case LWJSON_TYPE_ARRAY:
+            for (a = lwjson_get_first_child(a), b = lwjson_get_first_child(b); a != NULL && b != NULL;
+                 a = lwjson_get_next(a), b = lwjson_get_next(b)) {
+                if (!prv_tree_equal(a, b)) {
+                    return 0;
+                }
+            }
+            return a == NULL && b == NULL;
+        default: return 1;
+    }
+}
+
+/**
+ * \brief           Parse data with SIMD and scalar builds and compare results
+ * \param[in]       data: JSON data
+ * \param[in]       len: Length of JSON data
+ * \return          `1` if both builds return the same result and token tree, `0` otherwise
+ */
+static uint8_t
+prv_builds_equal(const char* data, size_t len) {
+    lwjsonr_t simd_res, scalar_res;
+
+    lwjson_init(&simd_lwjson, simd_tokens, LWJSON_ARRAYSIZE(simd_tokens));
+    scalar_lwjson_init(&scalar_lwjson, scalar_tokens, LWJSON_ARRAYSIZE(scalar_tokens));
+    simd_res = lwjson_parse_ex(&simd_lwjson, data, len);
+    scalar_res = scalar_lwjson_parse_ex(&scalar_lwjson, data, len);
+    if (simd_res != scalar_res) {
+        return 0;
+    }
+    return simd_res != lwjsonOK
+           || (lwjson_get_tokens_used(&simd_lwjson) == lwjson_get_tokens_used(&scalar_lwjson)
+               && prv_tree_equal(lwjson_get_first_token(&simd_lwjson), lwjson_get_first_token(&scalar_lwjson)));
+}
+
+/**
+ * \brief           Parse JSON file with SIMD and scalar builds and compare results
+ * \param[in]       name: File name in shared JSON directory
+ * \return          `1` if both builds return the same result and token tree, `0` otherwise
+ */
+static uint8_t
+prv_file_builds_equal(const char* name) {
+    char path[256];
+    size_t len;
+    FILE* f;
+
+    snprintf(path, sizeof(path), "%s/%s", LWJSON_TEST_JSON_DIR, name);
+    if ((f = fopen(path, "rb")) == NULL) {
+        return 0;
+    }
+    len = fread(file_buff, 1, sizeof(file_buff), f);
+    fclose(f);
+    return len > 0 && len < sizeof(file_buff) && prv_builds_equal(file_buff, len);
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, pos, len;
+    const lwjson_token_t* token;
+    const char* str;
+
+    printf("---\r\nTest JSON SIMD scanning..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    /* Long blank regions between all tokens, crossing several blocks */
+    pos = prv_append(0, "{");
+    pos = prv_append_n(pos, ' ', 100);
+    pos = prv_append(pos, "\"key\"");
+    pos = prv_append_n(pos, '\t', 70);
+    pos = prv_append(pos, ":");
+    pos = prv_append_n(pos, '\n', 130);
+    pos = prv_append(pos, "[1,");
+    pos = prv_append_n(pos, '\r', 64);
+    pos = prv_append(pos, "2]");
+    pos = prv_append_n(pos, ' ', 63);
+    pos = prv_append(pos, "}");
+    pos = prv_append_n(pos, ' ', 65);
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "key.#1")) != NULL && lwjson_get_val_int(token) == 2);
+    RUN_TEST(lwjson_get_tokens_used(&lwjson) == 4);
+
+    /* Long string values with escape sequences placed around block boundaries */
+    pos = prv_append(0, "{\"long\":\"");
+    pos = prv_append_n(pos, 'a', 54);
+    pos = prv_append(pos, "\\\"");
+    pos = prv_append_n(pos, 'b', 62);
+    pos = prv_append(pos, "\\\\\\u12aB");
+    pos = prv_append_n(pos, 'c', 150);
+    pos = prv_append(pos, "\",\"next\":true}");
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "long")) != NULL && (str = lwjson_get_val_string(token, &len)) != NULL
+             && len == (54 + 2 + 62 + 8 + 150) && str[54] == '\\' && str[55] == '"' && str[len - 1] == 'c'
+             && str[len] == '"');
+    RUN_TEST((token = lwjson_find(&lwjson, "next")) != NULL && token->type == LWJSON_TYPE_TRUE);
+
+    /* Long key names */
+    pos = prv_append(0, "{\"");
+    pos = prv_append_n(pos, 'k', 200);
+    pos = prv_append(pos, "\":1}");
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonOK);
+    RUN_TEST((token = lwjson_get_first_child(lwjson_get_first_token(&lwjson))) != NULL
+             && token->token_name_len == 200);
+
+    /* Unterminated strings and strings with NULL termination inside must fail */
+    pos = prv_append(0, "{\"k\":\"");
+    pos = prv_append_n(pos, 'a', 200);
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonERRJSON);
+    pos = prv_append(pos, "\"}");
+    json_buff[100] = '\0';
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_buff, pos) == lwjsonERRJSON);
+
+    /* Invalid escape sequence after long string content */
+    pos = prv_append(0, "{\"k\":\"");
+    pos = prv_append_n(pos, 'a', 100);
+    pos = prv_append(pos, "\\a\"}");
+    RUN_TEST(lwjson_parse(&lwjson, json_buff) == lwjsonERRJSON);
+
+    /* Length limit in the middle of long blank region */
+    pos = prv_append(0, "[1]");
+    pos = prv_append_n(pos, ' ', 200);
+    pos = prv_append(pos, "x");
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_buff, pos - 1) == lwjsonOK);
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_buff, pos) == lwjsonERR);
+
+    /* Length limit in the middle of long string */
+    pos = prv_append(0, "[\"");
+    pos = prv_append_n(pos, 'a', 200);
+    pos = prv_append(pos, "\"]");
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_buff, 150) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_ex(&lwjson, json_buff, pos) == lwjsonOK);
+
+    /* Padded input, blocks are loaded past the end of JSON data */
+    memset(json_buff, 0x00, sizeof(json_buff));
+    pos = prv_append(0, "{\"k\":\"");
+    pos = prv_append_n(pos, 'a', 100);
+    pos = prv_append(pos, "\"");
+    pos = prv_append_n(pos, ' ', 100);
+    pos = prv_append(pos, "}");
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, pos) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "k")) != NULL && lwjson_get_val_string_length(token) == 100);
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, pos - 1) == lwjsonERRPAR);
+    json_buff[pos - 1] = '\0';
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, pos - 1) == lwjsonERRJSON);
+    json_buff[pos - 1] = '}';
+    pos = prv_append_n(pos, ' ', 100);
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, pos) == lwjsonOK);
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, 50) == lwjsonERRPAR);
+    json_buff[50] = '\0';
+    RUN_TEST(lwjson_parse_padded(&lwjson, json_buff, 50) == lwjsonERRJSON);
+
+    /* SIMD and scalar builds produce the same token trees for shared JSON files */
+    RUN_TEST(prv_file_builds_equal("custom.json") && lwjson_get_tokens_used(&simd_lwjson) > 10);
+    RUN_TEST(prv_file_builds_equal("custom_stream.json"));
+    RUN_TEST(prv_file_builds_equal("weather_current.json"));
+    RUN_TEST(prv_file_builds_equal("weather_onecall.json") && lwjson_get_tokens_used(&simd_lwjson) > 1000);
+
+    /* Same for generated data with long blank regions and strings around block boundaries */
+    for (size_t shift = 0; shift < 70; ++shift) {
+        pos = prv_append_n(0, ' ', shift);
+        pos = prv_append(pos, "{\"a\":\"");
+        pos = prv_append_n(pos, 'x', 60 + shift);
+        pos = prv_append(pos, "\\\"\\\\\",");
+        pos = prv_append_n(pos, '\n', 70 - shift);
+        pos = prv_append(pos, "\"b\": [1, 2.5, \"\\u0041\", true]");
+        pos = prv_append_n(pos, '\t', shift);
+        pos = prv_append(pos, "/* comment */}");
+        RUN_TEST(prv_builds_equal(json_buff, pos) && lwjson_get_tokens_used(&simd_lwjson) == 7);
+        RUN_TEST(prv_builds_equal(json_buff, pos - shift - 2));
+    }
+    lwjson_free(&simd_lwjson);
+    scalar_lwjson_free(&scalar_lwjson);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("SIMD scanning test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
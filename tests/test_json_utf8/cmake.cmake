@@ -0,0 +1,14 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_json_utf8.c
+)
+
+# UTF-8 validation kernel needs SSSE3 instructions on x86 targets
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|i.86")
+    string(APPEND CMAKE_C_FLAGS " -mssse3")
+endif()
+
+# Options file
+set(LWJSON_OPTS_FILE ${CMAKE_CURRENT_LIST_DIR}/lwjson_opts.h)
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwjson/lwjson.h"
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+        ++test_failed;                                                                                                 \
+    }
+
+/* LwJSON instance and tokens */
+static lwjson_token_t tokens[16];
+static lwjson_t lwjson;
+static lwjson_stream_parser_t stream_parser;
+
+/* Buffer for generated JSON data */
+static char json_buff[256];
+
+/**
+ * \brief           Reference UTF-8 check, one code point at a time
+ * \param[in]       s: Bytes to check
+ * \param[in]       len: Number of bytes
+ * \return          `1` if valid, `0` otherwise
+ */
+static int
+prv_utf8_ref(const uint8_t* s, size_t len) {
+    for (size_t i = 0; i < len;) {
+        uint32_t cp;
+        size_t n;
+
+        if (s[i] < 0x80) {
+            ++i;
+            continue;
+        } else if ((s[i] & 0xE0) == 0xC0) {
+            n = 1, cp = s[i] & 0x1F;
+        } else if ((s[i] & 0xF0) == 0xE0) {
+            n = 2, cp = s[i] & 0x0F;
+        } else if ((s[i] & 0xF8) == 0xF0) {
+            n = 3, cp = s[i] & 0x07;
+        } else {
+            return 0;
+        }
+        if (i + n >= len) {
+            return 0;
+        }
+        for (size_t k = 1; k <= n; ++k) {
+            if ((s[i + k] & 0xC0) != 0x80) {
+                return 0;
+            }
+            cp = (cp << 6) | (s[i + k] & 0x3F);
+        }
+        /* Overlong, surrogate and out of range code points */
+        if ((n == 1 && cp < 0x80) || (n == 2 && cp < 0x800) || (n == 3 && cp < 0x10000)
+            || (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+            return 0;
+        }
+        i += n + 1;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Parse string content as array entry, with regular and stream parser
+ * \param[in]       str: String content, without quotes
+ * \param[in]       len: Length of string content
+ * \param[out]      stream_res: Result of stream parser
+ * \return          Result of regular parser
+ */
+static lwjsonr_t
+prv_parse_str(const char* str, size_t len, lwjsonr_t* stream_res) {
+    lwjsonr_t res;
+
+    json_buff[0] = '[';
+    json_buff[1] = '"';
+    memcpy(&json_buff[2], str, len);
+    json_buff[2 + len] = '"';
+    json_buff[3 + len] = ']';
+    json_buff[4 + len] = '\0';
+
+    lwjson_stream_init(&stream_parser, NULL);
+    *stream_res = lwjsonOK;
+    for (size_t i = 0; i < len + 4; ++i) {
+        res = lwjson_stream_parse(&stream_parser, json_buff[i]);
+        if (res != lwjsonOK && res != lwjsonSTREAMINPROG && res != lwjsonSTREAMWAITFIRSTCHAR) {
+            *stream_res = res == lwjsonSTREAMDONE ? lwjsonOK : res;
+            break;
+        }
+    }
+    return lwjson_parse_ex(&lwjson, json_buff, len + 4);
+}
+
+/**
+ * \brief           Check that both parsers give expected result for string content
+ * \param[in]       str: String content, `NULL` terminated
+ * \param[in]       exp_res: Expected result
+ * \return          `1` on match, `0` otherwise
+ */
+static int
+prv_check(const char* str, lwjsonr_t exp_res) {
+    lwjsonr_t res, stream_res;
+
+    res = prv_parse_str(str, strlen(str), &stream_res);
+    return res == exp_res && stream_res == exp_res;
+}
+
+/**
+ * \brief           Run all tests entry point
+ */
+int
+test_run(void) {
+    size_t test_failed = 0, test_passed = 0, mismatch = 0;
+    const lwjson_token_t* token;
+    char str[128];
+
+    printf("---\r\nTest JSON UTF-8 validation..\r\n");
+    if (lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens)) != lwjsonOK) {
+        printf("JSON init failed\r\n");
+        return -1;
+    }
+
+    /* Valid sequences of all lengths, including limits */
+    RUN_TEST(prv_check("ascii only", lwjsonOK));
+    RUN_TEST(prv_check("\xC2\x80 \xDF\xBF \xE0\xA0\x80 \xED\x9F\xBF \xEE\x80\x80 \xEF\xBF\xBF", lwjsonOK));
+    RUN_TEST(prv_check("\xF0\x90\x80\x80 \xF4\x8F\xBF\xBF \xF3\xBF\xBF\xBF", lwjsonOK));
+    RUN_TEST(prv_check("0123456789abcde\xE2\x82\xAC" "0123456789abcd\xF0\x9F\x98\x80!", lwjsonOK));
+
+    /* Invalid sequences */
+    RUN_TEST(prv_check("\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("a\xBF", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xC0\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xC1\xBF", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xE0\x9F\xBF", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xED\xA0\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xF0\x8F\xBF\xBF", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xF4\x90\x80\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xF5\x80\x80\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xFF", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xC2", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xE2\x82", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xF0\x9F\x98", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xE2\x82 ", lwjsonERRUTF8));
+    RUN_TEST(prv_check("\xC2\\n\x80", lwjsonERRUTF8));
+    RUN_TEST(prv_check("0123456789abcdef0123456789abcd\xF0\x9F\x98", lwjsonERRUTF8));
+    RUN_TEST(prv_check("0123456789abcde\xE2\x82\xAC\xAC", lwjsonERRUTF8));
+
+    /* Keys are validated too, escape sequences are not affected */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"k\xC3\xA9y\":\"\\u00e9\"}") == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "k\xC3\xA9y")) != NULL && token->type == LWJSON_TYPE_STRING);
+    RUN_TEST(lwjson_parse(&lwjson, "{\"k\xC3y\":1}") == lwjsonERRUTF8);
+    RUN_TEST(lwjson_count_tokens("[\"\xE0\x80\x80\"]", 7, NULL, NULL) == lwjsonERRUTF8);
+
+    /* Random strings from valid sequences and random bytes, compared against reference */
+    srand(1);
+    for (size_t i = 0; i < 20000; ++i) {
+        size_t len = 0, max_len = (size_t)(rand() % 100);
+        lwjsonr_t res, stream_res, exp_res;
+
+        while (len < max_len) {
+            int r = rand() % 16;
+            if (r < 8) {
+                str[len++] = (char)('a' + rand() % 26);
+            } else if (r < 10) {
+                str[len++] = (char)0xC3;
+                str[len++] = (char)0xA9;
+            } else if (r < 12) {
+                str[len++] = (char)0xE2;
+                str[len++] = (char)0x82;
+                str[len++] = (char)0xAC;
+            } else if (r < 13) {
+                str[len++] = (char)0xF0;
+                str[len++] = (char)0x9F;
+                str[len++] = (char)0x98;
+                str[len++] = (char)0x80;
+            } else if ((rand() % 32) == 0) {
+                /* Any byte, except the ones with special meaning in JSON string */
+                do {
+                    str[len] = (char)(rand() % 256);
+                } while (str[len] == '"' || str[len] == '\\' || str[len] == '\0');
+                ++len;
+            }
+        }
+        exp_res = prv_utf8_ref((const uint8_t*)str, len) ? lwjsonOK : lwjsonERRUTF8;
+        res = prv_parse_str(str, len, &stream_res);
+        if (res != exp_res || stream_res != exp_res) {
+            ++mismatch;
+        }
+    }
+    RUN_TEST(mismatch == 0);
+
+    /* Call this once JSON usage is finished */
+    lwjson_free(&lwjson);
+
+    /* Print results */
+    printf("UTF-8 validation test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+    return test_failed > 0 ? -1 : 0;
+}
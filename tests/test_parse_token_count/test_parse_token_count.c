@@ -15,6 +15,19 @@
             ++test_failed;                                                                                             \
             printf("Test failed for JSON parse on input %s\r\n", (json_str));                                          \
         }                                                                                                              \
+        RUN_TEST_COUNT(lwjsonOK, (exp_token_count) - 1, 0, (json_str));                                                \
+    } while (0)
+
+#define RUN_TEST_COUNT(exp_res, exp_token_count, exp_depth, json_str)                                                  \
+    do {                                                                                                               \
+        size_t count = 0, depth = 0;                                                                                   \
+        if (lwjson_count_tokens((json_str), strlen(json_str), &count, &depth) == (exp_res)                            \
+            && ((exp_res) != lwjsonOK || (count == (exp_token_count) && ((exp_depth) == 0 || depth == (exp_depth))))) { \
+            ++test_passed;                                                                                             \
+        } else {                                                                                                       \
+            ++test_failed;                                                                                             \
+            printf("Test failed for JSON count tokens on input %s\r\n", (json_str));                                   \
+        }                                                                                                              \
     } while (0)
 
 /**
@@ -53,6 +66,30 @@ test_run(void) {
     RUN_TEST(6, "{\"k\":{\"k\":{\"k\":[[[]]]}}}");
     RUN_TEST(6, "{\"k\":[{\"k\":1},{\"k\":2}]}");
 
+    /* Run token count pre-pass tests */
+    RUN_TEST_COUNT(lwjsonOK, 0, 1, "{}");
+    RUN_TEST_COUNT(lwjsonOK, 0, 1, " [ ] ");
+    RUN_TEST_COUNT(lwjsonOK, 5, 3, "{\"k\":{\"k\":[1,2]},\"s\":\"[{\"}");
+    RUN_TEST_COUNT(lwjsonOK, 5, 6, "[[[[[[]]]]]]");
+    RUN_TEST_COUNT(lwjsonOK, 6, 3, "[{\"a\":[true,false,null]},-1.5e3]");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "{\"k\":1,\"k\":[1,2}");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "[[1],[2");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "{\"k\" 1}");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "[tru]");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "[1 2]");
+    RUN_TEST_COUNT(lwjsonERRJSON, 0, 0, "1");
+    RUN_TEST_COUNT(lwjsonERR, 0, 0, "[1] x");
+    RUN_TEST_COUNT(lwjsonERRPAR, 0, 0, "");
+    {
+        static char deep[2 * (LWJSON_CFG_MAX_DEPTH + 1) + 1];
+        memset(deep, '[', LWJSON_CFG_MAX_DEPTH);
+        memset(&deep[LWJSON_CFG_MAX_DEPTH], ']', LWJSON_CFG_MAX_DEPTH);
+        RUN_TEST_COUNT(lwjsonOK, LWJSON_CFG_MAX_DEPTH - 1, LWJSON_CFG_MAX_DEPTH, deep);
+        memset(deep, '[', LWJSON_CFG_MAX_DEPTH + 1);
+        memset(&deep[LWJSON_CFG_MAX_DEPTH + 1], ']', LWJSON_CFG_MAX_DEPTH + 1);
+        RUN_TEST_COUNT(lwjsonERRMEM, 0, 0, deep);
+    }
+
     /* Print results */
     printf("JSON token count test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
     return test_failed > 0 ? -1 : 0;